@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FLASH_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FLASH_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic value at the beginning of each sector of the flash log. */
+#define LOG_BACKEND_FLASH_MAGIC 0x474f4c5aU
+
+/** Version of the flash log layout. */
+#define LOG_BACKEND_FLASH_VERSION 1U
+
+/**
+ * @brief Header at the beginning of each sector of the flash log.
+ *
+ * Fields are stored in the byte order of the target.
+ */
+struct log_backend_flash_sector_hdr {
+	/** @ref LOG_BACKEND_FLASH_MAGIC. */
+	uint32_t magic;
+	/** Sequence number, incremented each time a sector is started. */
+	uint32_t seq;
+	/** @ref LOG_BACKEND_FLASH_VERSION. */
+	uint8_t version;
+	/** Records are padded to a multiple of this value. */
+	uint8_t align;
+	/** Reserved, set to 0. */
+	uint16_t reserved;
+	/** CRC-32 (IEEE) of the preceding fields. */
+	uint32_t crc;
+};
+
+/**
+ * @brief Header of one record of the flash log.
+ *
+ * Header is followed by @p len bytes of dictionary-based log data and by
+ * padding up to the alignment given in the sector header.
+ */
+struct log_backend_flash_record_hdr {
+	/** Length of the log data. */
+	uint16_t len;
+	/** Bitwise inverse of @p len. */
+	uint16_t len_inv;
+	/** CRC-32 (IEEE) of the log data. */
+	uint32_t crc;
+};
+
+/**
+ * @brief Erase the flash log.
+ *
+ * All stored records are removed and logging continues from the first
+ * sector of the partition.
+ *
+ * @retval 0 on success.
+ * @retval -errno on flash failure.
+ */
+int log_backend_flash_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FLASH_H_ */
@@ -153,6 +153,22 @@ extern "C" {
 	)								    \
 	))
 
+/** @brief Check rate limit of a log source before creating a message.
+ *
+ * @param source Dynamic data of the source.
+ * @param fmt    Format string, identifies the call site.
+ * @param level  Level of the message.
+ *
+ * @retval true if message shall be created.
+ */
+bool z_log_rate_limit_check(struct log_source_dynamic_data *source,
+			    const char *fmt, uint8_t level);
+
+/* Runtime filtering by rate, messages from user context are not limited. */
+#define Z_LOG_RATE_LIMIT_CHECK(_is_user_context, _dsource, _fmt, _level) \
+	(!IS_ENABLED(CONFIG_LOG_RATE_LIMIT) || (_is_user_context) || \
+	 z_log_rate_limit_check(_dsource, _fmt, _level))
+
 /*****************************************************************************/
 /****************** Definitions used by minimal logging *********************/
 /*****************************************************************************/
@@ -255,6 +271,10 @@ static inline char z_log_minimal_level_to_char(int level)
 	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATE_LIMIT_CHECK(is_user_context, _dsource, \
+				    GET_ARG_N(1, __VA_ARGS__), _level)) { \
+		break; \
+	} \
 	int _mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
@@ -339,6 +359,9 @@ static inline char z_log_minimal_level_to_char(int level)
 	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (!Z_LOG_RATE_LIMIT_CHECK(is_user_context, _dsource, _str, _level)) { \
+		break; \
+	} \
 	int mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
@@ -140,6 +140,22 @@ const char *log_domain_name_get(uint32_t domain_id);
  */
 int log_source_id_get(const char *name);
 
+/**
+ * @brief Set rate limit of a log source.
+ *
+ * Messages above the limit are suppressed before they are allocated and
+ * reported with the next message of the source which passes.
+ *
+ * @param domain_id	ID of the domain, only the local domain is supported.
+ * @param source_id	Source (module or instance) ID.
+ * @param rate		Messages per second. 0 removes the limit.
+ * @param burst		Number of messages which can be logged at once.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if source does not exist or burst is 0.
+ */
+int log_rate_limit_set(uint32_t domain_id, int16_t source_id, uint16_t rate, uint8_t burst);
+
 /**
  * @brief Get source filter for the provided backend.
  *
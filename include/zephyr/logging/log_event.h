@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_EVENT_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_EVENT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Structured binary logging
+ * @defgroup log_event Structured binary logging
+ * @ingroup logger
+ * @{
+ */
+
+/**
+ * @name Field types
+ *
+ * Types are encoded as Python struct format characters so that the host
+ * tools can decode a record directly from the schema.
+ * @{
+ */
+#define LOG_EVENT_TYPE_BOOL '?'
+#define LOG_EVENT_TYPE_CHAR 'c'
+#define LOG_EVENT_TYPE_I8 'b'
+#define LOG_EVENT_TYPE_U8 'B'
+#define LOG_EVENT_TYPE_I16 'h'
+#define LOG_EVENT_TYPE_U16 'H'
+#define LOG_EVENT_TYPE_I32 'i'
+#define LOG_EVENT_TYPE_U32 'I'
+#define LOG_EVENT_TYPE_I64 'q'
+#define LOG_EVENT_TYPE_U64 'Q'
+#define LOG_EVENT_TYPE_FLOAT 'f'
+#define LOG_EVENT_TYPE_DOUBLE 'd'
+/** Pointer, stored with the size of a pointer. */
+#define LOG_EVENT_TYPE_PTR 'P'
+/** String, stored as a length byte followed by the characters. */
+#define LOG_EVENT_TYPE_STR 's'
+/** @} */
+
+/** @brief Schema of an event, generated at compile time.
+ *
+ * Schemas are not used on the target. The dictionary database generator
+ * collects them so that the host tools can decode the records, which
+ * start with the address of their schema.
+ */
+struct log_event_schema {
+	/** Event name. */
+	const char *name;
+	/** Comma separated field names. */
+	const char *fields;
+	/** Field types, one LOG_EVENT_TYPE_* character per field. */
+	const char *types;
+};
+
+/** @brief Log a structured event.
+ *
+ * Event is logged at info level from the module registered or declared in
+ * the file. Fields are stored in binary form with their type derived from
+ * the value and their names are kept out of the message, in the schema
+ * which is extracted into the dictionary database. Nothing is formatted
+ * on the target.
+ *
+ * @code
+ * LOG_EVENT(temp_sample, (sensor, id), (celsius, t), (valid, ok));
+ * @endcode
+ *
+ * Supported value types are integers, bool, char, float, double, void
+ * pointers and strings. Other pointers must be cast to void *, a value of
+ * an unsupported type fails the build. Strings are truncated to
+ * @kconfig{CONFIG_LOG_EVENT_STR_MAX_LEN} characters. Only available in C.
+ * Expands to nothing when @kconfig{CONFIG_LOG_EVENT} is disabled.
+ *
+ * @param _id Event name, an identifier.
+ * @param ... Fields, each one a (name, value) pair in parentheses.
+ */
+#define LOG_EVENT(_id, ...) \
+	Z_LOG_EVENT(LOG_LEVEL_INF, __log_current_const_data, \
+		    __log_current_dynamic_data, _id, __VA_ARGS__)
+
+/**
+ * @}
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_LOG_EVENT
+
+static inline uint8_t *z_log_event_put_8(uint8_t *p, uint8_t v)
+{
+	*p = v;
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_16(uint8_t *p, uint16_t v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_32(uint8_t *p, uint32_t v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_64(uint8_t *p, uint64_t v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_long(uint8_t *p, unsigned long v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_float(uint8_t *p, float v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_double(uint8_t *p, double v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_ptr(uint8_t *p, const void *v)
+{
+	memcpy(p, &v, sizeof(v));
+
+	return p + sizeof(v);
+}
+
+static inline uint8_t *z_log_event_put_str(uint8_t *p, const char *v)
+{
+	uint8_t *len = p++;
+
+	*len = 0;
+	while ((v != NULL) && (*len < CONFIG_LOG_EVENT_STR_MAX_LEN) && (*v != '\0')) {
+		*p++ = *v++;
+		(*len)++;
+	}
+
+	return p;
+}
+
+#define Z_LOG_EVENT_NAME(_field) GET_ARG_N(1, __DEBRACKET _field)
+
+/* Trailing argument keeps the expansion valid for an event without fields. */
+#define Z_LOG_EVENT_VALUE(_field) GET_ARG_N(2, __DEBRACKET _field, 0)
+
+#define Z_LOG_EVENT_TYPE(_v) _Generic((_v), \
+	bool : LOG_EVENT_TYPE_BOOL, \
+	char : LOG_EVENT_TYPE_CHAR, \
+	signed char : LOG_EVENT_TYPE_I8, \
+	unsigned char : LOG_EVENT_TYPE_U8, \
+	short : LOG_EVENT_TYPE_I16, \
+	unsigned short : LOG_EVENT_TYPE_U16, \
+	int : LOG_EVENT_TYPE_I32, \
+	unsigned int : LOG_EVENT_TYPE_U32, \
+	long : ((sizeof(long) == 8) ? LOG_EVENT_TYPE_I64 : LOG_EVENT_TYPE_I32), \
+	unsigned long : ((sizeof(long) == 8) ? LOG_EVENT_TYPE_U64 : LOG_EVENT_TYPE_U32), \
+	long long : LOG_EVENT_TYPE_I64, \
+	unsigned long long : LOG_EVENT_TYPE_U64, \
+	float : LOG_EVENT_TYPE_FLOAT, \
+	double : LOG_EVENT_TYPE_DOUBLE, \
+	char * : LOG_EVENT_TYPE_STR, \
+	const char * : LOG_EVENT_TYPE_STR, \
+	void * : LOG_EVENT_TYPE_PTR, \
+	const void * : LOG_EVENT_TYPE_PTR, \
+	default : 0)
+
+/* Largest size of a field in the record. */
+#define Z_LOG_EVENT_SIZE(_v) _Generic((_v), \
+	char * : 1 + CONFIG_LOG_EVENT_STR_MAX_LEN, \
+	const char * : 1 + CONFIG_LOG_EVENT_STR_MAX_LEN, \
+	default : sizeof(_v))
+
+#define Z_LOG_EVENT_PUT(_p, _v) _Generic((_v), \
+	bool : z_log_event_put_8, \
+	char : z_log_event_put_8, \
+	signed char : z_log_event_put_8, \
+	unsigned char : z_log_event_put_8, \
+	short : z_log_event_put_16, \
+	unsigned short : z_log_event_put_16, \
+	int : z_log_event_put_32, \
+	unsigned int : z_log_event_put_32, \
+	long : z_log_event_put_long, \
+	unsigned long : z_log_event_put_long, \
+	long long : z_log_event_put_64, \
+	unsigned long long : z_log_event_put_64, \
+	float : z_log_event_put_float, \
+	double : z_log_event_put_double, \
+	char * : z_log_event_put_str, \
+	const char * : z_log_event_put_str, \
+	void * : z_log_event_put_ptr, \
+	const void * : z_log_event_put_ptr, \
+	default : z_log_event_put_ptr)(_p, _v)
+
+/* FOR_EACH() which also accepts an event without fields. */
+#define Z_LOG_EVENT_FOR_EACH(F, sep, ...) \
+	COND_CODE_1(IS_EMPTY(__VA_ARGS__), (), (FOR_EACH(F, sep, __VA_ARGS__)))
+
+#define Z_LOG_EVENT_FIELD_NAME(_field) STRINGIFY(Z_LOG_EVENT_NAME(_field))
+
+/* Unsupported types fall into the default branches, which only compile for
+ * pointers, report them with a clear message.
+ */
+#define Z_LOG_EVENT_FIELD_CHECK(_field) \
+	BUILD_ASSERT(Z_LOG_EVENT_TYPE(Z_LOG_EVENT_VALUE(_field)) != 0, \
+		     "Unsupported type of event field " \
+		     STRINGIFY(Z_LOG_EVENT_NAME(_field)) ", cast pointers to void *");
+
+#define Z_LOG_EVENT_FIELD_TYPE(_field) Z_LOG_EVENT_TYPE(Z_LOG_EVENT_VALUE(_field)),
+
+#define Z_LOG_EVENT_FIELD_SIZE(_field) + Z_LOG_EVENT_SIZE(Z_LOG_EVENT_VALUE(_field))
+
+#define Z_LOG_EVENT_FIELD_PUT(_field) \
+	_p = Z_LOG_EVENT_PUT(_p, Z_LOG_EVENT_VALUE(_field));
+
+/* Schema strings are placed with the log format strings so that they can be
+ * removed from the binary with CONFIG_LOG_FMT_SECTION_STRIP.
+ */
+#define Z_LOG_EVENT_STR_VAR(_name) \
+	static const char _name[] \
+	IF_ENABLED(CONFIG_LOG_FMT_SECTION, \
+		   (__in_section(_log_strings, static, _CONCAT(_name, _)) __used __noasan))
+
+#define Z_LOG_EVENT(_level, _source, _dsource, _id, ...) do { \
+	if (!Z_LOG_CONST_LEVEL_CHECK(_level) || IS_ENABLED(CONFIG_LOG_MODE_MINIMAL)) { \
+		break; \
+	} \
+	Z_LOG_EVENT_FOR_EACH(Z_LOG_EVENT_FIELD_CHECK, (), __VA_ARGS__) \
+	Z_LOG_EVENT_STR_VAR(_ev_name) = STRINGIFY(_id); \
+	Z_LOG_EVENT_STR_VAR(_ev_fields) = \
+		"" Z_LOG_EVENT_FOR_EACH(Z_LOG_EVENT_FIELD_NAME, (","), __VA_ARGS__); \
+	Z_LOG_EVENT_STR_VAR(_ev_types) = { \
+		Z_LOG_EVENT_FOR_EACH(Z_LOG_EVENT_FIELD_TYPE, (), __VA_ARGS__) '\0' \
+	}; \
+	static const STRUCT_SECTION_ITERABLE(log_event_schema, _ev_schema) = { \
+		.name = _ev_name, \
+		.fields = _ev_fields, \
+		.types = _ev_types, \
+	}; \
+	bool is_user_context = k_is_user_context(); \
+	if (!IS_ENABLED(CONFIG_LOG_FRONTEND) && IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) && \
+	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
+		break; \
+	} \
+	if (!Z_LOG_RATE_LIMIT_CHECK(is_user_context, _dsource, _ev_name, _level)) { \
+		break; \
+	} \
+	uint8_t _ev_buf[sizeof(void *) \
+			Z_LOG_EVENT_FOR_EACH(Z_LOG_EVENT_FIELD_SIZE, (), __VA_ARGS__)]; \
+	uint8_t *_p = z_log_event_put_ptr(_ev_buf, &_ev_schema); \
+	Z_LOG_EVENT_FOR_EACH(Z_LOG_EVENT_FIELD_PUT, (), __VA_ARGS__) \
+	struct log_msg_desc _desc = Z_LOG_MSG_DESC_INITIALIZER(Z_LOG_LOCAL_DOMAIN_ID, _level, \
+							       0, _p - _ev_buf); \
+	z_log_msg_static_create(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
+				(void *)_dsource : (void *)_source, \
+				_desc, NULL, _ev_buf); \
+} while (false)
+
+#else
+
+#define Z_LOG_EVENT(...) do { } while (false)
+
+#endif /* CONFIG_LOG_EVENT */
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_EVENT_H_ */
@@ -26,9 +26,28 @@ struct log_source_const_data {
 #endif
 };
 
+/** @brief Rate limiting state of a log source. */
+struct log_rate_limit {
+	/* Low bits of the format string address of the last message. */
+	uint32_t site;
+	/* Tick of the last message from that call site. */
+	uint32_t site_stamp;
+	/* Tick of the last token refill. */
+	uint32_t stamp;
+	/* Messages per second, 0 when not limited. */
+	uint16_t rate;
+	uint8_t burst;
+	uint8_t tokens;
+	uint16_t suppressed;
+	uint16_t repeated;
+};
+
 /** @brief Dynamic data associated with the source of log messages. */
 struct log_source_dynamic_data {
 	uint32_t filters;
+#ifdef CONFIG_LOG_RATE_LIMIT
+	struct log_rate_limit rate_limit;
+#endif
 #ifdef CONFIG_NIOS2
 	/* Workaround alert! Dummy data to ensure that structure is >8 bytes.
 	 * Nios2 uses global pointer register for structures <=8 bytes and
@@ -36,7 +55,7 @@ struct log_source_dynamic_data {
 	 */
 	uint32_t dummy[2];
 #endif
-#if defined(CONFIG_RISCV) && defined(CONFIG_64BIT)
+#if defined(CONFIG_RISCV) && defined(CONFIG_64BIT) && !defined(CONFIG_LOG_RATE_LIMIT)
 	/* Workaround: RV64 needs to ensure that structure is just 8 bytes. */
 	uint32_t dummy;
 #endif
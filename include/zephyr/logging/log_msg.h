@@ -502,16 +502,35 @@ do { \
 #if defined(CONFIG_LOG_ALWAYS_RUNTIME) || \
 	(!defined(CONFIG_LOG) && \
 		(!TOOLCHAIN_HAS_PRAGMA_DIAG || !TOOLCHAIN_HAS_C_AUTO_TYPE))
+#if defined(CONFIG_LOG_USE_ARG_DESC)
+/* Create argument descriptor (if message is provided) and message. */
+#define Z_LOG_MSG_RUNTIME_CREATE(_domain_id, _source, _level, _data, _dlen, \
+				 _flags, _fmt, ...) \
+do { \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(_, ##__VA_ARGS__), \
+		    (static const uint8_t *const _arg_desc = NULL), \
+		    (CBPRINTF_ARG_DESC_DEFINE(_arg_desc, __VA_ARGS__))); \
+	z_log_msg_runtime_desc_create(_domain_id, _source, _level, _data, \
+				      _dlen, _flags, _arg_desc, \
+				      Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__)); \
+} while (false)
+#else
+#define Z_LOG_MSG_RUNTIME_CREATE(_domain_id, _source, _level, _data, _dlen, \
+				 _flags, _fmt, ...) \
+	z_log_msg_runtime_create(_domain_id, _source, _level, _data, _dlen, \
+				 _flags, Z_LOG_FMT_RUNTIME_ARGS(_fmt, ##__VA_ARGS__))
+#endif /* CONFIG_LOG_USE_ARG_DESC */
+
 #define Z_LOG_MSG_CREATE2(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
 			  _level, _data, _dlen, ...) \
 do {\
 	Z_LOG_MSG_STR_VAR(_fmt, ##__VA_ARGS__) \
-	z_log_msg_runtime_create(_domain_id, (void *)_source, \
-				  _level, (uint8_t *)_data, _dlen,\
-				  Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt) | \
-				  (IS_ENABLED(CONFIG_LOG_USE_TAGGED_ARGUMENTS) ? \
-				   CBPRINTF_PACKAGE_ARGS_ARE_TAGGED : 0), \
-				  Z_LOG_FMT_RUNTIME_ARGS(_fmt, ##__VA_ARGS__));\
+	Z_LOG_MSG_RUNTIME_CREATE(_domain_id, (void *)_source, \
+				 _level, (uint8_t *)_data, _dlen,\
+				 Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt) | \
+				 (IS_ENABLED(CONFIG_LOG_USE_TAGGED_ARGUMENTS) ? \
+				  CBPRINTF_PACKAGE_ARGS_ARE_TAGGED : 0), \
+				 _fmt, ##__VA_ARGS__);\
 	_mode = Z_LOG_MSG_MODE_RUNTIME; \
 } while (false)
 #else /* CONFIG_LOG_ALWAYS_RUNTIME */
@@ -720,6 +739,71 @@ static inline void z_log_msg_runtime_create(uint8_t domain_id,
 	va_end(ap);
 }
 
+/** @brief Create message at runtime using argument descriptor.
+ *
+ * Function is similar to @ref z_log_msg_runtime_vcreate but types of the
+ * arguments are taken from the descriptor created at compile time (see
+ * @ref CBPRINTF_ARG_DESC_DEFINE) so format string is not parsed.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param arg_desc Argument descriptor. If null, format string is parsed.
+ *
+ * @param fmt String.
+ *
+ * @param ap Variable list of string arguments.
+ */
+void z_log_msg_runtime_desc_vcreate(uint8_t domain_id, const void *source,
+				     uint8_t level, const void *data,
+				     size_t dlen, uint32_t package_flags,
+				     const uint8_t *arg_desc, const char *fmt,
+				     va_list ap);
+
+/** @brief Create message at runtime using argument descriptor.
+ *
+ * @param domain_id Domain ID.
+ *
+ * @param source Source.
+ *
+ * @param level Log level.
+ *
+ * @param data Data.
+ *
+ * @param dlen Data length.
+ *
+ * @param package_flags Package flags.
+ *
+ * @param arg_desc Argument descriptor. If null, format string is parsed.
+ *
+ * @param fmt String.
+ *
+ * @param ... String arguments.
+ */
+static inline void z_log_msg_runtime_desc_create(uint8_t domain_id,
+						  const void *source,
+						  uint8_t level, const void *data,
+						  size_t dlen, uint32_t package_flags,
+						  const uint8_t *arg_desc,
+						  const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	z_log_msg_runtime_desc_vcreate(domain_id, source, level, data, dlen,
+				       package_flags, arg_desc, fmt, ap);
+	va_end(ap);
+}
+
 static inline bool z_log_item_is_msg(const union log_msg_generic *msg)
 {
 	return msg->generic.type == Z_LOG_MSG_LOG;
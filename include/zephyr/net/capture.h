@@ -166,6 +166,209 @@ static inline int net_capture_disable(const struct device *dev)
 #endif
 }
 
+/**
+ * @name Capture ring
+ *
+ * Captured packets, or only their first bytes, are copied into a ring
+ * buffer without blocking the network stack. The ring is drained in the
+ * background into a pcapng stream, which is handed to a user supplied
+ * write function, a file, or a file on the host when running on native_sim.
+ * @{
+ */
+
+/** Filter instruction, same layout as the classic BPF instruction so that
+ *  the output of `tcpdump -dd` can be used as is.
+ */
+struct net_capture_filter_insn {
+	uint16_t code; /**< Operation */
+	uint8_t jt;    /**< Jump offset when the condition is true */
+	uint8_t jf;    /**< Jump offset when the condition is false */
+	uint32_t k;    /**< Operand */
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Instruction classes */
+#define NET_CAPTURE_BPF_LD   0x00
+#define NET_CAPTURE_BPF_LDX  0x01
+#define NET_CAPTURE_BPF_ST   0x02
+#define NET_CAPTURE_BPF_STX  0x03
+#define NET_CAPTURE_BPF_ALU  0x04
+#define NET_CAPTURE_BPF_JMP  0x05
+#define NET_CAPTURE_BPF_RET  0x06
+#define NET_CAPTURE_BPF_MISC 0x07
+
+/* Load sizes */
+#define NET_CAPTURE_BPF_W 0x00
+#define NET_CAPTURE_BPF_H 0x08
+#define NET_CAPTURE_BPF_B 0x10
+
+/* Load modes */
+#define NET_CAPTURE_BPF_IMM 0x00
+#define NET_CAPTURE_BPF_ABS 0x20
+#define NET_CAPTURE_BPF_IND 0x40
+#define NET_CAPTURE_BPF_MEM 0x60
+#define NET_CAPTURE_BPF_LEN 0x80
+#define NET_CAPTURE_BPF_MSH 0xa0
+
+/* ALU operations */
+#define NET_CAPTURE_BPF_ADD 0x00
+#define NET_CAPTURE_BPF_SUB 0x10
+#define NET_CAPTURE_BPF_MUL 0x20
+#define NET_CAPTURE_BPF_DIV 0x30
+#define NET_CAPTURE_BPF_OR  0x40
+#define NET_CAPTURE_BPF_AND 0x50
+#define NET_CAPTURE_BPF_LSH 0x60
+#define NET_CAPTURE_BPF_RSH 0x70
+#define NET_CAPTURE_BPF_NEG 0x80
+#define NET_CAPTURE_BPF_MOD 0x90
+#define NET_CAPTURE_BPF_XOR 0xa0
+
+/* Jump conditions */
+#define NET_CAPTURE_BPF_JA   0x00
+#define NET_CAPTURE_BPF_JEQ  0x10
+#define NET_CAPTURE_BPF_JGT  0x20
+#define NET_CAPTURE_BPF_JGE  0x30
+#define NET_CAPTURE_BPF_JSET 0x40
+
+/* Operand sources */
+#define NET_CAPTURE_BPF_K 0x00
+#define NET_CAPTURE_BPF_X 0x08
+#define NET_CAPTURE_BPF_A 0x10
+
+/* Register transfers */
+#define NET_CAPTURE_BPF_TAX 0x00
+#define NET_CAPTURE_BPF_TXA 0x80
+
+/** @endcond */
+
+/** Build a filter instruction that is not a conditional jump. */
+#define NET_CAPTURE_BPF_STMT(_code, _k) \
+	{ .code = (_code), .jt = 0, .jf = 0, .k = (_k) }
+
+/** Build a conditional jump filter instruction. */
+#define NET_CAPTURE_BPF_JUMP(_code, _k, _jt, _jf) \
+	{ .code = (_code), .jt = (_jt), .jf = (_jf), .k = (_k) }
+
+/** Capture ring statistics */
+struct net_capture_ring_stats {
+	/** Packets seen on the captured interfaces */
+	uint32_t received;
+	/** Packets rejected by the filter */
+	uint32_t filtered;
+	/** Packets stored in the ring */
+	uint32_t captured;
+	/** Packets lost because the ring was full */
+	uint32_t dropped;
+	/** Packets whose data was truncated */
+	uint32_t truncated;
+	/** Packets written out of the ring */
+	uint32_t written;
+	/** Failed writes, the stream is incomplete when this is not zero */
+	uint32_t write_errors;
+};
+
+/**
+ * @typedef net_capture_ring_write_t
+ * @brief Function receiving the pcapng stream.
+ *
+ * @details Called from the system work queue while draining the ring, and
+ * from the caller of net_capture_ring_start() and net_capture_ring_stop().
+ *
+ * @param data Data to write
+ * @param len Length of the data
+ * @param user_data User data given to net_capture_ring_start()
+ *
+ * @return 0 if ok, <0 if the data could not be written
+ */
+typedef int (*net_capture_ring_write_t)(const void *data, size_t len, void *user_data);
+
+/**
+ * @brief Start capturing packets into the capture ring.
+ *
+ * @details The pcapng section header is written right away, the packets
+ * follow as the ring is drained.
+ *
+ * @param iface Network interface to capture, NULL to capture all of them.
+ * @param snaplen Maximum number of bytes stored for each packet, 0 to store
+ *        the whole packets. The filter can lower it further.
+ * @param write Function receiving the pcapng stream.
+ * @param user_data User data passed to the write function.
+ *
+ * @return 0 if ok, -EALREADY if the capture is already running,
+ *         <0 if the stream could not be written.
+ */
+int net_capture_ring_start(struct net_if *iface, size_t snaplen,
+			   net_capture_ring_write_t write, void *user_data);
+
+/**
+ * @brief Start capturing packets into a pcapng file.
+ *
+ * @details The file is written using the file system API and closed by
+ * net_capture_ring_stop().
+ *
+ * @param iface Network interface to capture, NULL to capture all of them.
+ * @param snaplen Maximum number of bytes stored for each packet, 0 to store
+ *        the whole packets.
+ * @param path Path of the file, an existing file is overwritten.
+ *
+ * @return 0 if ok, <0 if the capture could not be started.
+ */
+int net_capture_ring_start_file(struct net_if *iface, size_t snaplen, const char *path);
+
+/**
+ * @brief Start capturing packets into a pcapng file on the host.
+ *
+ * @details Only available on native_sim. The file is closed by
+ * net_capture_ring_stop().
+ *
+ * @param iface Network interface to capture, NULL to capture all of them.
+ * @param snaplen Maximum number of bytes stored for each packet, 0 to store
+ *        the whole packets.
+ * @param path Path of the file on the host, an existing file is overwritten.
+ *
+ * @return 0 if ok, <0 if the capture could not be started.
+ */
+int net_capture_ring_start_host(struct net_if *iface, size_t snaplen, const char *path);
+
+/**
+ * @brief Stop capturing packets into the capture ring.
+ *
+ * @details The packets still in the ring are written, followed by the
+ * capture statistics.
+ *
+ * @return 0 if ok, -EALREADY if the capture is not running,
+ *         <0 if the stream could not be written.
+ */
+int net_capture_ring_stop(void);
+
+/**
+ * @brief Set the capture ring filter.
+ *
+ * @details The program is run on the data of each packet, starting with the
+ * link layer header when there is one. It returns the number of bytes to
+ * store, 0 to skip the packet. The program is copied and can only be changed
+ * while the capture is stopped.
+ *
+ * @param prog Filter program, NULL to capture all the packets.
+ * @param len Number of instructions in the program.
+ *
+ * @return 0 if ok, -EBUSY if the capture is running, -EINVAL if the program
+ *         is invalid, -ENOMEM if it is too long.
+ */
+int net_capture_ring_set_filter(const struct net_capture_filter_insn *prog, size_t len);
+
+/**
+ * @brief Get the capture ring statistics.
+ *
+ * @details The statistics are reset by net_capture_ring_start().
+ *
+ * @param stats Statistics, filled by this function.
+ */
+void net_capture_ring_get_stats(struct net_capture_ring_stats *stats);
+
+/** @} */
+
 /** @cond INTERNAL_HIDDEN */
 
 /**
@@ -194,23 +397,47 @@ static inline int net_capture_send(const struct device *dev, struct net_if *ifac
 #endif
 }
 
+/** Direction of a captured network packet */
+enum net_capture_dir {
+	/** Packet received from the network */
+	NET_CAPTURE_INBOUND,
+	/** Packet being sent to the network */
+	NET_CAPTURE_OUTBOUND,
+};
+
 /**
  * @brief Check if the network packet needs to be captured or not.
- *        This is called for every network packet being sent.
+ *        This is called for every network packet being received or sent.
  *
- * @param iface Network interface the packet is being sent
- * @param pkt The network packet that is sent
+ * @param iface Network interface the packet is received from or sent to
+ * @param pkt The network packet
+ * @param dir Direction of the network packet
  */
 #if defined(CONFIG_NET_CAPTURE)
-void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt);
+void net_capture_pkt_dir(struct net_if *iface, struct net_pkt *pkt,
+			 enum net_capture_dir dir);
 #else
-static inline void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
+static inline void net_capture_pkt_dir(struct net_if *iface, struct net_pkt *pkt,
+				       enum net_capture_dir dir)
 {
 	ARG_UNUSED(iface);
 	ARG_UNUSED(pkt);
+	ARG_UNUSED(dir);
 }
 #endif
 
+/**
+ * @brief Check if the network packet needs to be captured or not.
+ *        This is called for every network packet being sent.
+ *
+ * @param iface Network interface the packet is being sent
+ * @param pkt The network packet that is sent
+ */
+static inline void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	net_capture_pkt_dir(iface, pkt, NET_CAPTURE_OUTBOUND);
+}
+
 struct net_capture_info {
 	const struct device *capture_dev;
 	struct net_if *capture_iface;
@@ -40,10 +40,15 @@ extern "C" {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct coap_path_node;
+
 struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+#if defined(CONFIG_COAP_SERVER_RESOURCE_TRIE)
+	struct coap_path_node *path_trie;
+#endif
 };
 
 struct coap_service {
@@ -258,6 +263,27 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 		       const struct sockaddr *addr, socklen_t addr_len,
 		       const struct coap_transmission_parameters *params);
 
+/**
+ * @brief Send a notification to all observers of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The notification is encoded once in @p cpkt, including the observe option and the payload.
+ * For every observer only the token and a new message ID are written to the header, the options
+ * and the payload of @p cpkt are sent as is. The token and message ID of @p cpkt are ignored.
+ * Confirmable notifications are retransmitted like messages sent with @ref coap_service_send.
+ * If no pending message is left for an observer, it gets the notification as non-confirmable
+ * instead, see @kconfig{CONFIG_COAP_SERVICE_PENDING_MESSAGES}.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt CoAP notification to send to every observer
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of notified observers in case of success or negative in case of error.
+ */
+int coap_resource_send_notification(struct coap_resource *resource,
+				    const struct coap_packet *cpkt,
+				    const struct coap_transmission_parameters *params);
+
 /**
  * @brief Parse a CoAP observe request for the provided @p resource .
  *
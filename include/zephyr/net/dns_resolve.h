@@ -455,6 +455,62 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * DNS resolver cache statistics.
+ */
+struct dns_resolve_cache_stats {
+	/** Number of queries answered with addresses from the cache */
+	uint32_t hits;
+
+	/** Number of queries answered with a cached negative answer */
+	uint32_t negative_hits;
+
+	/** Number of queries that were not found in the cache */
+	uint32_t misses;
+
+	/** Number of answers stored in the cache */
+	uint32_t inserts;
+
+	/** Number of unexpired entries dropped to make room for new ones */
+	uint32_t evictions;
+
+	/** Number of unexpired entries in the cache */
+	uint16_t entries;
+
+	/** Maximum number of entries in the cache */
+	uint16_t max_entries;
+};
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Get DNS resolver cache statistics.
+ *
+ * @param stats Statistics are stored here.
+ *
+ * @return 0 if ok, <0 if error.
+ */
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats);
+
+/**
+ * @brief Remove all entries from the DNS resolver cache.
+ *
+ * @details The cache is also flushed when the DNS servers of a resolver
+ * context are changed.
+ */
+void dns_resolve_cache_flush(void);
+#else
+static inline int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats)
+{
+	ARG_UNUSED(stats);
+
+	return -ENOTSUP;
+}
+
+static inline void dns_resolve_cache_flush(void)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
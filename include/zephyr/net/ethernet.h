@@ -182,6 +182,11 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** Multiple hardware RX queues, the driver sets the flow hash of
+	 * received packets with net_pkt_set_rx_hash().
+	 */
+	ETHERNET_HW_RX_QUEUES		= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
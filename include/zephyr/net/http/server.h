@@ -0,0 +1,193 @@
+/** @file
+ * @brief HTTP server API
+ *
+ * The server serves the services and resources defined with
+ * HTTP_SERVICE_DEFINE() and HTTP_RESOURCE_DEFINE().
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+#define ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_
+
+/**
+ * @brief HTTP server API
+ * @defgroup http_server HTTP server API
+ * @ingroup networking
+ * @{
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/net/http/method.h>
+#include <zephyr/net/http/service.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Type of a HTTP resource */
+enum http_resource_type {
+	/** Content is a constant buffer, for example a file in ROM */
+	HTTP_RESOURCE_TYPE_STATIC,
+
+	/** Content is generated by a callback */
+	HTTP_RESOURCE_TYPE_DYNAMIC,
+};
+
+/**
+ * @brief Common part of a HTTP resource detail.
+ *
+ * The detail given to HTTP_RESOURCE_DEFINE() must start with this struct.
+ */
+struct http_resource_detail {
+	/** Bitmask of the allowed methods, for example BIT(HTTP_GET) */
+	uint32_t bitmask_of_supported_http_methods;
+
+	/** Resource type */
+	enum http_resource_type type;
+
+	/** Value of the Content-Type header, can be NULL */
+	const char *content_type;
+
+	/** Value of the Content-Encoding header, for example "gzip",
+	 * can be NULL.
+	 */
+	const char *content_encoding;
+};
+
+/**
+ * @brief Static HTTP resource.
+ *
+ * The content is sent directly from @a static_data, so it can be placed
+ * in ROM. The length is sent in the Content-Length header.
+ */
+struct http_resource_detail_static {
+	/** Common resource detail */
+	struct http_resource_detail common;
+
+	/** Resource content */
+	const void *static_data;
+
+	/** Length of the resource content */
+	size_t static_data_len;
+};
+
+/** Status of the data given to a dynamic resource callback */
+enum http_data_status {
+	/** The connection was closed before the request was complete */
+	HTTP_SERVER_DATA_ABORTED = -1,
+
+	/** Part of the request body, more data will follow */
+	HTTP_SERVER_DATA_MORE = 0,
+
+	/** The request is complete and the response is requested */
+	HTTP_SERVER_DATA_FINAL = 1,
+};
+
+struct http_client_ctx;
+
+/**
+ * @typedef http_resource_dynamic_cb_t
+ * @brief Callback of a dynamic HTTP resource.
+ *
+ * The callback is called with @ref HTTP_SERVER_DATA_MORE for each part of
+ * the request body. Then it is called with @ref HTTP_SERVER_DATA_FINAL
+ * and the resource data buffer to write the response to. The callback is
+ * called again until it returns 0, and each part is sent using the
+ * chunked transfer encoding.
+ *
+ * @param client Client context, see http_server_client_method().
+ * @param status Data status.
+ * @param data Request body for @ref HTTP_SERVER_DATA_MORE, the response
+ *        buffer for @ref HTTP_SERVER_DATA_FINAL.
+ * @param len Length of the request body, or the space available in the
+ *        response buffer, which can be less than its size.
+ * @param user_data User data of the resource.
+ *
+ * @return Number of response bytes written to the buffer for
+ *         @ref HTTP_SERVER_DATA_FINAL, 0 when the response is complete
+ *         or the body was consumed, <0 to abort the request.
+ */
+typedef int (*http_resource_dynamic_cb_t)(struct http_client_ctx *client,
+					  enum http_data_status status,
+					  uint8_t *data, size_t len,
+					  void *user_data);
+
+/** Dynamic HTTP resource */
+struct http_resource_detail_dynamic {
+	/** Common resource detail */
+	struct http_resource_detail common;
+
+	/** Callback generating the response */
+	http_resource_dynamic_cb_t cb;
+
+	/** Buffer for the response data */
+	uint8_t *data_buffer;
+
+	/** Size of the response buffer */
+	size_t data_buffer_len;
+
+	/** User data passed to the callback */
+	void *user_data;
+};
+
+/**
+ * @brief Start the HTTP server.
+ *
+ * Creates a listening socket for every HTTP service and starts to serve
+ * the requests using the socket service. The services must be defined with
+ * a static resource table, see HTTP_SERVICE_DEFINE(). If the port of a
+ * service is 0, the port assigned by the stack is written back to it.
+ *
+ * @return 0 if ok, -EALREADY if the server is running, <0 if error.
+ */
+int http_server_start(void);
+
+/**
+ * @brief Stop the HTTP server.
+ *
+ * Closes the listening sockets and all client connections.
+ *
+ * @return 0 if ok, -EALREADY if the server is not running.
+ */
+int http_server_stop(void);
+
+/**
+ * @brief Get the method of the request being served.
+ *
+ * Can be called from a dynamic resource callback.
+ *
+ * @param client Client context.
+ *
+ * @return Request method.
+ */
+enum http_method http_server_client_method(const struct http_client_ctx *client);
+
+/**
+ * @brief Get the URL of the request being served.
+ *
+ * Can be called from a dynamic resource callback. The URL contains the
+ * query string, if any.
+ *
+ * @param client Client context.
+ *
+ * @return Null terminated URL.
+ */
+const char *http_server_client_url(const struct http_client_ctx *client);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_HTTP_SERVER_H_ */
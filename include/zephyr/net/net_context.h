@@ -253,6 +253,12 @@ __net_socket struct net_context {
 	net_pkt_get_pool_func_t data_pool;
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+	/** Sent packets and their data buffers kept for reuse.
+	 */
+	atomic_ptr_t pkt_cache[CONFIG_NET_CONTEXT_PKT_CACHE_SIZE];
+#endif /* CONFIG_NET_CONTEXT_PKT_CACHE */
+
 #if defined(CONFIG_NET_TCP)
 	/** TCP connection information */
 	void *tcp;
@@ -150,6 +150,12 @@ int net_send_data(struct net_pkt *pkt);
 #define NET_TC_COUNT 0
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+#if defined(CONFIG_NET_RX_STEERING)
+#define NET_TC_RX_QUEUE_COUNT CONFIG_NET_RX_STEERING_QUEUES
+#else
+#define NET_TC_RX_QUEUE_COUNT 1
+#endif
+
 /* @endcond */
 
 /**
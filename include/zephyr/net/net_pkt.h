@@ -87,6 +87,11 @@ struct net_pkt {
 
 	/** @cond ignore */
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+	/* Context whose packet cache the packet returns to when it is freed */
+	struct net_context *cache_context;
+#endif
+
 #if defined(CONFIG_NET_TCP)
 	/** Allow placing the packet into sys_slist_t */
 	sys_snode_t next;
@@ -138,6 +143,14 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_RX_STEERING)
+	/** Flow hash used to select the RX queue, 0 if not computed yet.
+	 * Drivers with hardware receive side scaling can set this from the
+	 * RX descriptor.
+	 */
+	uint32_t rx_hash;
+#endif
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
@@ -199,6 +212,12 @@ struct net_pkt {
 				  */
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
+#endif
+#if defined(CONFIG_NET_GRO)
+	uint8_t gro_chksum_ok : 1; /* TCP checksum of the received segments
+				    * was verified by GRO before they were
+				    * coalesced.
+				    */
 #endif
 	/* bitfield byte alignment boundary */
 
@@ -872,6 +891,31 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_GRO)
+static inline bool net_pkt_is_gro_chksum_ok(struct net_pkt *pkt)
+{
+	return !!(pkt->gro_chksum_ok);
+}
+
+static inline void net_pkt_set_gro_chksum_ok(struct net_pkt *pkt, bool is_ok)
+{
+	pkt->gro_chksum_ok = is_ok;
+}
+#else /* CONFIG_NET_GRO */
+static inline bool net_pkt_is_gro_chksum_ok(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_gro_chksum_ok(struct net_pkt *pkt, bool is_ok)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(is_ok);
+}
+#endif /* CONFIG_NET_GRO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -1043,6 +1087,31 @@ static inline void net_pkt_set_create_time(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_RX_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 /**
  * @deprecated Use @ref net_pkt_timestamp or @ref net_pkt_timestamp_ns instead.
  */
@@ -16,6 +16,7 @@
 
 #include <limits.h>
 #include <stdbool.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/ethernet.h>
@@ -57,10 +58,22 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+
+struct npf_program;
+
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;
 	struct k_spinlock lock;
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+	/** @cond INTERNAL_HIDDEN */
+	atomic_ptr_t program;			/* compiled rule list, or NULL */
+	struct npf_program *programs;		/* two program buffers */
+	/** @endcond */
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -74,6 +87,14 @@ extern struct npf_rule_list npf_ipv4_recv_rules;
 /** @brief rule list applied for IPv6 incoming packets */
 extern struct npf_rule_list npf_ipv6_recv_rules;
 
+/*
+ * With CONFIG_NET_PKT_FILTER_COMPILED, the rule management functions below
+ * must be called from thread context: they wait until no packet is
+ * evaluated against the replaced rules before returning. Test functions
+ * must only depend on the packet, the result of a test may be reused for
+ * other rules.
+ */
+
 /**
  * @brief Insert a rule at the front of given rule list
  *
@@ -275,6 +275,16 @@ struct net_stats_tc {
 };
 
 
+/**
+ * @brief RX flow steering queue statistics
+ */
+struct net_stats_rx_queue {
+	/** Number of packets steered to the queue */
+	net_stats_t pkts;
+	/** Number of bytes steered to the queue */
+	net_stats_t bytes;
+};
+
 /**
  * @brief Power management statistics
  */
@@ -347,6 +357,12 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_RX_STEERING)
+	/** RX queue statistics, per traffic class and queue */
+	struct net_stats_rx_queue
+		rx_queue[NET_TC_RX_STATS_COUNT][NET_TC_RX_QUEUE_COUNT];
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
@@ -27,6 +27,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/socket_select.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <stdlib.h>
@@ -82,6 +83,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only the first message may block */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -529,6 +532,148 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Send up to ``vlen`` messages with one call. The messages are sent in
+ * order, the socket is looked up and locked only once for the whole
+ * batch. On return, ``msg_len`` of each sent message contains the number
+ * of bytes sent. The call stops at the first message that cannot be sent.
+ * See Linux ``sendmmsg(2)`` for a description of the semantics.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages to send
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags passed to each send operation
+ *
+ * @return Number of messages sent, or -1 and errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct fs_file_t;
+
+/**
+ * @brief Send data from a file over a connected stream socket
+ *
+ * @details
+ * Read up to @a count bytes from @a file and queue them for transmission
+ * on @a sock. The file data is read directly into the network TX buffers,
+ * so no intermediate application buffer is needed. The amount of data
+ * queued at a time is limited by the free space in the TCP send window,
+ * and a blocking socket waits for the window to open until all data is
+ * sent, end of file is reached or the send timeout expires.
+ *
+ * If @a offset is not NULL, reading starts at @a *offset, which is then
+ * updated to point past the last byte sent, and the file position is not
+ * changed. Otherwise reading starts at the current file position, which
+ * is advanced by the number of bytes sent.
+ *
+ * Only native (not offloaded, not TLS) TCP sockets are supported. This
+ * function is not a system call, so it can only be used from supervisor
+ * threads. It is available when CONFIG_FILE_SYSTEM is enabled.
+ *
+ * @param sock Connected stream socket descriptor
+ * @param file Open file to read from
+ * @param offset File offset to start reading from, can be NULL
+ * @param count Maximum number of bytes to send
+ *
+ * @return Number of bytes sent, 0 at end of file, or -1 with errno set
+ *         on error.
+ */
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * Receive up to ``vlen`` messages with one call. The socket is looked up
+ * and locked only once for the whole batch, so draining a busy datagram
+ * socket costs one call instead of one call per datagram. On return,
+ * ``msg_len`` of each received message contains the number of bytes
+ * received. If :c:macro:`ZSOCK_MSG_WAITFORONE` is set, only the first
+ * message may block and the call returns as soon as the socket receive
+ * queue is empty. See Linux ``recvmmsg(2)`` for a description of the
+ * semantics, the timeout argument of the Linux variant is not supported,
+ * use ``SO_RCVTIMEO`` instead.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of message headers to fill
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags passed to each receive operation
+ *
+ * @return Number of messages received, or -1 and errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+
+/**
+ * @brief Received data that is still owned by the network stack
+ *
+ * Filled by zsock_recv_zc(). The data is located in the network buffer
+ * fragment chain @a frags and stays valid until zsock_recv_zc_release()
+ * is called.
+ */
+struct zsock_zc_buf {
+	/** Chain of network buffer fragments holding the received data */
+	struct net_buf *frags;
+	/** Total length of the data in the fragment chain */
+	size_t len;
+	/** @cond INTERNAL_HIDDEN */
+	void *pkt;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive data without copying it to an application buffer
+ *
+ * @details
+ * Dequeue the next received network packet from the socket and hand its
+ * data over to the caller as a chain of network buffer fragments. The
+ * protocol headers are stripped, so the first fragment starts at the
+ * first byte of payload. For datagram sockets one call returns one
+ * datagram, for stream sockets one call returns the data of one received
+ * segment. The caller can parse the data in place and must give the
+ * buffers back to the network stack with zsock_recv_zc_release().
+ *
+ * Only native (not offloaded, not TLS) stream and datagram sockets are
+ * supported. This function is not a system call, so it can only be used
+ * from supervisor threads. Holding on to the received buffers for long
+ * will starve the network RX buffer pool.
+ *
+ * @param sock Socket descriptor
+ * @param zc Zero-copy buffer handle to fill
+ * @param flags Receive flags, ZSOCK_MSG_PEEK is not supported
+ * @param src_addr Source address of a datagram, can be NULL
+ * @param addrlen Length of @a src_addr (value-result), can be NULL
+ *
+ * @return Number of bytes received, 0 on end of stream, or -1 with
+ *         errno set on error.
+ */
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give buffers received by zsock_recv_zc() back to the network stack
+ *
+ * @param zc Zero-copy buffer handle filled by zsock_recv_zc()
+ */
+void zsock_recv_zc_release(struct zsock_zc_buf *zc);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -950,6 +1095,20 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1056,6 +1215,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
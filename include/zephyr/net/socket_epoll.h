@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/toolchain.h>
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Events for zsock_epoll_ctl() and zsock_epoll_wait()
+ * @{
+ */
+/** Data is available for reading */
+#define ZSOCK_EPOLLIN 0x001
+/** High-priority data is available for reading */
+#define ZSOCK_EPOLLPRI 0x002
+/** Writing is possible without blocking */
+#define ZSOCK_EPOLLOUT 0x004
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x008
+/** Hang up, always reported */
+#define ZSOCK_EPOLLHUP 0x010
+/** Report the socket only once, until re-armed with ZSOCK_EPOLL_CTL_MOD */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** Edge-triggered notification */
+#define ZSOCK_EPOLLET BIT(31)
+/** @} */
+
+/**
+ * @name Operations for zsock_epoll_ctl()
+ * @{
+ */
+/** Add a socket to the interest list */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Remove a socket from the interest list */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events or user data of a socket in the interest list */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/** User data returned with an event */
+typedef union zsock_epoll_data {
+	void *ptr;     /**< Pointer */
+	int fd;        /**< File descriptor */
+	uint32_t u32;  /**< 32-bit value */
+	uint64_t u64;  /**< 64-bit value */
+} zsock_epoll_data_t;
+
+/** Event registered with zsock_epoll_ctl() or returned by zsock_epoll_wait() */
+struct zsock_epoll_event {
+	uint32_t events;          /**< Event mask */
+	zsock_epoll_data_t data;  /**< User data */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_create.2.html>`__
+ * for normative description.
+ * This function is also exposed as ``epoll_create()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * The returned descriptor keeps a persistent interest list, so sockets
+ * only need to be registered once instead of being passed to every wait
+ * call. The descriptor is released with zsock_close(). All instances
+ * together can watch up to CONFIG_NET_SOCKETS_EPOLL_MAX_FDS sockets.
+ *
+ * @param size Ignored, but must be greater than zero
+ *
+ * @return epoll descriptor, or -1 with errno set on error
+ */
+__syscall int zsock_epoll_create(int size);
+
+/**
+ * @brief Control the interest list of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for normative description.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * Any socket that supports zsock_poll() can be registered, including TLS
+ * sockets and socketpairs. Offloaded sockets are rejected with EPERM. A
+ * socket stays registered until it is removed or closed; closing it
+ * removes it from all interest lists.
+ *
+ * @param epfd epoll descriptor
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL
+ * @param fd Socket descriptor
+ * @param event Events to monitor and user data, ignored for
+ *              ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, or -1 with errno set on error
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux manual page
+ * <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for normative description.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * Level-triggered sockets are reported as long as they are ready. An
+ * edge-triggered socket is reported once when it becomes ready, and is
+ * reported again only if it is still or again ready after the application
+ * has called a socket function such as zsock_recv() or zsock_send() on
+ * it. Applications using edge-triggered mode should read or write until
+ * EAGAIN, as usual. When more sockets are ready than fit in @a events, the
+ * next call continues with the sockets that were not reported.
+ *
+ * Sockets are registered with the kernel once, when they are added, and
+ * the ones that become ready are queued to the instance. A wait only
+ * looks at the queued sockets, so its cost does not grow with the size
+ * of the interest list.
+ *
+ * @param epfd epoll descriptor
+ * @param events Array to store the ready events to
+ * @param maxevents Size of @a events, must be greater than zero
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready events, 0 on timeout, or -1 with errno set
+ *         on error
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLPRI ZSOCK_EPOLLPRI
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_data zsock_epoll_data
+#define epoll_data_t zsock_epoll_data_t
+#define epoll_event zsock_epoll_event
+
+static inline int epoll_create(int size)
+{
+	return zsock_epoll_create(size);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Remove a descriptor that is being closed from all interest lists */
+void zsock_epoll_fd_close(int fd);
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
@@ -38,6 +38,7 @@ static inline int socketpair(int family, int type, int proto, int sv[2])
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 static inline int shutdown(int sock, int how)
 {
@@ -94,6 +95,18 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			   int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int getsockopt(int sock, int level, int optname,
 			     void *optval, socklen_t *optlen)
 {
@@ -387,6 +387,29 @@ typedef int (*cbvprintf_external_formatter_func)(cbprintf_cb out, void *ctx,
 	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, \
 				  align_offset, flags, __VA_ARGS__)
 
+/** @brief Define argument descriptor of a formatted string.
+ *
+ * Descriptor is a constant array holding the type of each argument (see
+ * @ref cbprintf_package_arg_type) which is determined at compile time in the
+ * same way as it is done for @ref CBPRINTF_STATIC_PACKAGE. It is used by
+ * cbprintf_package_desc() to package the string at runtime without parsing
+ * the format string.
+ *
+ * As with static packaging, any character pointer is considered to be
+ * a string so pointers printed with %p must be cast to another type.
+ *
+ * If _Generic is not supported or in C++ the descriptor is null and format
+ * string is parsed when packaging.
+ *
+ * Requires @kconfig{CONFIG_CBPRINTF_PACKAGE_ARG_DESC}.
+ *
+ * @param _name Name of the descriptor variable.
+ *
+ * @param ... formatted string with arguments. Format string is not used.
+ */
+#define CBPRINTF_ARG_DESC_DEFINE(_name, ... /* fmt, ... */) \
+	Z_CBPRINTF_ARG_DESC_DEFINE(_name, __VA_ARGS__)
+
 /** @brief Capture state required to output formatted data later.
  *
  * Like cbprintf() but instead of processing the arguments and emitting the
@@ -474,6 +497,75 @@ int cbvprintf_package(void *packaged,
 		      const char *format,
 		      va_list ap);
 
+/** @brief Capture state required to output formatted data later.
+ *
+ * Like cbprintf_package() but argument types are taken from the argument
+ * descriptor created at compile time by @ref CBPRINTF_ARG_DESC_DEFINE instead
+ * of parsing the format string. Resulting package is the same.
+ *
+ * Requires @kconfig{CONFIG_CBPRINTF_PACKAGE_ARG_DESC}.
+ *
+ * @param packaged pointer to where the packaged data can be stored. Pass a
+ * null pointer to store nothing but still calculate the total space required.
+ *
+ * @param len this must be set to the number of bytes available at @p packaged
+ * if it is not null. If @p packaged is null then it indicates hypothetical
+ * buffer alignment offset in bytes. See cbprintf_package().
+ *
+ * @param flags option flags. See @ref CBPRINTF_PACKAGE_FLAGS.
+ *
+ * @param arg_desc argument descriptor. If null, the format string is parsed.
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ... arguments described by @p arg_desc.
+ *
+ * @retval nonegative the number of bytes successfully stored at @p packaged.
+ * This will not exceed @p len.
+ * @retval -EINVAL if @p arg_desc or @p format is not acceptable
+ * @retval -EFAULT if @p packaged alignment is not acceptable
+ * @retval -ENOSPC if @p packaged was not null and the space required to store
+ * exceed @p len.
+ */
+__printf_like(5, 6)
+int cbprintf_package_desc(void *packaged,
+			  size_t len,
+			  uint32_t flags,
+			  const uint8_t *arg_desc,
+			  const char *format,
+			  ...);
+
+/** @brief Capture state required to output formatted data later.
+ *
+ * Like cbvprintf_package() but argument types are taken from the argument
+ * descriptor. See cbprintf_package_desc().
+ *
+ * @param packaged pointer to where the packaged data can be stored.
+ *
+ * @param len number of bytes available at @p packaged or alignment offset.
+ *
+ * @param flags option flags. See @ref CBPRINTF_PACKAGE_FLAGS.
+ *
+ * @param arg_desc argument descriptor. If null, the format string is parsed.
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ap captured stack arguments described by @p arg_desc.
+ *
+ * @retval nonegative the number of bytes successfully stored at @p packaged.
+ * @retval -EINVAL if @p arg_desc or @p format is not acceptable
+ * @retval -ENOSPC if @p packaged was not null and the space required to store
+ * exceed @p len.
+ */
+int cbvprintf_package_desc(void *packaged,
+			   size_t len,
+			   uint32_t flags,
+			   const uint8_t *arg_desc,
+			   const char *format,
+			   va_list ap);
+
 /** @brief Convert a package.
  *
  * Converting may include appending strings used in the package to the package body.
@@ -894,7 +894,8 @@ do { \
 }
 #endif
 
-#ifdef CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
 #ifdef __cplusplus
 /*
  * Remove qualifiers like const, volatile. And also transform
@@ -1004,7 +1005,9 @@ do { \
 #else
 #define Z_CBPRINTF_ARG_TYPE(arg) \
 	_Generic(arg, \
+		_Bool : CBPRINTF_PACKAGE_ARG_TYPE_INT, \
 		char : CBPRINTF_PACKAGE_ARG_TYPE_CHAR, \
+		signed char : CBPRINTF_PACKAGE_ARG_TYPE_CHAR, \
 		unsigned char : CBPRINTF_PACKAGE_ARG_TYPE_UNSIGNED_CHAR, \
 		short : CBPRINTF_PACKAGE_ARG_TYPE_SHORT, \
 		unsigned short : CBPRINTF_PACKAGE_ARG_TYPE_UNSIGNED_SHORT, \
@@ -1040,6 +1043,33 @@ do { \
 		    (CBPRINTF_PACKAGE_ARG_TYPE_END), \
 		    (Z_CBPRINTF_TAGGED_ARGS_2(__VA_ARGS__)))
 
-#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+#define Z_CBPRINTF_ARG_DESC_2(...) \
+	FOR_EACH(Z_CBPRINTF_ARG_TYPE, (,), __VA_ARGS__), \
+	CBPRINTF_PACKAGE_ARG_TYPE_END
+
+#define Z_CBPRINTF_ARG_DESC(_num_args, ...) \
+	COND_CODE_0(_num_args, \
+		    (CBPRINTF_PACKAGE_ARG_TYPE_END), \
+		    (Z_CBPRINTF_ARG_DESC_2(__VA_ARGS__)))
+
+/*
+ * C++ type matching does not apply integer promotion (e.g. to enums) so in
+ * C++ and without _Generic there is no descriptor and the format string is
+ * parsed.
+ */
+#if Z_C_GENERIC && !defined(__cplusplus)
+#define Z_CBPRINTF_ARG_DESC_DEFINE(_name, ... /* fmt, ... */) \
+	static const uint8_t _name[] = { \
+		Z_CBPRINTF_ARG_DESC(NUM_VA_ARGS_LESS_1(__VA_ARGS__), \
+				    GET_ARGS_LESS_N(1, __VA_ARGS__)) \
+	}
+#else
+#define Z_CBPRINTF_ARG_DESC_DEFINE(_name, ... /* fmt, ... */) \
+	static const uint8_t *const _name = NULL
+#endif
+
+#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS ||
+	* CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+	*/
 
 #endif /* ZEPHYR_INCLUDE_SYS_CBPRINTF_INTERNAL_H_ */
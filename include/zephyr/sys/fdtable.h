@@ -74,6 +74,24 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable);
  */
 void z_free_fd(int fd);
 
+/**
+ * @brief Function called before a file descriptor is closed.
+ *
+ * @param fd File descriptor being closed
+ */
+typedef void (*z_fd_close_hook_t)(int fd);
+
+/**
+ * @brief Register a hook called by close() before the descriptor is released.
+ *
+ * Lets subsystems that track file descriptors by number (e.g. epoll)
+ * drop their references without the fd table depending on them. Only
+ * one hook is supported; a later registration replaces the earlier one.
+ *
+ * @param hook Function to call, or NULL to remove the hook
+ */
+void z_fd_close_hook_register(z_fd_close_hook_t hook);
+
 /**
  * @brief Get underlying object pointer from file descriptor.
  *
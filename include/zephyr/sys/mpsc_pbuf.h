@@ -106,6 +106,23 @@ struct mpsc_pbuf_buffer {
 	/** Lock. */
 	struct k_spinlock lock;
 
+#if defined(CONFIG_MPSC_PBUF_LOCKLESS) || defined(__DOXYGEN__)
+	/** Write position, reserved by producers with atomic operations. */
+	atomic_t wr_pos;
+
+	/** Position of the first packet which is not claimed. */
+	atomic_t claim_pos;
+
+	/** Read position, packets before it are freed and cleared. */
+	atomic_t rd_pos;
+
+	/** Pending requests to move the read position. */
+	atomic_t release_req;
+
+	/** Positions wrap at this multiple of the buffer size. */
+	uint32_t pos_range;
+#endif
+
 	/** User callback called whenever packet is dropped.
 	 *
 	 * May be NULL if unneeded.
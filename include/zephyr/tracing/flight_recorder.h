@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_TRACING_FLIGHT_RECORDER_H
+#define ZEPHYR_INCLUDE_TRACING_FLIGHT_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Tracing flight recorder APIs
+ * @defgroup subsys_tracing_flight_recorder_apis Tracing flight recorder APIs
+ * @ingroup subsys_tracing
+ * @{
+ */
+
+#if defined(CONFIG_TRACING_FLIGHT_RECORDER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Freeze the flight recorder.
+ *
+ * New events are dropped so that the recorded ones are preserved.
+ */
+void tracing_flight_recorder_freeze(void);
+
+/**
+ * @brief Resume recording after the flight recorder was frozen.
+ */
+void tracing_flight_recorder_resume(void);
+
+/**
+ * @brief Check if the flight recorder is frozen.
+ *
+ * @return true if frozen, false if recording.
+ */
+bool tracing_flight_recorder_is_frozen(void);
+
+/**
+ * @brief Send the recorded events to the tracing backend.
+ *
+ * Events of all CPUs are sent in timestamp order and removed from the
+ * recorder. The recorder is frozen during the dump and is left in its
+ * previous state afterwards.
+ *
+ * @return Number of bytes sent to the backend.
+ */
+uint32_t tracing_flight_recorder_dump(void);
+
+#else
+
+static inline void tracing_flight_recorder_freeze(void)
+{
+}
+
+static inline void tracing_flight_recorder_resume(void)
+{
+}
+
+static inline bool tracing_flight_recorder_is_frozen(void)
+{
+	return false;
+}
+
+static inline uint32_t tracing_flight_recorder_dump(void)
+{
+	return 0;
+}
+
+#endif /* CONFIG_TRACING_FLIGHT_RECORDER */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_TRACING_FLIGHT_RECORDER_H */
@@ -14,6 +14,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/fatal.h>
 #include <zephyr/debug/coredump.h>
+#include <zephyr/tracing/flight_recorder.h>
 
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
@@ -115,6 +116,11 @@ void z_fatal_error(unsigned int reason, const z_arch_esf_t *esf)
 
 	coredump(reason, esf, thread);
 
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER_DUMP_ON_FAULT)) {
+		tracing_flight_recorder_freeze();
+		(void)tracing_flight_recorder_dump();
+	}
+
 	k_sys_fatal_error_handler(reason, esf);
 
 	/* If the system fatal error handler returns, then kill the faulting
@@ -17,6 +17,7 @@
 #include <zephyr/toolchain.h>
 #include <sys/types.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/cbprintf.h>
 
 /* newlib doesn't declare this function unless __POSIX_VISIBLE >= 200809.  No
@@ -665,6 +666,7 @@ static inline const char *extract_conversion(struct conversion *conv,
 	return sp;
 }
 
+#ifndef CONFIG_CBPRINTF_FAST_CONVERSION
 #ifdef CONFIG_64BIT
 
 static void _ldiv5(uint64_t *v)
@@ -739,6 +741,8 @@ static void _ldiv10(uint64_t *v)
 	_ldiv5(v);
 }
 
+#endif /* CONFIG_CBPRINTF_FAST_CONVERSION */
+
 /* Extract the next decimal character in the converted representation of a
  * fractional component.
  */
@@ -775,6 +779,127 @@ static inline size_t conversion_radix(char specifier)
 	}
 }
 
+#ifdef CONFIG_CBPRINTF_FAST_CONVERSION
+
+/* Decimal representation of 0 to 99, two characters each. */
+static const char dec_pairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/* Division by 100 of a 32-bit value as a multiplication by its reciprocal,
+ * which is much faster than a division on cores without a hardware divider
+ * and is not always done by the compiler on its own.
+ */
+static inline uint32_t div100(uint32_t v)
+{
+	return (uint32_t)(((uint64_t)v * 0x51eb851fU) >> 37);
+}
+
+/* High and low 64 bits of a 64x64 bit multiplication. */
+static inline uint64_t mul_64x64(uint64_t a, uint64_t b, uint64_t *lo)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = (unsigned __int128)a * b;
+
+	*lo = (uint64_t)r;
+	return (uint64_t)(r >> 64);
+#else
+	uint64_t a_lo = (uint32_t)a;
+	uint64_t a_hi = a >> 32;
+	uint64_t b_lo = (uint32_t)b;
+	uint64_t b_hi = b >> 32;
+	uint64_t ll = a_lo * b_lo;
+	uint64_t lh = a_lo * b_hi;
+	uint64_t hl = a_hi * b_lo;
+	uint64_t hh = a_hi * b_hi;
+	uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+
+	*lo = (mid << 32) | (uint32_t)ll;
+	return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+/* Division by 10^8 that does not pull in the 64-bit division helpers of
+ * 32-bit architectures.
+ */
+static inline uint64_t div1e8(uint64_t v)
+{
+	uint64_t lo;
+
+	return mul_64x64(v, 0xabcc77118461cefdULL, &lo) >> 26;
+}
+
+/* Write the decimal representation of value backwards from bp, two digits
+ * at a time. Buffer is always large enough to hold all the digits.
+ */
+static char *encode_dec(uint_value_type value, char *bp)
+{
+	uint32_t v;
+
+	/* Values above 32 bits are split into 8 digit groups so that the
+	 * remaining conversion is done with 32-bit arithmetic.
+	 */
+#ifdef CONFIG_CBPRINTF_FULL_INTEGRAL
+	while (value > UINT32_MAX) {
+		uint64_t q = div1e8(value);
+
+		v = (uint32_t)(value - q * 100000000U);
+		value = q;
+		for (int i = 0; i < 4; i++) {
+			uint32_t r = div100(v);
+
+			bp -= 2;
+			memcpy(bp, &dec_pairs[2U * (v - r * 100U)], 2);
+			v = r;
+		}
+	}
+#endif
+
+	v = (uint32_t)value;
+	while (v >= 100U) {
+		uint32_t r = div100(v);
+
+		bp -= 2;
+		memcpy(bp, &dec_pairs[2U * (v - r * 100U)], 2);
+		v = r;
+	}
+
+	if (v >= 10U) {
+		bp -= 2;
+		memcpy(bp, &dec_pairs[2U * v], 2);
+	} else {
+		*--bp = '0' + v;
+	}
+
+	return bp;
+}
+
+/* Write the octal or hexadecimal representation of value backwards from
+ * bp, using shifts instead of divisions.
+ */
+static char *encode_pow2(uint_value_type value, unsigned int shift, bool upcase,
+			 char *bps, char *bp)
+{
+	const char *digits = upcase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+	do {
+		*--bp = digits[value & BIT_MASK(shift)];
+		value >>= shift;
+	} while ((value != 0) && (bps < bp));
+
+	return bp;
+}
+
+#endif /* CONFIG_CBPRINTF_FAST_CONVERSION */
+
 /* Writes the given value into the buffer in the specified base.
  *
  * Precision is applied *ONLY* within the space allowed.
@@ -794,6 +919,13 @@ static char *encode_uint(uint_value_type value,
 	const unsigned int radix = conversion_radix(conv->specifier);
 	char *bp = bps + (bpe - bps);
 
+#ifdef CONFIG_CBPRINTF_FAST_CONVERSION
+	if (radix == 10) {
+		bp = encode_dec(value, bp);
+	} else {
+		bp = encode_pow2(value, (radix == 8) ? 3 : 4, upcase, bps, bp);
+	}
+#else
 	do {
 		unsigned int lsv = (unsigned int)(value % radix);
 
@@ -801,6 +933,7 @@ static char *encode_uint(uint_value_type value,
 			: upcase ? ('A' + lsv - 10) : ('a' + lsv - 10);
 		value /= radix;
 	} while ((value != 0) && (bps < bp));
+#endif /* CONFIG_CBPRINTF_FAST_CONVERSION */
 
 	/* Record required alternate forms.  This can be determined
 	 * from the radix without re-checking specifier.
@@ -843,6 +976,146 @@ static char *encode_uint(uint_value_type value,
  */
 #define BIT_63 BIT64(63)
 
+#ifdef CONFIG_CBPRINTF_FAST_CONVERSION
+
+/* Powers of ten 10^(16 * i) for i from -20 to 20, which covers the range
+ * of double precision values. Each one is m / 2^64 * 2^e with m rounded to
+ * the nearest value and normalized so that bit 63 is set.
+ */
+#define POW10_STEP 16
+#define POW10_MIN_IDX -20
+
+static const struct {
+	uint64_t m;
+	int16_t e;
+} pow10_tbl[] = {
+	{ 0xfd00b897478238d1ULL, -1063 }, { 0x8c71dcd9ba0b4926ULL, -1009 },
+	{ 0x9becce62836ac577ULL, -956 }, { 0xad1c8eab5ee43b67ULL, -903 },
+	{ 0xc0314325637a193aULL, -850 }, { 0xd5605fcdcf32e1d7ULL, -797 },
+	{ 0xece53cec4a314ebeULL, -744 }, { 0x8380dea93da4bc60ULL, -690 },
+	{ 0x91ff83775423cc06ULL, -637 }, { 0xa21727db38cb0030ULL, -584 },
+	{ 0xb3f4e093db73a093ULL, -531 }, { 0xc7caba6e7c5382c9ULL, -478 },
+	{ 0xddd0467c64bce4a1ULL, -425 }, { 0xf64335bcf065d37dULL, -372 },
+	{ 0x88b402f7fd75539bULL, -318 }, { 0x97c560ba6b0919a6ULL, -265 },
+	{ 0xa87fea27a539e9a5ULL, -212 }, { 0xbb127c53b17ec159ULL, -159 },
+	{ 0xcfb11ead453994baULL, -106 }, { 0xe69594bec44de15bULL, -53 },
+	{ 0x8000000000000000ULL, 1 }, { 0x8e1bc9bf04000000ULL, 54 },
+	{ 0x9dc5ada82b70b59eULL, 107 }, { 0xaf298d050e4395d7ULL, 160 },
+	{ 0xc2781f49ffcfa6d5ULL, 213 }, { 0xd7e77a8f87daf7fcULL, 266 },
+	{ 0xefb3ab16c59b14a3ULL, 319 }, { 0x850fadc09923329eULL, 373 },
+	{ 0x93ba47c980e98ce0ULL, 426 }, { 0xa402b9c5a8d3a6e7ULL, 479 },
+	{ 0xb616a12b7fe617aaULL, 532 }, { 0xca28a291859bbf93ULL, 585 },
+	{ 0xe070f78d3927556bULL, 638 }, { 0xf92e0c3537826146ULL, 691 },
+	{ 0x8a5296ffe33cc930ULL, 745 }, { 0x9991a6f3d6bf1766ULL, 798 },
+	{ 0xaa7eebfb9df9de8eULL, 851 }, { 0xbd49d14aa79dbc82ULL, 904 },
+	{ 0xd226fc195c6a2f8cULL, 957 }, { 0xe950df20247c83fdULL, 1010 },
+	{ 0x81842f29f2cce376ULL, 1064 },
+};
+
+/* 0.5 in the fixed point format used for rounding, divided by 10^n and
+ * rounded to the nearest value.
+ */
+static const uint64_t round_tbl[] = {
+	576460752303423488ULL, 57646075230342349ULL, 5764607523034235ULL,
+	576460752303423ULL, 57646075230342ULL, 5764607523034ULL,
+	576460752303ULL, 57646075230ULL, 5764607523ULL,
+	576460752ULL, 57646075ULL, 5764608ULL,
+	576461ULL, 57646ULL, 5765ULL,
+	576ULL, 58ULL,
+};
+
+/* 0.1 as a normalized fraction, with an exponent of -3. */
+#define FP_TENTH 0xcccccccccccccccdULL
+
+/* Multiply the normalized fraction by 10^n, keeping the result normalized.
+ * 10^j for j below 16 and its product with the 53-bit fraction are exact,
+ * so the product is only rounded once, after the multiplication by the
+ * power of ten from the table.
+ */
+static void fp_pow10(uint64_t *fract, int *expo, int n)
+{
+	int i = n >> 4;
+	unsigned int j = n & (POW10_STEP - 1);
+	uint64_t m = pow10_tbl[i - POW10_MIN_IDX].m;
+	uint64_t hi = *fract;
+	uint64_t lo = 0U;
+	uint64_t mid, carry, unused;
+
+	if (j != 0U) {
+		uint64_t p = 1U;
+		unsigned int lz;
+
+		while (j-- > 0U) {
+			p *= 10U;
+		}
+		lz = u64_count_leading_zeros(p);
+		hi = mul_64x64(hi, p << lz, &lo);
+		*expo += 64 - lz;
+		if ((hi & BIT_63) == 0U) {
+			hi = (hi << 1) | (lo >> 63);
+			lo <<= 1;
+			(*expo)--;
+		}
+	}
+
+	/* Upper 128 bits of the 192-bit product, the bits of the low word
+	 * below them only matter for ties.
+	 */
+	carry = mul_64x64(lo, m, &unused);
+	hi = mul_64x64(hi, m, &mid);
+	mid += carry;
+	if (mid < carry) {
+		hi++;
+	}
+
+	*expo += pow10_tbl[i - POW10_MIN_IDX].e;
+	if ((hi & BIT_63) == 0U) {
+		hi = (hi << 1) | (mid >> 63);
+		mid <<= 1;
+		(*expo)--;
+	}
+
+	/* Round up unless it would overflow. */
+	if (((mid & BIT_63) != 0U) && (hi != UINT64_MAX)) {
+		hi++;
+	}
+
+	*fract = hi;
+}
+
+/* Scale the normalized value fract / 2^64 * 2^expo by a power of ten so that
+ * it lands in [0.1, 1), in a couple of wide multiplications instead of one
+ * step per decimal digit. Return the decimal exponent that was removed.
+ */
+static int fp_scale(uint64_t *fract, int *expo)
+{
+	/* ceil(expo * log10(2)), 78913 / 2^18 being close enough to log10(2)
+	 * over the range of the exponent.
+	 */
+	int k = ((*expo * 78913) >> 18) + 1;
+	uint64_t f = *fract;
+	int e = *expo;
+
+	fp_pow10(&f, &e, -k);
+
+	/* Below 0.1 the first digit would be 0 and the value would be
+	 * rounded one digit too early, scale by one less power of ten.
+	 */
+	if ((e < -3) || ((e == -3) && (f < FP_TENTH))) {
+		k--;
+		f = *fract;
+		e = *expo;
+		fp_pow10(&f, &e, -k);
+	}
+
+	*fract = f;
+	*expo = e;
+
+	return k;
+}
+
+#endif /* CONFIG_CBPRINTF_FAST_CONVERSION */
+
 /* Convert the IEEE 754-2008 double to text format.
  *
  * @param value the 64-bit floating point value.
@@ -1082,6 +1355,12 @@ static char *encode_float(double value,
 	 */
 	int decexp = 0;
 
+#ifdef CONFIG_CBPRINTF_FAST_CONVERSION
+	/* The value is already in [0.1, 1), with expo between -3 and 0. */
+	if (fract != 0U) {
+		decexp = fp_scale(&fract, &expo);
+	}
+#else
 	while (expo < -2) {
 		/*
 		 * Make room to allow a multiplication by 5 without overflow.
@@ -1115,6 +1394,7 @@ static char *encode_float(double value,
 			expo--;
 		} while (!(fract & BIT_63));
 	}
+#endif
 
 	/*
 	 * The binary fractional point is located somewhere above bit 63.
@@ -1159,14 +1439,22 @@ static char *encode_float(double value,
 	}
 
 	/* Round the value to the last digit being printed. */
+#ifdef CONFIG_CBPRINTF_FAST_CONVERSION
+	fract += round_tbl[decimals];
+#else
 	uint64_t round = BIT64(59); /* 0.5 */
 	while (decimals--) {
+		round += 5U;
 		_ldiv10(&round);
 	}
 	fract += round;
-	/* Make sure rounding didn't make fract >= 1.0 */
+#endif
+	/* If rounding made fract >= 1.0, every digit still printed is zero
+	 * after the carry, so use 0.1 rounded up: dividing by 10 could leave
+	 * fract just below 0.1 and print a leading zero.
+	 */
 	if (fract >= BIT64(60)) {
-		_ldiv10(&fract);
+		fract = BIT64(60) / 10U + 1U;
 		decexp++;
 	}
 
@@ -23,6 +23,11 @@ LOG_MODULE_REGISTER(cbprintf_package, CONFIG_CBPRINTF_PACKAGE_LOG_LEVEL);
 	"requires toolchain to support _Generic!"
 #endif
 
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) || \
+	defined(CONFIG_CBPRINTF_PACKAGE_ARG_DESC)
+#define CBPRINTF_PACKAGE_ARG_TYPES 1
+#endif
+
 /**
  * @brief Check if address is in read only section.
  *
@@ -230,8 +235,12 @@ static int append_string(cbprintf_convert_cb cb, void *ctx, const char *str, uin
 	return cb(str, strl, ctx);
 }
 
-int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
-		      const char *fmt, va_list ap)
+/*
+ * Argument types are taken from the format string or, if supported, from
+ * the tags preceding each argument or from the argument descriptor.
+ */
+static int package_process(void *packaged, size_t len, uint32_t flags,
+			   const uint8_t *arg_desc, const char *fmt, va_list ap)
 {
 /*
  * Internally, a byte is used to store location of a string argument within a
@@ -268,6 +277,11 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 	int fros_cnt = 1 + Z_CBPRINTF_PACKAGE_FIRST_RO_STR_CNT_GET(flags);
 	bool is_str_arg = false;
 	union cbprintf_package_hdr *pkg_hdr = packaged;
+#ifdef CBPRINTF_PACKAGE_ARG_TYPES
+	bool is_tagged = IS_ENABLED(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) &&
+			 ((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) ==
+			  CBPRINTF_PACKAGE_ARGS_ARE_TAGGED);
+#endif
 
 	/* Buffer must be aligned at least to size of a pointer. */
 	if ((uintptr_t)packaged % sizeof(void *)) {
@@ -342,36 +356,39 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 
 	while (true) {
 
-#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS)
-		if ((flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED)
-		    == CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) {
-			int arg_tag = va_arg(ap, int);
+#ifdef CBPRINTF_PACKAGE_ARG_TYPES
+		if (is_tagged || (arg_desc != NULL)) {
+			int arg_tag = is_tagged ? va_arg(ap, int) : *arg_desc++;
 
-			/*
-			 * Here we copy the tag over to the package.
-			 */
-			align = VA_STACK_ALIGN(int);
-			size = sizeof(int);
+			if (is_tagged) {
+				/*
+				 * Here we copy the tag over to the package.
+				 */
+				align = VA_STACK_ALIGN(int);
+				size = sizeof(int);
 
-			/* align destination buffer location */
-			buf = (void *)ROUND_UP(buf, align);
+				/* align destination buffer location */
+				buf = (void *)ROUND_UP(buf, align);
 
-			/* make sure the data fits */
-			if (buf0 != NULL && BUF_OFFSET + size > len) {
-				return -ENOSPC;
-			}
+				/* make sure the data fits */
+				if (buf0 != NULL && BUF_OFFSET + size > len) {
+					return -ENOSPC;
+				}
 
-			if (buf0 != NULL) {
-				*(int *)buf = arg_tag;
-			}
+				if (buf0 != NULL) {
+					*(int *)buf = arg_tag;
+				}
 
-			buf += sizeof(int);
+				buf += sizeof(int);
+			}
 
 			if (arg_tag == CBPRINTF_PACKAGE_ARG_TYPE_END) {
 				/* End of arguments */
 				break;
 			}
 
+			arg_idx++;
+
 			/*
 			 * There are lots of __fallthrough here since
 			 * quite a few of the data types have the same
@@ -437,14 +454,13 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 					}
 					if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
 						memcpy(buf, &v, size);
-					} else if (fmt[-1] == 'L') {
+					} else if (arg_tag == CBPRINTF_PACKAGE_ARG_TYPE_LONG_DOUBLE) {
 						*(long double *)buf = v.ld;
 					} else {
 						*(double *)buf = v.d;
 					}
 				}
 				buf += size;
-				parsing = false;
 				continue;
 			}
 
@@ -462,7 +478,7 @@ int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
 			}
 
 		} else
-#endif /* CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS */
+#endif /* CBPRINTF_PACKAGE_ARG_TYPES */
 		{
 			/* Scan the format string */
 			if (*++fmt == '\0') {
@@ -812,6 +828,12 @@ process_string:
 #undef STR_POS_MASK
 }
 
+int cbvprintf_package(void *packaged, size_t len, uint32_t flags,
+		      const char *fmt, va_list ap)
+{
+	return package_process(packaged, len, flags, NULL, fmt, ap);
+}
+
 int cbprintf_package(void *packaged, size_t len, uint32_t flags,
 		     const char *format, ...)
 {
@@ -824,6 +846,26 @@ int cbprintf_package(void *packaged, size_t len, uint32_t flags,
 	return ret;
 }
 
+#ifdef CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+int cbvprintf_package_desc(void *packaged, size_t len, uint32_t flags,
+			   const uint8_t *arg_desc, const char *format, va_list ap)
+{
+	return package_process(packaged, len, flags, arg_desc, format, ap);
+}
+
+int cbprintf_package_desc(void *packaged, size_t len, uint32_t flags,
+			  const uint8_t *arg_desc, const char *format, ...)
+{
+	va_list ap;
+	int ret;
+
+	va_start(ap, format);
+	ret = cbvprintf_package_desc(packaged, len, flags, arg_desc, format, ap);
+	va_end(ap);
+	return ret;
+}
+#endif /* CONFIG_CBPRINTF_PACKAGE_ARG_DESC */
+
 int cbpprintf_external(cbprintf_cb out,
 		       cbvprintf_external_formatter_func formatter,
 		       void *ctx, void *packaged)
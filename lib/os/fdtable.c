@@ -70,6 +70,8 @@ static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
 
 static K_MUTEX_DEFINE(fdtable_lock);
 
+static z_fd_close_hook_t close_hook;
+
 static int z_fd_ref(int fd)
 {
 	return atomic_inc(&fdtable[fd].refcount) + 1;
@@ -284,6 +286,11 @@ void z_free_fd(int fd)
 	(void)z_fd_unref(fd);
 }
 
+void z_fd_close_hook_register(z_fd_close_hook_t hook)
+{
+	close_hook = hook;
+}
+
 int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 {
 	int fd;
@@ -342,6 +349,10 @@ int close(int fd)
 		return -1;
 	}
 
+	if (close_hook != NULL) {
+		close_hook(fd);
+	}
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 
 	res = fdtable[fd].vtable->close(fdtable[fd].obj);
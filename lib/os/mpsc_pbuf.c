@@ -5,6 +5,8 @@
  */
 #include <zephyr/sys/mpsc_pbuf.h>
 
+#include "mpsc_pbuf_lockless.h"
+
 #define MPSC_PBUF_DEBUG 0
 
 #define MPSC_PBUF_DBG(buffer, ...) do { \
@@ -16,6 +18,16 @@
 	} \
 } while (0)
 
+/* Producers of a buffer which is not in overwrite mode never drop packets
+ * from the buffer, they do not need to lock interrupts when
+ * CONFIG_MPSC_PBUF_LOCKLESS is enabled.
+ */
+static inline bool is_lockless(struct mpsc_pbuf_buffer *buffer)
+{
+	return IS_ENABLED(CONFIG_MPSC_PBUF_LOCKLESS) &&
+	       !(buffer->flags & MPSC_PBUF_MODE_OVERWRITE);
+}
+
 static inline void mpsc_state_print(struct mpsc_pbuf_buffer *buffer)
 {
 	if (MPSC_PBUF_DEBUG) {
@@ -42,6 +54,10 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 		buffer->flags |= MPSC_PBUF_SIZE_POW2;
 	}
 
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_init(buffer);
+	}
+
 	err = k_sem_init(&buffer->sem, 0, 1);
 	__ASSERT_NO_MSG(err == 0);
 	ARG_UNUSED(err);
@@ -295,6 +311,11 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_put_word(buffer, item);
+		return;
+	}
+
 	do {
 		key = k_spin_lock(&buffer->lock);
 
@@ -341,6 +362,10 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+	if (is_lockless(buffer)) {
+		return z_mpsc_pbuf_lockless_alloc(buffer, wlen, timeout);
+	}
+
 	MPSC_PBUF_DBG(buffer, "alloc %d words", (int)wlen);
 
 	if (wlen > (buffer->size)) {
@@ -407,9 +432,16 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 		       union mpsc_pbuf_generic *item)
 {
-	uint32_t wlen = buffer->get_wlen(item);
+	uint32_t wlen;
+	k_spinlock_key_t key;
 
-	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_commit(buffer, item);
+		return;
+	}
+
+	wlen = buffer->get_wlen(item);
+	key = k_spin_lock(&buffer->lock);
 
 	item->hdr.valid = 1;
 	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
@@ -429,6 +461,11 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_put_word_ext(buffer, item, data);
+		return;
+	}
+
 	do {
 		k_spinlock_key_t key;
 		uint32_t free_wlen;
@@ -482,6 +519,11 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_put_data(buffer, data, wlen);
+		return;
+	}
+
 	do {
 		uint32_t free_wlen;
 		k_spinlock_key_t key;
@@ -530,6 +572,10 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 	union mpsc_pbuf_generic *item;
 	bool cont;
 
+	if (is_lockless(buffer)) {
+		return z_mpsc_pbuf_lockless_claim(buffer);
+	}
+
 	do {
 		uint32_t a;
 		k_spinlock_key_t key;
@@ -574,9 +620,17 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 		     const union mpsc_pbuf_generic *item)
 {
-	uint32_t wlen = buffer->get_wlen(item);
-	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
 	union mpsc_pbuf_generic *witem = (union mpsc_pbuf_generic *)item;
+	uint32_t wlen;
+	k_spinlock_key_t key;
+
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_free(buffer, item);
+		return;
+	}
+
+	wlen = buffer->get_wlen(item);
+	key = k_spin_lock(&buffer->lock);
 
 	witem->hdr.valid = 0;
 	if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE) ||
@@ -607,6 +661,10 @@ bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 {
 	uint32_t a;
 
+	if (is_lockless(buffer)) {
+		return z_mpsc_pbuf_lockless_is_pending(buffer);
+	}
+
 	(void)available(buffer, &a);
 
 	return a ? true : false;
@@ -615,6 +673,11 @@ bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
 			       uint32_t *size, uint32_t *now)
 {
+	if (is_lockless(buffer)) {
+		z_mpsc_pbuf_lockless_get_utilization(buffer, size, now);
+		return;
+	}
+
 	/* One byte is left for full/empty distinction. */
 	*size = (buffer->size - 1) * sizeof(int);
 	*now = get_usage(buffer) * sizeof(int);
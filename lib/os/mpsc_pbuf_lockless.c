@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Multi producer, single consumer packet buffer where producers do not lock
+ * interrupts. Only used for buffers which are not in overwrite mode, see
+ * mpsc_pbuf.c.
+ *
+ * Space is reserved by moving the write position with a compare and swap,
+ * then the packet is written and committed by setting its valid bit, which
+ * is the only thing the consumer waits for. Positions run over a multiple of
+ * the buffer size, so that a position is not reused before many laps.
+ *
+ * All the free space is kept cleared so that a reserved packet reads as not
+ * committed until its header is written. Freed packets are turned into skip
+ * packets, then cleared when the read position moves past them, so they
+ * can be freed in any order. Only one context moves the read position at a
+ * time, the others leave a request for it.
+ */
+
+#include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/sys/barrier.h>
+
+#include "mpsc_pbuf_lockless.h"
+
+static inline uint32_t pos_add(struct mpsc_pbuf_buffer *buffer, uint32_t pos, uint32_t val)
+{
+	pos += val;
+
+	return (pos >= buffer->pos_range) ? pos - buffer->pos_range : pos;
+}
+
+static inline uint32_t pos_diff(struct mpsc_pbuf_buffer *buffer, uint32_t a, uint32_t b)
+{
+	return (a >= b) ? a - b : a + buffer->pos_range - b;
+}
+
+static inline uint32_t pos_idx(struct mpsc_pbuf_buffer *buffer, uint32_t pos)
+{
+	if (buffer->flags & MPSC_PBUF_SIZE_POW2) {
+		return pos & (buffer->size - 1);
+	}
+
+	return pos % buffer->size;
+}
+
+static inline union mpsc_pbuf_generic read_hdr(struct mpsc_pbuf_buffer *buffer, uint32_t idx)
+{
+	union mpsc_pbuf_generic hdr = {
+		.raw = *(volatile uint32_t *)&buffer->buf[idx]
+	};
+
+	/* Packet content is read after its header. */
+	barrier_dmem_fence_full();
+
+	return hdr;
+}
+
+static inline void write_hdr(struct mpsc_pbuf_buffer *buffer, uint32_t idx,
+			     union mpsc_pbuf_generic hdr)
+{
+	/* Packet content is written before its header. */
+	barrier_dmem_fence_full();
+	*(volatile uint32_t *)&buffer->buf[idx] = hdr.raw;
+}
+
+static inline bool is_skip(union mpsc_pbuf_generic hdr)
+{
+	return hdr.hdr.busy && !hdr.hdr.valid;
+}
+
+static inline bool is_empty(union mpsc_pbuf_generic hdr)
+{
+	return !hdr.hdr.busy && !hdr.hdr.valid;
+}
+
+static void mark_skip(struct mpsc_pbuf_buffer *buffer, uint32_t idx, uint32_t wlen)
+{
+	union mpsc_pbuf_generic skip = {
+		.skip = { .valid = 0, .busy = 1, .len = wlen }
+	};
+
+	write_hdr(buffer, idx, skip);
+}
+
+static inline void max_utilization_update(struct mpsc_pbuf_buffer *buffer, uint32_t usage)
+{
+	/* Statistics only, a concurrent update may be lost. */
+	if ((buffer->flags & MPSC_PBUF_MAX_UTILIZATION) && usage > buffer->max_usage) {
+		buffer->max_usage = usage;
+	}
+}
+
+void z_mpsc_pbuf_lockless_init(struct mpsc_pbuf_buffer *buffer)
+{
+	buffer->pos_range = (BIT(31) / buffer->size) * buffer->size;
+
+	memset(buffer->buf, 0, buffer->size * sizeof(uint32_t));
+}
+
+/* Move the read position over the freed packets and clear them. */
+static void release(struct mpsc_pbuf_buffer *buffer)
+{
+	bool released = false;
+
+	if (atomic_inc(&buffer->release_req) != 0) {
+		/* The context moving the read position will do it. */
+		return;
+	}
+
+	do {
+		atomic_set(&buffer->release_req, 1);
+
+		while (true) {
+			uint32_t rd = atomic_get(&buffer->rd_pos);
+			uint32_t idx = pos_idx(buffer, rd);
+			union mpsc_pbuf_generic hdr;
+
+			if (rd == (uint32_t)atomic_get(&buffer->claim_pos)) {
+				break;
+			}
+
+			hdr = read_hdr(buffer, idx);
+			if (!is_skip(hdr)) {
+				/* Claimed packet not freed yet. */
+				break;
+			}
+
+			memset(&buffer->buf[idx], 0, hdr.skip.len * sizeof(uint32_t));
+			barrier_dmem_fence_full();
+			atomic_set(&buffer->rd_pos, pos_add(buffer, rd, hdr.skip.len));
+			released = true;
+		}
+	} while (atomic_dec(&buffer->release_req) != 1);
+
+	if (released) {
+		k_sem_give(&buffer->sem);
+	}
+}
+
+/* Reserve contiguous space. When the packet does not fit before the end of
+ * the buffer, the remaining space is reserved as well and filled with a
+ * skip packet.
+ */
+static bool reserve(struct mpsc_pbuf_buffer *buffer, uint32_t wlen, uint32_t *idx)
+{
+	uint32_t wr, rd, usage, pad;
+
+	while (true) {
+		/* The read position only moves forward, so reading it first
+		 * can only overestimate the usage.
+		 */
+		rd = atomic_get(&buffer->rd_pos);
+		wr = atomic_get(&buffer->wr_pos);
+		usage = pos_diff(buffer, wr, rd);
+		if (usage > buffer->size) {
+			/* Both moved on in between, the read position is stale. */
+			continue;
+		}
+
+		*idx = pos_idx(buffer, wr);
+		pad = (*idx + wlen > buffer->size) ? buffer->size - *idx : 0;
+		usage += pad + wlen;
+
+		if (usage > buffer->size) {
+			return false;
+		}
+
+		if (atomic_cas(&buffer->wr_pos, wr, pos_add(buffer, wr, pad + wlen))) {
+			break;
+		}
+	}
+
+	if (pad) {
+		mark_skip(buffer, *idx, pad);
+		*idx = 0;
+	}
+
+	max_utilization_update(buffer, MIN(usage, buffer->size - 1));
+
+	return true;
+}
+
+static bool reserve_packet(struct mpsc_pbuf_buffer *buffer, uint32_t wlen, uint32_t *idx)
+{
+	return (wlen <= buffer->size) && reserve(buffer, wlen, idx);
+}
+
+void z_mpsc_pbuf_lockless_put_word(struct mpsc_pbuf_buffer *buffer,
+				   const union mpsc_pbuf_generic item)
+{
+	uint32_t idx;
+
+	if (reserve_packet(buffer, 1, &idx)) {
+		write_hdr(buffer, idx, item);
+	}
+}
+
+union mpsc_pbuf_generic *z_mpsc_pbuf_lockless_alloc(struct mpsc_pbuf_buffer *buffer,
+						    size_t wlen, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	uint32_t idx;
+
+	if (wlen > buffer->size) {
+		return NULL;
+	}
+
+	while (!reserve(buffer, wlen, &idx)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || k_is_in_isr() ||
+		    k_sem_take(&buffer->sem, sys_timepoint_timeout(end)) != 0) {
+			return NULL;
+		}
+	}
+
+	/* Free space is cleared, header reads as not committed. */
+	return (union mpsc_pbuf_generic *)&buffer->buf[idx];
+}
+
+void z_mpsc_pbuf_lockless_commit(struct mpsc_pbuf_buffer *buffer,
+				 union mpsc_pbuf_generic *item)
+{
+	union mpsc_pbuf_generic hdr = *item;
+
+	hdr.hdr.valid = 1;
+	write_hdr(buffer, (uint32_t *)item - buffer->buf, hdr);
+}
+
+void z_mpsc_pbuf_lockless_put_word_ext(struct mpsc_pbuf_buffer *buffer,
+				       const union mpsc_pbuf_generic item,
+				       const void *data)
+{
+	static const size_t l =
+		(sizeof(item) + sizeof(data)) / sizeof(uint32_t);
+	uint32_t idx;
+
+	if (reserve_packet(buffer, l, &idx)) {
+		void **p = (void **)&buffer->buf[idx + 1];
+
+		*p = (void *)data;
+		write_hdr(buffer, idx, item);
+	}
+}
+
+void z_mpsc_pbuf_lockless_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
+				   size_t wlen)
+{
+	uint32_t idx;
+
+	if (reserve_packet(buffer, wlen, &idx)) {
+		memcpy(&buffer->buf[idx + 1], &data[1], (wlen - 1) * sizeof(uint32_t));
+		write_hdr(buffer, idx, (union mpsc_pbuf_generic){ .raw = data[0] });
+	}
+}
+
+const union mpsc_pbuf_generic *z_mpsc_pbuf_lockless_claim(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item;
+	union mpsc_pbuf_generic hdr;
+	uint32_t claim, idx, wlen;
+
+	while (true) {
+		claim = atomic_get(&buffer->claim_pos);
+		if (claim == (uint32_t)atomic_get(&buffer->wr_pos)) {
+			return NULL;
+		}
+
+		idx = pos_idx(buffer, claim);
+		item = (union mpsc_pbuf_generic *)&buffer->buf[idx];
+		hdr = read_hdr(buffer, idx);
+
+		if (is_empty(hdr)) {
+			/* Not committed yet. */
+			return NULL;
+		}
+
+		wlen = is_skip(hdr) ? hdr.skip.len : buffer->get_wlen(item);
+
+		/* Only the consumer moves the claim position. */
+		atomic_set(&buffer->claim_pos, pos_add(buffer, claim, wlen));
+
+		if (is_skip(hdr)) {
+			release(buffer);
+			continue;
+		}
+
+		item->hdr.busy = 1;
+
+		return item;
+	}
+}
+
+void z_mpsc_pbuf_lockless_free(struct mpsc_pbuf_buffer *buffer,
+			       const union mpsc_pbuf_generic *item)
+{
+	uint32_t idx = (const uint32_t *)item - buffer->buf;
+
+	mark_skip(buffer, idx, buffer->get_wlen(item));
+	release(buffer);
+}
+
+bool z_mpsc_pbuf_lockless_is_pending(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t claim = atomic_get(&buffer->claim_pos);
+
+	if (claim == (uint32_t)atomic_get(&buffer->wr_pos)) {
+		return false;
+	}
+
+	return !is_empty(read_hdr(buffer, pos_idx(buffer, claim)));
+}
+
+void z_mpsc_pbuf_lockless_get_utilization(struct mpsc_pbuf_buffer *buffer,
+					  uint32_t *size, uint32_t *now)
+{
+	uint32_t usage = pos_diff(buffer, atomic_get(&buffer->wr_pos),
+				  atomic_get(&buffer->rd_pos));
+
+	/* Reported like the locked variant, which keeps a word for full/empty
+	 * distinction.
+	 */
+	*size = (buffer->size - 1) * sizeof(int);
+	*now = MIN(usage, buffer->size - 1) * sizeof(int);
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_MPSC_PBUF_LOCKLESS_H_
+#define ZEPHYR_LIB_OS_MPSC_PBUF_LOCKLESS_H_
+
+#include <zephyr/sys/mpsc_pbuf.h>
+
+/* Packet buffer operations without interrupt locking, used by mpsc_pbuf.c
+ * for the buffers which are not in overwrite mode.
+ */
+
+void z_mpsc_pbuf_lockless_init(struct mpsc_pbuf_buffer *buffer);
+
+void z_mpsc_pbuf_lockless_put_word(struct mpsc_pbuf_buffer *buffer,
+				   const union mpsc_pbuf_generic item);
+
+union mpsc_pbuf_generic *z_mpsc_pbuf_lockless_alloc(struct mpsc_pbuf_buffer *buffer,
+						    size_t wlen, k_timeout_t timeout);
+
+void z_mpsc_pbuf_lockless_commit(struct mpsc_pbuf_buffer *buffer,
+				 union mpsc_pbuf_generic *item);
+
+void z_mpsc_pbuf_lockless_put_word_ext(struct mpsc_pbuf_buffer *buffer,
+				       const union mpsc_pbuf_generic item,
+				       const void *data);
+
+void z_mpsc_pbuf_lockless_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
+				   size_t wlen);
+
+const union mpsc_pbuf_generic *z_mpsc_pbuf_lockless_claim(struct mpsc_pbuf_buffer *buffer);
+
+void z_mpsc_pbuf_lockless_free(struct mpsc_pbuf_buffer *buffer,
+			       const union mpsc_pbuf_generic *item);
+
+bool z_mpsc_pbuf_lockless_is_pending(struct mpsc_pbuf_buffer *buffer);
+
+void z_mpsc_pbuf_lockless_get_utilization(struct mpsc_pbuf_buffer *buffer,
+					  uint32_t *size, uint32_t *now);
+
+#endif /* ZEPHYR_LIB_OS_MPSC_PBUF_LOCKLESS_H_ */
@@ -284,6 +284,62 @@ def extract_logging_subsys_information(elf, database, string_mappings):
     log_const_symbols = find_log_const_symbols(elf)
     parse_log_const_symbols(database, section_log_const, log_const_symbols, string_mappings)
 
+    extract_log_event_schemas(elf, database)
+
+
+def extract_log_event_schemas(elf, database):
+    """
+    Extract the schemas of structured events (struct log_event_schema)
+    so that the parser can decode the event records, which start with
+    the address of their schema.
+    """
+    section_schema = find_elf_sections(elf, "log_event_schema_area")
+    if section_schema is None:
+        # CONFIG_LOG_EVENT is disabled
+        return
+
+    if database.is_tgt_little_endian():
+        formatter = "<"
+    else:
+        formatter = ">"
+
+    # Pointers to name, field names and field types
+    if database.is_tgt_64bit():
+        formatter += "QQQ"
+    else:
+        formatter += "LLL"
+
+    datum_size = struct.calcsize(formatter)
+
+    # Schema strings may have been moved into the log_strings section
+    elf_sections = extract_elf_code_data_sections(elf, REMOVED_STRING_SECTIONS)
+
+    def find_schema_string(str_ptr):
+        for _, sect in elf_sections.items():
+            one_str = extract_one_string_in_section(sect, str_ptr)
+            if one_str is not None:
+                return one_str
+
+        return None
+
+    for offset in range(0, section_schema['size'] - datum_size + 1, datum_size):
+        ptrs = struct.unpack_from(formatter, section_schema['data'], offset)
+        name, fields, types = [find_schema_string(ptr) for ptr in ptrs]
+
+        if None in (name, fields, types):
+            logger.warning("Cannot find strings of event schema at " + PTR_FMT,
+                           section_schema['start'] + offset)
+            continue
+
+        fields = fields.split(",") if fields else []
+        if len(fields) != len(types):
+            logger.warning("Malformed schema for event %s", name)
+            continue
+
+        logger.info("Found Log Event: %s(%s)", name, ", ".join(fields))
+
+        database.add_log_event(section_schema['start'] + offset, name, fields, types)
+
 
 def is_die_attr_ref(attr):
     """
@@ -243,6 +243,27 @@ class LogDatabase():
         return f"unknown<{domain_id}:{source_id}>"
 
 
+    def add_log_event(self, address, name, fields, types):
+        """Add the schema of one structured event into database"""
+        if 'log_events' not in self.database['log_subsys']:
+            self.database['log_subsys']['log_events'] = {}
+
+        # JSON stores key as string, so store it as such
+        self.database['log_subsys']['log_events'][str(address)] = {
+            'name'   : name,
+            'fields' : fields,
+            'types'  : types,
+        }
+
+
+    def get_log_event(self, address):
+        """Get the schema of a structured event based on its address.
+        Return None if not found."""
+        events = self.database['log_subsys'].get('log_events', {})
+
+        return events.get(str(address))
+
+
     def add_kconfig(self, name, val):
         """Add a kconfig name-value pair into database"""
         self.database['kconfigs'][name] = val
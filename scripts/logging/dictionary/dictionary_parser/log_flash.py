@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Flash Log Reader for Dictionary-based Logging
+
+This extracts the dictionary-based log data stored by the flash
+logging backend (CONFIG_LOG_BACKEND_FLASH) from a dump of its
+flash partition.
+"""
+
+import binascii
+import logging
+import struct
+
+
+logger = logging.getLogger("parser")
+
+FLASH_LOG_MAGIC = 0x474f4c5a
+FLASH_LOG_VERSION = 1
+
+# struct log_backend_flash_sector_hdr
+FMT_SECTOR_HDR = "IIBBHI"
+# struct log_backend_flash_record_hdr
+FMT_RECORD_HDR = "HHI"
+
+
+def _round_up(val, align):
+    return (val + align - 1) // align * align
+
+
+def _read_sector(data, endian, sector_off, sector_size, align):
+    """Return the log data of the valid records in one sector"""
+    fmt_record = endian + FMT_RECORD_HDR
+    hdr_size = struct.calcsize(fmt_record)
+    offset = _round_up(struct.calcsize(endian + FMT_SECTOR_HDR), align)
+    records = []
+
+    while offset + hdr_size <= sector_size:
+        length, length_inv, crc = struct.unpack_from(fmt_record, data,
+                                                     sector_off + offset)
+        total = _round_up(hdr_size + length, align)
+
+        if (length ^ length_inv) != 0xffff or length == 0 or \
+           offset + total > sector_size:
+            # Erased space or a header torn by a power loss
+            break
+
+        start = sector_off + offset + hdr_size
+        payload = data[start:start + length]
+
+        if binascii.crc32(payload) == crc:
+            records.append(payload)
+        else:
+            logger.debug("Skipping corrupted record at 0x%x", sector_off + offset)
+
+        offset += total
+
+    return records
+
+
+def read_flash_log(data, sector_size, little_endian=True):
+    """
+    Return the list of log records stored in a flash partition dump,
+    oldest first. Each record holds one dictionary-based log message.
+    """
+    endian = "<" if little_endian else ">"
+    fmt_sector = endian + FMT_SECTOR_HDR
+    crc_off = struct.calcsize(fmt_sector) - 4
+    sectors = []
+
+    for sector_off in range(0, len(data) - sector_size + 1, sector_size):
+        magic, seq, version, align, _, crc = struct.unpack_from(fmt_sector, data,
+                                                               sector_off)
+        if magic != FLASH_LOG_MAGIC or version != FLASH_LOG_VERSION or align == 0:
+            continue
+
+        if binascii.crc32(data[sector_off:sector_off + crc_off]) != crc:
+            continue
+
+        sectors.append((seq, sector_off, align))
+
+    if not sectors:
+        return []
+
+    # Sequence numbers may wrap, order them relative to the newest one
+    newest = sectors[0][0]
+    for seq, _, _ in sectors:
+        if ((seq - newest) & 0xffffffff) < 0x80000000:
+            newest = seq
+
+    sectors.sort(key=lambda s: (newest - s[0]) & 0xffffffff, reverse=True)
+
+    records = []
+    for seq, sector_off, align in sectors:
+        logger.debug("Sector at 0x%x, sequence %d", sector_off, seq)
+        records.extend(_read_sector(data, endian, sector_off, sector_size, align))
+
+    return records
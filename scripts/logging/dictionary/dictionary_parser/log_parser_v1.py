@@ -63,6 +63,15 @@ MSG_TYPE_DROPPED = 1
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
 
+# Structured events (include/zephyr/logging/log_event.h) are messages
+# without a package. The data starts with the address of the event schema
+# followed by the fields, packed without padding. Field types are
+# struct format characters, except:
+#   's': string, a length byte followed by the characters
+#   'P': pointer, with the size of a target pointer
+EVENT_TYPE_STR = "s"
+EVENT_TYPE_PTR = "P"
+
 
 logger = logging.getLogger("parser")
 
@@ -359,9 +368,11 @@ class LogParserV1(LogParser):
                   hex_vals, hex_padding, chr_vals))
 
 
-    def parse_one_normal_msg(self, logdata, offset):
-        """Parse one normal log message and print the encoded message"""
-        # Parse log message header
+    def parse_msg_hdr(self, logdata, offset):
+        """Parse the header of a normal log message.
+
+        Return a tuple of domain ID, level, source ID, timestamp, package
+        length, data length and offset of the package."""
         log_desc, source_id = struct.unpack_from(self.fmt_msg_hdr, logdata, offset)
         offset += struct.calcsize(self.fmt_msg_hdr)
 
@@ -374,12 +385,141 @@ class LogParserV1(LogParser):
         pkg_len = (log_desc >> 6) & int(math.pow(2, 10) - 1)
         data_len = (log_desc >> 16) & int(math.pow(2, 12) - 1)
 
+        return (domain_id, level, source_id, timestamp, pkg_len, data_len, offset)
+
+
+    def decode_event(self, data):
+        """Decode a structured event record.
+
+        Return a tuple of the event name, a dictionary of the fields and
+        the field types, or None if the record does not refer to a known
+        event schema."""
+        ptr_fmt = self.data_types.get_formatter(DataTypes.PTR)
+        endian = ptr_fmt[0]
+
+        try:
+            schema_ptr = struct.unpack_from(ptr_fmt, data, 0)[0]
+        except struct.error:
+            return None
+
+        schema = self.database.get_log_event(schema_ptr)
+        if schema is None:
+            return None
+
+        offset = self.data_types.get_sizeof(DataTypes.PTR)
+        fields = {}
+
+        try:
+            for field, field_type in zip(schema['fields'], schema['types']):
+                if field_type == EVENT_TYPE_STR:
+                    str_len = data[offset]
+                    value = data[(offset + 1):(offset + 1 + str_len)].decode("iso-8859-1")
+                    offset += 1 + str_len
+
+                    if len(value) != str_len:
+                        return None
+                else:
+                    if field_type == EVENT_TYPE_PTR:
+                        fmt = ptr_fmt
+                    else:
+                        fmt = endian + field_type
+
+                    value = struct.unpack_from(fmt, data, offset)[0]
+                    offset += struct.calcsize(fmt)
+
+                    if isinstance(value, bytes):
+                        value = value.decode("iso-8859-1")
+
+                fields[field] = value
+        except (IndexError, struct.error):
+            return None
+
+        return (schema['name'], fields, schema['types'])
+
+
+    @staticmethod
+    def format_event_field(field, value, field_type):
+        """Format one event field for printing"""
+        if field_type == EVENT_TYPE_PTR:
+            return f"{field}=0x{value:x}"
+
+        if isinstance(value, str):
+            return f'{field}="{value}"'
+
+        return f"{field}={value}"
+
+
+    def parse_log_events(self, logdata):
+        """Parse binary log data and yield the structured events.
+
+        Each event is a dictionary. Messages which are not events are
+        skipped and the number of dropped messages is reported as
+        {"dropped": count}."""
+        offset = 0
+
+        while offset < len(logdata):
+            msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
+            offset += struct.calcsize(self.fmt_msg_type)
+
+            if msg_type == MSG_TYPE_DROPPED:
+                num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)[0]
+                offset += struct.calcsize(self.fmt_dropped_cnt)
+
+                yield {"dropped": num_dropped}
+
+            elif msg_type == MSG_TYPE_NORMAL:
+                domain_id, level, source_id, timestamp, pkg_len, data_len, offset = \
+                    self.parse_msg_hdr(logdata, offset)
+
+                next_msg_offset = offset + pkg_len + data_len
+
+                if pkg_len == 0:
+                    event = self.decode_event(logdata[offset:next_msg_offset])
+                    if event is not None:
+                        yield {
+                            "timestamp": timestamp,
+                            "domain": domain_id,
+                            "level": get_log_level_str_color(level)[0],
+                            "source": self.database.get_log_source_string(domain_id,
+                                                                          source_id),
+                            "event": event[0],
+                            "fields": event[1],
+                        }
+
+                offset = next_msg_offset
+
+            else:
+                logger.error("------ Unknown message type: %s", msg_type)
+                return
+
+
+    def parse_one_normal_msg(self, logdata, offset):
+        """Parse one normal log message and print the encoded message"""
+        domain_id, level, source_id, timestamp, pkg_len, data_len, offset = \
+            self.parse_msg_hdr(logdata, offset)
+
         level_str, color = get_log_level_str_color(level)
         source_id_str = self.database.get_log_source_string(domain_id, source_id)
 
         # Skip over data to point to next message (save as return value)
         next_msg_offset = offset + pkg_len + data_len
 
+        if pkg_len == 0:
+            # No format string, may be a structured event
+            log_prefix = f"[{timestamp:>10}] <{level_str}> {source_id_str}: "
+            event = self.decode_event(logdata[offset:next_msg_offset])
+            if event is not None:
+                name, fields, types = event
+                log_msg = " ".join([name] + [self.format_event_field(field, value, field_type)
+                                             for (field, value), field_type
+                                             in zip(fields.items(), types)])
+                print(f"{color}%s%s{Fore.RESET}" % (log_prefix, log_msg))
+            else:
+                print(f"{color}%s{Fore.RESET}" % log_prefix)
+                self.print_hexdump(logdata[offset:next_msg_offset], len(log_prefix), color)
+
+            return next_msg_offset
+
         # Offset from beginning of cbprintf_packaged data to end of va_list arguments
         offset_end_of_args = struct.unpack_from("B", logdata, offset)[0]
         offset_end_of_args *= self.data_types.get_sizeof(DataTypes.INT)
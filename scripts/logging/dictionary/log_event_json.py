@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Structured Event Decoder for Dictionary-based Logging
+
+This uses the JSON database file to decode the structured events
+(LOG_EVENT()) in the input binary log data and prints them as JSON,
+one object per line. Log messages which are not events are skipped.
+"""
+
+import argparse
+import json
+import logging
+import sys
+
+import dictionary_parser
+from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_flash import read_flash_log
+from log_parser import read_log_file
+
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("--hex", action="store_true",
+                           help="Log Data file is in hexadecimal strings")
+    argparser.add_argument("--rawhex", action="store_true",
+                           help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--flash", action="store_true",
+                           help="Log Data file is a dump of the flash log partition")
+    argparser.add_argument("--sector-size", type=lambda x: int(x, 0), default=4096,
+                           help="Erase sector size of the flash log partition")
+    argparser.add_argument("--output", type=argparse.FileType("w"), default=sys.stdout,
+                           help="Output file (default: standard output)")
+
+    return argparser.parse_args()
+
+
+def main():
+    """Main function of structured event decoder"""
+    args = parse_args()
+
+    logging.basicConfig(format=LOGGER_FORMAT)
+
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    logdata = read_log_file(args)
+    if logdata is None:
+        logger.error("ERROR: cannot read log from file: %s, exiting...", args.logfile)
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    if args.flash:
+        records = read_flash_log(logdata, args.sector_size, database.is_tgt_little_endian())
+    else:
+        records = [logdata]
+
+    for record in records:
+        for event in log_parser.parse_log_events(record):
+            args.output.write(json.dumps(event) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -18,6 +18,7 @@ import sys
 
 import dictionary_parser
 from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_flash import read_flash_log
 
 
 LOGGER_FORMAT = "%(message)s"
@@ -36,6 +37,10 @@ def parse_args():
                            help="Log Data file is in hexadecimal strings")
     argparser.add_argument("--rawhex", action="store_true",
                            help="Log file only contains hexadecimal log data")
+    argparser.add_argument("--flash", action="store_true",
+                           help="Log Data file is a dump of the flash log partition")
+    argparser.add_argument("--sector-size", type=lambda x: int(x, 0), default=4096,
+                           help="Erase sector size of the flash log partition")
     argparser.add_argument("--debug", action="store_true",
                            help="Print extra debugging information")
 
@@ -132,7 +137,14 @@ def main():
         else:
             logger.debug("# Endianness: Big")
 
-        ret = log_parser.parse_log_data(logdata, debug=args.debug)
+        if args.flash:
+            # Records are independent, a bad one must not affect the others
+            ret = True
+            for record in read_flash_log(logdata, args.sector_size,
+                                         database.is_tgt_little_endian()):
+                ret = log_parser.parse_log_data(record, debug=args.debug) and ret
+        else:
+            ret = log_parser.parse_log_data(logdata, debug=args.debug)
         if not ret:
             logger.error("ERROR: there were error(s) parsing log data")
             sys.exit(1)
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Tests for the structured event decoding of the dictionary logging parser
+"""
+
+import os
+import struct
+import sys
+
+import pytest
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+sys.path.insert(0, os.path.join(ZEPHYR_BASE, "scripts/logging/dictionary"))
+
+from dictionary_parser.log_database import LogDatabase
+from dictionary_parser.log_parser_v1 import LogParserV1
+
+SCHEMA_ADDR = 0x1000
+SOURCE_ID = 3
+
+
+@pytest.fixture
+def parser(tmp_path):
+    database = LogDatabase()
+    database.set_tgt_bits(32)
+    database.set_tgt_endianness(LogDatabase.LITTLE_ENDIAN)
+    database.add_log_instance(SOURCE_ID, "app", 3, 0x2000)
+    database.add_log_event(SCHEMA_ADDR, "sample", ["a", "b", "c", "d", "e", "f"], "BhqdsP")
+    database.add_log_event(SCHEMA_ADDR + 12, "boot", [], "")
+
+    # Go through the file as the tools do
+    db_file = str(tmp_path / "database.json")
+    assert LogDatabase.write_json_database(db_file, database)
+
+    return LogParserV1(LogDatabase.read_json_database(db_file))
+
+
+def msg(data, pkg=b"", level=3, timestamp=100):
+    desc = level << 3 | len(pkg) << 6 | len(data) << 16
+    return struct.pack("<BIII", 0, desc, SOURCE_ID, timestamp) + pkg + data
+
+
+def sample_record():
+    return struct.pack("<IBhqdB3sI", SCHEMA_ADDR, 200, -2, -4, 2.5, 3, b"abc", 0xcafe)
+
+
+def test_decode_event(parser):
+    name, fields, types = parser.decode_event(sample_record())
+
+    assert name == "sample"
+    assert fields == {"a": 200, "b": -2, "c": -4, "d": 2.5, "e": "abc", "f": 0xcafe}
+    assert types == "BhqdsP"
+
+
+def test_decode_event_no_fields(parser):
+    assert parser.decode_event(struct.pack("<I", SCHEMA_ADDR + 12)) == ("boot", {}, "")
+
+
+def test_decode_event_unknown_schema(parser):
+    assert parser.decode_event(struct.pack("<IB", 0x3000, 1)) is None
+
+
+def test_decode_event_truncated(parser):
+    assert parser.decode_event(sample_record()[:-1]) is None
+
+
+def test_parse_log_events(parser):
+    logdata = (msg(sample_record(), timestamp=5) +
+               msg(b"\x01\x02", pkg=b"\x00" * 8) +
+               struct.pack("<BH", 1, 7) +
+               msg(struct.pack("<I", SCHEMA_ADDR + 12), level=2))
+
+    events = list(parser.parse_log_events(logdata))
+
+    assert events == [
+        {
+            "timestamp": 5,
+            "domain": 0,
+            "level": "inf",
+            "source": "app",
+            "event": "sample",
+            "fields": {"a": 200, "b": -2, "c": -4, "d": 2.5, "e": "abc", "f": 0xcafe},
+        },
+        {"dropped": 7},
+        {
+            "timestamp": 100,
+            "domain": 0,
+            "level": "wrn",
+            "source": "app",
+            "event": "boot",
+            "fields": {},
+        },
+    ]
+
+
+def test_parse_log_data(parser, capsys):
+    assert parser.parse_log_data(msg(sample_record()))
+
+    out = capsys.readouterr().out
+    assert 'sample a=200 b=-2 c=-4 d=2.5 e="abc" f=0xcafe' in out
+    assert "<inf> app:" in out
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Tests for the flash log reader of the dictionary logging parser
+"""
+
+import binascii
+import os
+import struct
+import sys
+
+import pytest
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+sys.path.insert(0, os.path.join(ZEPHYR_BASE, "scripts/logging/dictionary"))
+
+from dictionary_parser.log_flash import FLASH_LOG_MAGIC, FLASH_LOG_VERSION, read_flash_log
+
+SECTOR_SIZE = 256
+
+
+def records(*payloads, endian="<", align=4):
+    data = b""
+
+    for payload in payloads:
+        length = len(payload)
+        data += struct.pack(endian + "HHI", length, length ^ 0xffff, binascii.crc32(payload))
+        data += payload + b"\xff" * (-(8 + length) % align)
+
+    return data
+
+
+def sector(seq, data, endian="<", align=4, magic=FLASH_LOG_MAGIC, version=FLASH_LOG_VERSION):
+    hdr = struct.pack(endian + "IIBBH", magic, seq, version, align, 0xffff)
+    hdr += struct.pack(endian + "I", binascii.crc32(hdr))
+    hdr += b"\xff" * (-len(hdr) % max(align, 1))
+
+    assert len(hdr + data) <= SECTOR_SIZE
+
+    return hdr + data + b"\xff" * (SECTOR_SIZE - len(hdr + data))
+
+
+def erased():
+    return b"\xff" * SECTOR_SIZE
+
+
+@pytest.mark.parametrize("little_endian", [True, False])
+def test_sector_order(little_endian):
+    endian = "<" if little_endian else ">"
+    dump = (sector(7, records(b"c", b"d", endian=endian), endian) +
+            erased() +
+            sector(5, records(b"a", endian=endian), endian) +
+            sector(6, records(b"b", endian=endian), endian))
+
+    assert read_flash_log(dump, SECTOR_SIZE, little_endian) == [b"a", b"b", b"c", b"d"]
+
+
+def test_sequence_wrap():
+    dump = (sector(1, records(b"d")) +
+            sector(0xfffffffe, records(b"a")) +
+            sector(0, records(b"c")) +
+            sector(0xffffffff, records(b"b")))
+
+    assert read_flash_log(dump, SECTOR_SIZE) == [b"a", b"b", b"c", b"d"]
+
+
+def test_alignment():
+    dump = sector(0, records(b"abc", b"defghijkl", align=16), align=16)
+
+    assert read_flash_log(dump, SECTOR_SIZE) == [b"abc", b"defghijkl"]
+
+
+def test_torn_record_payload():
+    # Power lost while the payload of the last record was written
+    torn = bytearray(records(b"lost message"))
+    torn[-4:] = b"\xff" * 4
+
+    dump = sector(0, records(b"a") + torn) + sector(1, records(b"b"))
+
+    assert read_flash_log(dump, SECTOR_SIZE) == [b"a", b"b"]
+
+
+def test_torn_record_header():
+    # Power lost while the record header was written, the length is
+    # written but not its inverted copy. The rest of the sector is not read.
+    torn = struct.pack("<H", 12) + b"\xff" * 6
+
+    dump = sector(0, records(b"a") + torn + records(b"b")) + sector(1, records(b"c"))
+
+    assert read_flash_log(dump, SECTOR_SIZE) == [b"a", b"c"]
+
+
+def test_corrupted_sector_header():
+    bad_crc = bytearray(sector(1, records(b"lost")))
+    bad_crc[4] ^= 0x01
+
+    dump = (sector(0, records(b"a")) +
+            bad_crc +
+            sector(2, records(b"lost"), magic=FLASH_LOG_MAGIC ^ 1) +
+            sector(3, records(b"lost"), version=FLASH_LOG_VERSION + 1) +
+            sector(4, records(b"lost"), align=0) +
+            sector(5, records(b"b")))
+
+    assert read_flash_log(bytes(dump), SECTOR_SIZE) == [b"a", b"b"]
+
+
+def test_empty():
+    assert read_flash_log(erased() * 2, SECTOR_SIZE) == []
+    assert read_flash_log(b"", SECTOR_SIZE) == []
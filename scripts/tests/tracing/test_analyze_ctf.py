@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Tests for analyze_ctf.py
+"""
+
+import os
+import struct
+import sys
+
+import pytest
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+sys.path.insert(0, os.path.join(ZEPHYR_BASE, "scripts/tracing"))
+
+import analyze_ctf
+
+
+@pytest.fixture(scope="module")
+def metadata():
+    path = os.path.join(ZEPHYR_BASE, "subsys/tracing/ctf/tsdl/metadata")
+    with open(path, encoding="utf-8") as f:
+        return analyze_ctf.CtfMetadata(f.read())
+
+
+def ev(ts, event_id, fmt="", *fields):
+    return struct.pack("<IB" + fmt, ts, event_id, *fields)
+
+
+def thread_ev(ts, event_id, thread_id, name):
+    return ev(ts, event_id, "I20s", thread_id, name.encode())
+
+
+SWITCHED_OUT = 0x10
+SWITCHED_IN = 0x11
+READY = 0x17
+PENDING = 0x18
+ISR_ENTER = 0x1B
+ISR_EXIT = 0x1C
+MUTEX_LOCK_ENTER = 0x29
+MUTEX_LOCK_BLOCKING = 0x2A
+MUTEX_LOCK_EXIT = 0x2B
+MUTEX_UNLOCK_ENTER = 0x2C
+
+MUTEX = 0x100
+
+
+def test_metadata(metadata):
+    name, fields = metadata.events[SWITCHED_IN]
+    assert name == "thread_switched_in"
+    assert [f[0] for f in fields] == ["thread_id", "name"]
+    assert [f[0] for f in metadata.header] == ["timestamp", "id"]
+
+
+def test_contention(metadata):
+    stream = b"".join([
+        thread_ev(0, SWITCHED_IN, 1, "a"),
+        ev(1000, MUTEX_LOCK_ENTER, "II", MUTEX, 0),
+        ev(1000, MUTEX_LOCK_EXIT, "IIi", MUTEX, 0, 0),
+        ev(2000, ISR_ENTER),
+        ev(5000, ISR_EXIT),
+        thread_ev(6000, SWITCHED_OUT, 1, "a"),
+        thread_ev(6000, SWITCHED_IN, 2, "b"),
+        ev(7000, MUTEX_LOCK_ENTER, "II", MUTEX, 0xffffffff),
+        ev(7000, MUTEX_LOCK_BLOCKING, "II", MUTEX, 0xffffffff),
+        thread_ev(7000, PENDING, 2, "b"),
+        thread_ev(7000, SWITCHED_OUT, 2, "b"),
+        thread_ev(8000, SWITCHED_IN, 1, "a"),
+        ev(20000, MUTEX_UNLOCK_ENTER, "I", MUTEX),
+        thread_ev(20000, READY, 2, "b"),
+        thread_ev(21000, SWITCHED_OUT, 1, "a"),
+        thread_ev(21000, SWITCHED_IN, 2, "b"),
+        ev(21000, MUTEX_LOCK_EXIT, "IIi", MUTEX, 0xffffffff, 0),
+    ])
+
+    analysis = analyze_ctf.analyze(metadata, [stream], timeline=True)
+
+    a = analysis.threads[1]
+    b = analysis.threads[2]
+    assert a.time["running"] == 19000
+    assert a.time["ready"] == 2000
+    assert b.time["running"] == 1000
+    assert b.time["blocked"] == 13000
+    assert b.time["ready"] == 1000
+
+    mutex = analysis.objects[("mutex", MUTEX)]
+    assert mutex.acquired == 2
+    assert mutex.contended == 1
+    assert mutex.wait.samples == [14000]
+    assert mutex.hold.samples == [19000]
+
+    assert analysis.wakeup.samples == [1000]
+    assert analysis.isr.samples == [3000]
+
+
+def test_sleep(metadata):
+    """Thread switched out without pending is blocked if made ready later"""
+    stream = b"".join([
+        thread_ev(0, SWITCHED_IN, 1, "a"),
+        thread_ev(1000, SWITCHED_OUT, 1, "a"),
+        thread_ev(1000, SWITCHED_IN, 2, "idle"),
+        thread_ev(5000, READY, 1, "a"),
+        thread_ev(5000, SWITCHED_OUT, 2, "idle"),
+        thread_ev(5500, SWITCHED_IN, 1, "a"),
+    ])
+
+    analysis = analyze_ctf.analyze(metadata, [stream], timeline=True)
+
+    a = analysis.threads[1]
+    assert a.time["blocked"] == 4000
+    assert a.time["ready"] == 500
+    assert ("blocked" in [state for _, label, state in analysis.timeline if label == "a"])
+    assert analysis.threads[2].time["ready"] == 500
+
+
+def test_per_cpu(metadata):
+    """Events of per-CPU buffers are attributed to the thread of their CPU"""
+    path = os.path.join(ZEPHYR_BASE, "subsys/tracing/ctf/tsdl/metadata")
+    with open(path, encoding="utf-8") as f:
+        text = f.read().replace("struct event_header {\n",
+                                "struct event_header {\n\tuint8_t cpu;\n")
+    metadata = analyze_ctf.CtfMetadata(text)
+    assert [f[0] for f in metadata.header] == ["cpu", "timestamp", "id"]
+
+    stream = b"".join([
+        b"\x01" + thread_ev(0, SWITCHED_IN, 2, "b"),
+        b"\x00" + thread_ev(0, SWITCHED_IN, 1, "a"),
+        b"\x01" + ev(1000, MUTEX_LOCK_BLOCKING, "II", MUTEX, 0xffffffff),
+        b"\x00" + ev(2000, MUTEX_LOCK_BLOCKING, "II", MUTEX, 0xffffffff),
+        b"\x01" + ev(4000, MUTEX_LOCK_EXIT, "IIi", MUTEX, 0xffffffff, 0),
+        b"\x00" + ev(7000, MUTEX_LOCK_EXIT, "IIi", MUTEX, 0xffffffff, 0),
+    ])
+
+    analysis = analyze_ctf.analyze(metadata, [stream])
+
+    mutex = analysis.objects[("mutex", MUTEX)]
+    assert mutex.wait.samples == [3000, 5000]
+    assert analysis.threads[1].time["running"] == 7000
+    assert analysis.threads[2].time["running"] == 7000
+
+
+def test_timestamp_wrap(metadata):
+    stream = b"".join([
+        ev(0xfffff000, ISR_ENTER),
+        ev(0x00001000, ISR_EXIT),
+    ])
+
+    analysis = analyze_ctf.analyze(metadata, [stream])
+
+    assert analysis.isr.samples == [0x2000]
+
+
+def test_report(metadata):
+    stream = thread_ev(0, SWITCHED_IN, 1, "a") + thread_ev(1000, SWITCHED_OUT, 1, "a")
+    analysis = analyze_ctf.analyze(metadata, [stream])
+
+    class Out:
+        text = ""
+
+        def write(self, s):
+            self.text += s
+
+    out = Out()
+    analyze_ctf.report(analysis, out)
+    assert "Wakeup latency" in out.text
+    assert "ISR duration" in out.text
@@ -0,0 +1,500 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to analyze a CTF trace of the Zephyr kernel and report scheduling
+and contention statistics:
+
+- time spent by each thread running, ready, blocked and suspended,
+  optionally with the timeline of the state changes,
+- histogram of the wakeup latency, from a thread being made ready to it
+  being switched in,
+- contention of semaphores and mutexes: blocking acquisitions, wait times
+  and mutex hold times,
+- ISR durations.
+
+The CTF stream is decoded using the TSDL metadata of the trace, babeltrace
+is not needed. Generate a trace using samples/subsys/tracing, for example
+on native_sim:
+
+    west build -b native_sim samples/subsys/tracing \\
+      -- -DCONF_FILE=prj_native_ctf.conf
+
+    mkdir ctf
+    cp subsys/tracing/ctf/tsdl/metadata ctf/
+    ./build/zephyr/zephyr.exe -trace-file=ctf/channel0_0 -stop_at=5
+    ./scripts/tracing/analyze_ctf.py -t ctf
+
+With CONFIG_TRACING_PER_CPU_BUFFERS, use the metadata generated in
+build/zephyr/tracing/ctf/metadata. Events then identify their CPU and kernel
+object operations are attributed to the thread running on that CPU.
+Otherwise, on SMP targets, they are attributed to the thread switched in
+last.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+from collections import defaultdict
+
+TS_WRAP = 1 << 32
+
+THREAD_STATES = ("running", "ready", "blocked", "suspended")
+
+
+class CtfMetadata:
+    """Subset of TSDL used by subsys/tracing/ctf/tsdl/metadata"""
+
+    def __init__(self, text):
+        text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+        text = re.sub(r"//[^\n]*", "", text)
+
+        self.types = {}
+        for body, name in re.findall(r"typealias\s+integer\s*\{([^}]*)\}\s*:=\s*(\w+)\s*;",
+                                     text):
+            attrs = dict(re.findall(r"(\w+)\s*=\s*(\w+)\s*;", body))
+            self.types[name] = (int(attrs["size"]) // 8, attrs.get("signed") == "true",
+                                "encoding" in attrs)
+
+        order = re.search(r"byte_order\s*=\s*(\w+)\s*;", text)
+        self.endian = ">" if order and order.group(1) == "be" else "<"
+
+        header = re.search(r"struct\s+event_header\s*\{([^}]*)\}", text)
+        if header is None:
+            raise ValueError("event_header not found in metadata")
+        self.header = self._fields(header.group(1))
+
+        self.events = {}
+        for body in re.findall(r"\bevent\s*\{(.*?)\}\s*;", text, flags=re.S):
+            name = re.search(r"name\s*=\s*(\w+)\s*;", body)
+            event_id = re.search(r"\bid\s*=\s*(\w+)\s*;", body)
+            if name is None or event_id is None:
+                continue
+            fields = re.search(r"fields\s*:=\s*struct\s*\{(.*)", body, flags=re.S)
+            self.events[int(event_id.group(1), 0)] = (
+                name.group(1), self._fields(fields.group(1)) if fields else [])
+
+    def _fields(self, body):
+        fields = []
+        for type_name, name, length in re.findall(r"(\w+)\s+(\w+)\s*(?:\[(\d+)\])?\s*;",
+                                                  body):
+            if type_name not in self.types:
+                raise ValueError(f"Unknown type {type_name}")
+            fields.append((name, type_name, int(length) if length else None))
+        return fields
+
+    def _read_fields(self, fields, data, offset):
+        values = {}
+        for name, type_name, length in fields:
+            size, signed, text = self.types[type_name]
+            if length is not None and text:
+                raw = data[offset:offset + length]
+                if len(raw) < length:
+                    raise EOFError
+                values[name] = raw.split(b"\0", 1)[0].decode("ascii", "replace")
+                offset += length
+                continue
+
+            fmt = self.endian + {1: "b", 2: "h", 4: "i", 8: "q"}[size]
+            if not signed:
+                fmt = fmt.upper()
+            if length is None:
+                if offset + size > len(data):
+                    raise EOFError
+                values[name] = struct.unpack_from(fmt, data, offset)[0]
+                offset += size
+            else:
+                if offset + size * length > len(data):
+                    raise EOFError
+                values[name] = [struct.unpack_from(fmt, data, offset + i * size)[0]
+                                for i in range(length)]
+                offset += size * length
+        return values, offset
+
+    def events_read(self, data):
+        """
+        Yield (timestamp, cpu, name, fields) for each event of a stream.
+        The 32-bit timestamps are unwrapped, cpu is 0 if the event header
+        has no cpu field.
+        """
+        offset = 0
+        wraps = 0
+        last = None
+
+        while offset < len(data):
+            try:
+                header, offset = self._read_fields(self.header, data, offset)
+            except EOFError:
+                break
+
+            event_id = header.get("id")
+            if event_id not in self.events:
+                raise ValueError(f"Unknown event id 0x{event_id:x} at offset {offset}")
+
+            name, fields = self.events[event_id]
+            try:
+                values, offset = self._read_fields(fields, data, offset)
+            except EOFError:
+                break
+
+            ts = header.get("timestamp", 0)
+            if last is not None and (last - ts) > TS_WRAP // 2:
+                wraps += 1
+            last = ts
+
+            yield ts + wraps * TS_WRAP, header.get("cpu", 0), name, values
+
+
+class Stats:
+    """Count, total, min and max of durations in nanoseconds"""
+
+    def __init__(self):
+        self.samples = []
+
+    def add(self, value):
+        self.samples.append(value)
+
+    @property
+    def count(self):
+        return len(self.samples)
+
+    @property
+    def total(self):
+        return sum(self.samples)
+
+    @property
+    def avg(self):
+        return self.total / self.count if self.samples else 0
+
+    @property
+    def min(self):
+        return min(self.samples, default=0)
+
+    @property
+    def max(self):
+        return max(self.samples, default=0)
+
+
+class Thread:
+    def __init__(self, thread_id, name=""):
+        self.id = thread_id
+        self.name = name
+        self.state = None
+        self.since = None
+        self.blocking = False
+        self.ready_at = None
+        # Set when switched out while runnable, to the index of the state
+        # change in the timeline (-1 if there is no timeline)
+        self.switched_out = None
+        self.time = dict.fromkeys(THREAD_STATES, 0)
+
+    @property
+    def label(self):
+        return self.name or f"0x{self.id:08x}"
+
+
+class KernelObject:
+    def __init__(self, kind, obj_id):
+        self.kind = kind
+        self.id = obj_id
+        self.acquired = 0
+        self.contended = 0
+        self.failed = 0
+        self.wait = Stats()
+        self.hold = Stats()
+        # Waiting threads and since when, time the mutex was taken
+        self.waiting = {}
+        self.owned_at = None
+        self.depth = 0
+
+
+class TraceAnalysis:
+    def __init__(self, timeline=False):
+        self.threads = {}
+        # Running thread of each CPU and CPU of the event being handled
+        self.running = {}
+        self.cpu = 0
+        self.objects = {}
+        self.wakeup = Stats()
+        self.isr = Stats()
+        self.isr_stack = []
+        self.timeline = [] if timeline else None
+        self.start = None
+        self.end = None
+
+    def thread(self, fields):
+        thread_id = fields["thread_id"]
+        th = self.threads.get(thread_id)
+        if th is None:
+            th = self.threads[thread_id] = Thread(thread_id)
+        if fields.get("name"):
+            th.name = fields["name"]
+        return th
+
+    def obj(self, kind, obj_id):
+        key = (kind, obj_id)
+        if key not in self.objects:
+            self.objects[key] = KernelObject(kind, obj_id)
+        return self.objects[key]
+
+    def state_set(self, th, state, ts):
+        if th.state is not None and th.since is not None:
+            th.time[th.state] += ts - th.since
+        if self.timeline is not None and state != th.state:
+            self.timeline.append((ts, th.label, state))
+        th.state = state
+        th.since = ts
+
+    @property
+    def current(self):
+        return self.running.get(self.cpu)
+
+    @current.setter
+    def current(self, th):
+        self.running[self.cpu] = th
+
+    def current_id(self):
+        return self.current.id if self.current else None
+
+    def event(self, ts, name, fields, cpu=0):
+        self.cpu = cpu
+        if self.start is None:
+            self.start = ts
+        self.end = ts
+
+        handler = getattr(self, "on_" + name, None)
+        if handler is None:
+            prefix, _, _ = name.partition("_")
+            handler = getattr(self, "on_" + prefix, None)
+        if handler is not None:
+            handler(ts, name, fields)
+
+    def on_thread_create(self, ts, name, fields):
+        self.thread(fields)
+
+    on_thread_info = on_thread_create
+    on_thread_name_set = on_thread_create
+    on_thread_priority_set = on_thread_create
+
+    def on_thread_switched_in(self, ts, name, fields):
+        th = self.thread(fields)
+        if th.ready_at is not None:
+            self.wakeup.add(ts - th.ready_at)
+            th.ready_at = None
+        th.blocking = False
+        th.switched_out = None
+        self.state_set(th, "running", ts)
+        self.current = th
+
+    def on_thread_switched_out(self, ts, name, fields):
+        th = self.thread(fields)
+        if th.state == "running":
+            self.state_set(th, "blocked" if th.blocking else "ready", ts)
+            if not th.blocking:
+                th.switched_out = len(self.timeline) - 1 if self.timeline is not None else -1
+        th.blocking = False
+        if self.current is th:
+            self.current = None
+
+    def on_thread_pending(self, ts, name, fields):
+        th = self.thread(fields)
+        if th.state == "running":
+            # Still running until switched out
+            th.blocking = True
+        else:
+            th.switched_out = None
+            self.state_set(th, "blocked", ts)
+
+    def on_thread_ready(self, ts, name, fields):
+        th = self.thread(fields)
+        th.blocking = False
+        if th.switched_out is not None:
+            # Switched out without a pending event, e.g. to sleep, the
+            # thread was not runnable until now.
+            th.state = "blocked"
+            if th.switched_out >= 0:
+                ts_out, label, _ = self.timeline[th.switched_out]
+                self.timeline[th.switched_out] = (ts_out, label, "blocked")
+            th.switched_out = None
+        if th.state != "running":
+            th.ready_at = ts
+            self.state_set(th, "ready", ts)
+
+    on_thread_resume = on_thread_ready
+
+    def on_thread_suspend(self, ts, name, fields):
+        th = self.thread(fields)
+        th.ready_at = None
+        th.switched_out = None
+        self.state_set(th, "suspended", ts)
+
+    def on_thread_abort(self, ts, name, fields):
+        th = self.thread(fields)
+        th.ready_at = None
+        th.switched_out = None
+        self.state_set(th, None, ts)
+        if self.current is th:
+            self.current = None
+
+    def on_isr_enter(self, ts, name, fields):
+        self.isr_stack.append(ts)
+
+    def on_isr_exit(self, ts, name, fields):
+        if self.isr_stack:
+            self.isr.add(ts - self.isr_stack.pop())
+
+    on_isr_exit_to_scheduler = on_isr_exit
+
+    def lock_wait(self, obj, ts):
+        obj.contended += 1
+        obj.waiting[self.current_id()] = ts
+
+    def lock_done(self, obj, ts, ret):
+        started = obj.waiting.pop(self.current_id(), None)
+        if started is not None:
+            obj.wait.add(ts - started)
+        if ret != 0:
+            obj.failed += 1
+            return False
+        obj.acquired += 1
+        return True
+
+    def on_semaphore(self, ts, name, fields):
+        sem = self.obj("semaphore", fields["id"])
+        if name == "semaphore_take_blocking":
+            self.lock_wait(sem, ts)
+        elif name == "semaphore_take_exit":
+            self.lock_done(sem, ts, fields["ret"])
+
+    def on_mutex(self, ts, name, fields):
+        mutex = self.obj("mutex", fields["id"])
+        if name == "mutex_lock_blocking":
+            self.lock_wait(mutex, ts)
+        elif name == "mutex_lock_exit":
+            if self.lock_done(mutex, ts, fields["ret"]):
+                if mutex.depth == 0:
+                    mutex.owned_at = ts
+                mutex.depth += 1
+        elif name == "mutex_unlock_enter":
+            if mutex.depth > 0:
+                mutex.depth -= 1
+                if mutex.depth == 0 and mutex.owned_at is not None:
+                    mutex.hold.add(ts - mutex.owned_at)
+                    mutex.owned_at = None
+
+    def finish(self):
+        for th in self.threads.values():
+            if th.state is not None and th.since is not None:
+                th.time[th.state] += self.end - th.since
+                th.since = self.end
+
+
+def us(ns):
+    return ns / 1000
+
+
+def histogram(stats, out, width=40):
+    """Print a histogram of durations with power of 2 microsecond buckets"""
+    if not stats.count:
+        print("  no samples", file=out)
+        return
+
+    buckets = defaultdict(int)
+    for value in stats.samples:
+        buckets[max(int(us(value)), 1).bit_length() - 1] += 1
+
+    peak = max(buckets.values())
+    for b in range(max(buckets) + 1):
+        low = 0 if b == 0 else 1 << b
+        label = f"{low}-{1 << (b + 1)} us"
+        bar = "#" * max(1 if buckets[b] else 0, buckets[b] * width // peak)
+        print(f"  {label:>16} {buckets[b]:8} {bar}", file=out)
+
+    print(f"  count {stats.count}, min {us(stats.min):.1f} us, avg {us(stats.avg):.1f} us, "
+          f"max {us(stats.max):.1f} us", file=out)
+
+
+def report(analysis, out=sys.stdout):
+    duration = (analysis.end or 0) - (analysis.start or 0)
+    print(f"Trace duration: {us(duration) / 1000:.3f} ms", file=out)
+
+    print("\nThreads (time in ms, percentage of the trace):", file=out)
+    print(f"  {'thread':<20}" + "".join(f"{s:>20}" for s in THREAD_STATES), file=out)
+    for th in sorted(analysis.threads.values(), key=lambda t: -t.time["running"]):
+        cols = ""
+        for s in THREAD_STATES:
+            pct = 100 * th.time[s] / duration if duration else 0
+            cols += f"{us(th.time[s]) / 1000:>12.3f} ({pct:5.1f}%)"
+        print(f"  {th.label:<20}{cols}", file=out)
+
+    if analysis.timeline is not None:
+        print("\nTimeline:", file=out)
+        for ts, label, state in analysis.timeline:
+            print(f"  {us(ts - analysis.start) / 1000:12.3f} ms  {label:<20} "
+                  f"{state or 'terminated'}", file=out)
+
+    print("\nWakeup latency:", file=out)
+    histogram(analysis.wakeup, out)
+
+    print("\nContention:", file=out)
+    print(f"  {'object':<22}{'acquired':>10}{'blocked':>10}{'failed':>8}"
+          f"{'wait avg':>12}{'wait max':>12}{'hold avg':>12}{'hold max':>12}", file=out)
+    objects = sorted(analysis.objects.values(), key=lambda o: (-o.wait.total, o.kind, o.id))
+    for obj in objects:
+        if not (obj.acquired or obj.contended or obj.failed):
+            continue
+        hold = (f"{us(obj.hold.avg):>10.1f}us{us(obj.hold.max):>10.1f}us"
+                if obj.kind == "mutex" else f"{'-':>12}{'-':>12}")
+        print(f"  {obj.kind + ' 0x%08x' % obj.id:<22}{obj.acquired:>10}{obj.contended:>10}"
+              f"{obj.failed:>8}{us(obj.wait.avg):>10.1f}us{us(obj.wait.max):>10.1f}us{hold}",
+              file=out)
+
+    print("\nISR duration:", file=out)
+    histogram(analysis.isr, out)
+
+
+def analyze(metadata, streams, timeline=False):
+    analysis = TraceAnalysis(timeline)
+    for data in streams:
+        for ts, cpu, name, fields in metadata.events_read(data):
+            analysis.event(ts, name, fields, cpu)
+    analysis.finish()
+    return analysis
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-t", "--trace", required=True,
+            help="tracing data (directory with metadata and trace files)")
+    parser.add_argument("--timeline", action="store_true",
+            help="print the state changes of all threads")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(os.path.join(args.trace, "metadata"), encoding="utf-8") as f:
+        metadata = CtfMetadata(f.read())
+
+    streams = []
+    for name in sorted(os.listdir(args.trace)):
+        if name == "metadata" or name.startswith("."):
+            continue
+        with open(os.path.join(args.trace, name), "rb") as f:
+            streams.append(f.read())
+
+    if not streams:
+        sys.exit(f"No trace file in {args.trace}")
+
+    report(analyze(metadata, streams, args.timeline))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_flash.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/sys/crc.h>
+
+/* The flash log is a ring of erase sectors. Each sector starts with a
+ * header holding a sequence number, the sector with the highest sequence
+ * number is the one being written. Records are appended to it and never
+ * span sectors. When a record does not fit, the next sector (the oldest
+ * one) is erased and started with the next sequence number.
+ */
+
+#define LOG_PARTITION_ID DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_log_partition))
+
+#define MAX_ALIGN 16
+#define RECORD_HDR_SIZE sizeof(struct log_backend_flash_record_hdr)
+#define RECORD_BUF_SIZE ROUND_UP(RECORD_HDR_SIZE + CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE, MAX_ALIGN)
+#define SCAN_CHUNK 32
+
+BUILD_ASSERT(sizeof(struct log_backend_flash_sector_hdr) <= MAX_ALIGN * 2);
+
+struct flash_log {
+	const struct flash_area *fa;
+	size_t sector_size;
+	uint32_t sector_cnt;
+	/* Sector being written, its sequence number and write offset. */
+	uint32_t sector;
+	uint32_t seq;
+	size_t off;
+	uint8_t align;
+	uint8_t erased_val;
+	/* Partition mounted, or mounting failed for good. */
+	bool ready;
+	bool failed;
+	bool panic;
+	/* Length of the staged log data, true if it did not fit. */
+	size_t len;
+	bool overflow;
+	/* Messages dropped because they exceeded the record size. */
+	uint32_t dropped;
+};
+
+static struct flash_log flog;
+static uint8_t __aligned(4) record[RECORD_BUF_SIZE];
+static K_MUTEX_DEFINE(flog_lock);
+
+static int record_append(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (flog.overflow || (flog.len + length) > CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE) {
+		flog.overflow = true;
+	} else {
+		memcpy(&record[RECORD_HDR_SIZE + flog.len], data, length);
+		flog.len += length;
+	}
+
+	return length;
+}
+
+static uint8_t __aligned(4) output_buf[16];
+LOG_OUTPUT_DEFINE(log_output, record_append, output_buf, sizeof(output_buf));
+
+static inline size_t sector_hdr_size(void)
+{
+	return ROUND_UP(sizeof(struct log_backend_flash_sector_hdr), flog.align);
+}
+
+static inline off_t sector_off(uint32_t sector)
+{
+	return (off_t)sector * flog.sector_size;
+}
+
+static bool sector_hdr_valid(const struct log_backend_flash_sector_hdr *hdr)
+{
+	return (hdr->magic == LOG_BACKEND_FLASH_MAGIC) &&
+	       (hdr->version == LOG_BACKEND_FLASH_VERSION) &&
+	       (hdr->align == flog.align) &&
+	       (hdr->crc == crc32_ieee((const uint8_t *)hdr,
+				       offsetof(struct log_backend_flash_sector_hdr, crc)));
+}
+
+static int sector_start(uint32_t sector, uint32_t seq)
+{
+	uint8_t __aligned(4) buf[MAX_ALIGN * 2];
+	struct log_backend_flash_sector_hdr *hdr = (struct log_backend_flash_sector_hdr *)buf;
+	int err;
+
+	err = flash_area_erase(flog.fa, sector_off(sector), flog.sector_size);
+	if (err < 0) {
+		return err;
+	}
+
+	memset(buf, flog.erased_val, sizeof(buf));
+	hdr->magic = LOG_BACKEND_FLASH_MAGIC;
+	hdr->seq = seq;
+	hdr->version = LOG_BACKEND_FLASH_VERSION;
+	hdr->align = flog.align;
+	hdr->reserved = 0;
+	hdr->crc = crc32_ieee(buf, offsetof(struct log_backend_flash_sector_hdr, crc));
+
+	err = flash_area_write(flog.fa, sector_off(sector), buf, sector_hdr_size());
+	if (err < 0) {
+		return err;
+	}
+
+	flog.sector = sector;
+	flog.seq = seq;
+	flog.off = sector_hdr_size();
+
+	return 0;
+}
+
+static int sector_next(void)
+{
+	return sector_start((flog.sector + 1) % flog.sector_cnt, flog.seq + 1);
+}
+
+static bool range_erased(off_t off, size_t len)
+{
+	uint8_t buf[SCAN_CHUNK];
+
+	while (len > 0) {
+		size_t chunk = MIN(len, sizeof(buf));
+
+		if (flash_area_read(flog.fa, off, buf, chunk) < 0) {
+			return false;
+		}
+
+		for (size_t i = 0; i < chunk; i++) {
+			if (buf[i] != flog.erased_val) {
+				return false;
+			}
+		}
+
+		off += chunk;
+		len -= chunk;
+	}
+
+	return true;
+}
+
+/* Find the end of the written records in the current sector. A header
+ * which is not valid or garbage after the last record means that a write
+ * was interrupted, writing then continues in a fresh sector.
+ */
+static int tail_find(void)
+{
+	struct log_backend_flash_record_hdr hdr;
+	size_t off = sector_hdr_size();
+	off_t base = sector_off(flog.sector);
+
+	while ((off + RECORD_HDR_SIZE) <= flog.sector_size) {
+		size_t total;
+		int err;
+
+		err = flash_area_read(flog.fa, base + off, &hdr, sizeof(hdr));
+		if (err < 0) {
+			return err;
+		}
+
+		if (range_erased(base + off, sizeof(hdr))) {
+			if (range_erased(base + off, flog.sector_size - off)) {
+				flog.off = off;
+				return 0;
+			}
+			break;
+		}
+
+		total = ROUND_UP(RECORD_HDR_SIZE + hdr.len, flog.align);
+		if (((hdr.len ^ hdr.len_inv) != UINT16_MAX) || (hdr.len == 0U) ||
+		    ((off + total) > flog.sector_size)) {
+			break;
+		}
+
+		off += total;
+	}
+
+	return sector_next();
+}
+
+static int flash_log_mount(void)
+{
+	struct log_backend_flash_sector_hdr hdr;
+	bool found = false;
+
+	for (uint32_t i = 0; i < flog.sector_cnt; i++) {
+		int err = flash_area_read(flog.fa, sector_off(i), &hdr, sizeof(hdr));
+
+		if (err < 0) {
+			return err;
+		}
+
+		if (!sector_hdr_valid(&hdr)) {
+			continue;
+		}
+
+		if (!found || ((int32_t)(hdr.seq - flog.seq) > 0)) {
+			found = true;
+			flog.sector = i;
+			flog.seq = hdr.seq;
+		}
+	}
+
+	if (!found) {
+		return sector_start(0, 0);
+	}
+
+	return tail_find();
+}
+
+static int flash_log_open(void)
+{
+	const struct device *dev;
+	struct flash_pages_info info;
+	size_t align;
+	int err;
+
+	err = flash_area_open(LOG_PARTITION_ID, &flog.fa);
+	if (err < 0) {
+		return err;
+	}
+
+	dev = flash_area_get_device(flog.fa);
+	if (dev == NULL) {
+		return -ENODEV;
+	}
+
+	if (!device_is_ready(dev)) {
+		return -EAGAIN;
+	}
+
+	err = flash_get_page_info_by_offs(dev, flog.fa->fa_off, &info);
+	if (err < 0) {
+		return err;
+	}
+
+	align = flash_get_write_block_size(dev);
+	if ((align == 0U) || (align > MAX_ALIGN)) {
+		return -ENOTSUP;
+	}
+
+	flog.align = align;
+	flog.erased_val = flash_area_erased_val(flog.fa);
+	flog.sector_size = info.size;
+	flog.sector_cnt = flog.fa->fa_size / info.size;
+
+	/* At least one sector must hold data while the next one is erased and
+	 * the largest record must fit into a sector.
+	 */
+	if ((flog.sector_cnt < 2U) ||
+	    ((sector_hdr_size() + ROUND_UP(RECORD_HDR_SIZE + CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE,
+					   flog.align)) > flog.sector_size)) {
+		return -EINVAL;
+	}
+
+	return flash_log_mount();
+}
+
+/* The partition is mounted on first use as the flash driver may be
+ * initialized after the logging core.
+ */
+static bool flash_log_ready(void)
+{
+	if (!flog.ready && !flog.failed) {
+		int err = flash_log_open();
+
+		flog.ready = (err == 0);
+		flog.failed = (err < 0) && (err != -EAGAIN);
+	}
+
+	return flog.ready;
+}
+
+static void record_commit(void)
+{
+	struct log_backend_flash_record_hdr *hdr = (struct log_backend_flash_record_hdr *)record;
+	size_t total;
+	int err;
+
+	if (!flash_log_ready()) {
+		return;
+	}
+
+	if (flog.overflow) {
+		flog.dropped++;
+		return;
+	}
+
+	total = ROUND_UP(RECORD_HDR_SIZE + flog.len, flog.align);
+	memset(&record[RECORD_HDR_SIZE + flog.len], flog.erased_val,
+	       total - RECORD_HDR_SIZE - flog.len);
+	hdr->len = flog.len;
+	hdr->len_inv = ~flog.len;
+	hdr->crc = crc32_ieee(&record[RECORD_HDR_SIZE], flog.len);
+
+	if ((flog.off + total) > flog.sector_size) {
+		err = sector_next();
+		if (err < 0) {
+			flog.ready = false;
+			flog.failed = true;
+			return;
+		}
+	}
+
+	err = flash_area_write(flog.fa, sector_off(flog.sector) + flog.off, record, total);
+	if (err < 0) {
+		flog.ready = false;
+		flog.failed = true;
+		return;
+	}
+
+	flog.off += total;
+}
+
+static void record_start(void)
+{
+	flog.len = 0;
+	flog.overflow = false;
+}
+
+static void dropped_write(uint32_t cnt)
+{
+	record_start();
+	log_dict_output_dropped_process(&log_output, cnt);
+	record_commit();
+}
+
+static void flog_lock_take(void)
+{
+	if (!flog.panic) {
+		(void)k_mutex_lock(&flog_lock, K_FOREVER);
+	}
+}
+
+static void flog_lock_give(void)
+{
+	if (!flog.panic) {
+		(void)k_mutex_unlock(&flog_lock);
+	}
+}
+
+int log_backend_flash_erase(void)
+{
+	int err;
+
+	flog_lock_take();
+
+	if (!flash_log_ready()) {
+		err = -ENODEV;
+	} else {
+		err = flash_area_erase(flog.fa, 0, flog.sector_cnt * flog.sector_size);
+		if (err == 0) {
+			err = sector_start(0, 0);
+		}
+		flog.ready = (err == 0);
+		flog.failed = (err < 0);
+	}
+
+	flog_lock_give();
+
+	return err;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	flog_lock_take();
+
+	record_start();
+	log_dict_output_msg_process(&log_output, &msg->log, 0);
+	record_commit();
+
+	if (flog.dropped > 0U) {
+		uint32_t cnt = flog.dropped;
+
+		flog.dropped = 0;
+		dropped_write(cnt);
+	}
+
+	flog_lock_give();
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	flog_lock_take();
+	dropped_write(cnt);
+	flog_lock_give();
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+
+	/* Keep storing messages, they are the most valuable ones after a
+	 * reset. Locking is not possible anymore.
+	 */
+	flog.panic = true;
+}
+
+static void log_backend_flash_init(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+
+	/* Mount again on next use. */
+	flog_lock_take();
+	flog.ready = false;
+	flog.failed = false;
+	flog_lock_give();
+}
+
+static const struct log_backend_api log_backend_flash_api = {
+	.process = process,
+	.panic = panic,
+	.init = log_backend_flash_init,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(log_backend_flash, log_backend_flash_api,
+		   IS_ENABLED(CONFIG_LOG_BACKEND_FLASH_AUTOSTART));
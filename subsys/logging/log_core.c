@@ -134,6 +134,29 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, the other CPUs use their own buffer. Buffers are
+ * registered like link buffers so that messages are merged by timestamp.
+ */
+#define CPU_LOG_BUFFERS UTIL_DEC(CONFIG_MP_MAX_NUM_CPUS)
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[CPU_LOG_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+
+#define CPU_LOG_BUFFER_DEFINE(i, _) \
+	static STRUCT_SECTION_ITERABLE(log_msg_ptr, cpu_##i##_log_msg_ptr); \
+	static STRUCT_SECTION_ITERABLE(log_mpsc_pbuf, cpu_##i##_log_mpsc_pbuf)
+
+#define CPU_LOG_BUFFER_PTR(i, _) &cpu_##i##_log_mpsc_pbuf.buf
+
+LISTIFY(CPU_LOG_BUFFERS, CPU_LOG_BUFFER_DEFINE, (;));
+
+static struct mpsc_pbuf_buffer *const cpu_log_buffer[CONFIG_MP_MAX_NUM_CPUS] = {
+	&log_buffer,
+	LISTIFY(CPU_LOG_BUFFERS, CPU_LOG_BUFFER_PTR, (,))
+};
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -143,6 +166,10 @@ static char tag[CONFIG_LOG_TAG_MAX_LEN + 1] =
 	COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, ({}), (CONFIG_LOG_TAG_DEFAULT));
 
 static void msg_process(union log_msg_generic *msg);
+static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generic *msg);
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+static void par_flush(void);
+#endif
 
 static log_timestamp_t dummy_timestamp(void)
 {
@@ -414,6 +441,10 @@ void z_impl_log_panic(void)
 		}
 	}
 
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+	par_flush();
+#endif
+
 	if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
 		/* Flush */
 		while (log_process() == true) {
@@ -477,14 +508,218 @@ static void msg_process(union log_msg_generic *msg)
 	}
 }
 
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+#define PAR_THREADS CONFIG_LOG_PROCESS_PARALLEL_BACKENDS
+#define PAR_QUEUE_SIZE CONFIG_LOG_PROCESS_PARALLEL_QUEUE_SIZE
+/* Backend threads preempt the dispatching thread, so a backend which keeps
+ * up processes each message as soon as it is queued.
+ */
+#define PAR_THREAD_PRIORITY MAX(LOG_PROCESS_THREAD_PRIORITY - 1, K_HIGHEST_THREAD_PRIO)
+
+/* Copy of a message shared by the backend threads, freed by the last one.
+ * The message itself is freed from the log buffer once dispatched, so the
+ * buffer releases messages in the order they were claimed, as the locked
+ * packet buffer requires, however long the backends hold the copies.
+ */
+struct par_msg {
+	atomic_t ref;
+	union log_msg_generic msg __aligned(Z_LOG_MSG_ALIGNMENT);
+};
+
+/* Processing context of a backend. A NULL entry in the queue only
+ * requests reporting of dropped messages.
+ */
+struct par_ctx {
+	const struct log_backend *backend;
+	struct k_msgq queue;
+	struct par_msg *queue_buf[PAR_QUEUE_SIZE];
+	atomic_t dropped;
+	struct k_thread thread;
+};
+
+static K_HEAP_DEFINE(par_heap, CONFIG_LOG_PROCESS_PARALLEL_BUFFER_SIZE);
+static struct par_ctx par_ctxs[PAR_THREADS];
+static uint32_t par_ctx_cnt;
+static bool par_sync;
+static K_KERNEL_STACK_ARRAY_DEFINE(par_stacks, PAR_THREADS,
+				   CONFIG_LOG_PROCESS_PARALLEL_STACK_SIZE);
+
+static struct par_msg *par_msg_get(union log_msg_generic *msg)
+{
+	size_t len = log_msg_generic_get_wlen(&msg->buf) * sizeof(uint32_t);
+	struct par_msg *pmsg;
+
+	pmsg = k_heap_aligned_alloc(&par_heap, Z_LOG_MSG_ALIGNMENT,
+				    offsetof(struct par_msg, msg) + len, K_NO_WAIT);
+	if (pmsg != NULL) {
+		atomic_set(&pmsg->ref, 1);
+		memcpy(&pmsg->msg, msg, len);
+	}
+
+	return pmsg;
+}
+
+static void par_msg_put(struct par_msg *pmsg)
+{
+	if ((pmsg != NULL) && (atomic_dec(&pmsg->ref) == 1)) {
+		k_heap_free(&par_heap, pmsg);
+	}
+}
+
+static void par_ctx_process(struct par_ctx *ctx, struct par_msg *pmsg)
+{
+	uint32_t dropped = atomic_set(&ctx->dropped, 0);
+
+	if (dropped && log_backend_is_active(ctx->backend)) {
+		log_backend_dropped(ctx->backend, dropped);
+	}
+
+	if (pmsg != NULL) {
+		if (log_backend_is_active(ctx->backend)) {
+			log_backend_msg_process(ctx->backend, &pmsg->msg);
+		}
+		par_msg_put(pmsg);
+	}
+}
+
+static void par_thread_func(void *p1, void *p2, void *p3)
+{
+	struct par_ctx *ctx = p1;
+	struct par_msg *pmsg;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&ctx->queue, &pmsg, K_FOREVER);
+		par_ctx_process(ctx, pmsg);
+
+		if (k_msgq_num_used_get(&ctx->queue) == 0) {
+			log_backend_notify(ctx->backend, LOG_BACKEND_EVT_PROCESS_THREAD_DONE, NULL);
+		}
+	}
+}
+
+static struct par_ctx *par_ctx_find(const struct log_backend *backend)
+{
+	for (uint32_t i = 0; i < par_ctx_cnt; i++) {
+		if (par_ctxs[i].backend == backend) {
+			return &par_ctxs[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Get the processing context of a backend, creating it on first use. NULL
+ * means that the backend is processed by the calling thread.
+ */
+static struct par_ctx *par_ctx_get(const struct log_backend *backend)
+{
+	struct par_ctx *ctx;
+
+	if (par_sync) {
+		return NULL;
+	}
+
+	ctx = par_ctx_find(backend);
+	if ((ctx != NULL) || (par_ctx_cnt == PAR_THREADS)) {
+		return ctx;
+	}
+
+	ctx = &par_ctxs[par_ctx_cnt];
+	ctx->backend = backend;
+	k_msgq_init(&ctx->queue, (char *)ctx->queue_buf, sizeof(ctx->queue_buf[0]),
+		    PAR_QUEUE_SIZE);
+	k_thread_create(&ctx->thread, par_stacks[par_ctx_cnt],
+			K_KERNEL_STACK_SIZEOF(par_stacks[par_ctx_cnt]),
+			par_thread_func, ctx, NULL, NULL,
+			PAR_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&ctx->thread, backend->name);
+	par_ctx_cnt++;
+
+	return ctx;
+}
+
+static void msg_dispatch(union log_msg_generic *msg, struct mpsc_pbuf_buffer *buffer)
+{
+	struct par_msg *pmsg = NULL;
+	bool copied = false;
+
+	STRUCT_SECTION_FOREACH(log_backend, backend) {
+		struct par_ctx *ctx;
+
+		if (!log_backend_is_active(backend) || !msg_filter_check(backend, msg)) {
+			continue;
+		}
+
+		ctx = par_ctx_get(backend);
+		if (ctx == NULL) {
+			log_backend_msg_process(backend, msg);
+			continue;
+		}
+
+		if (!copied) {
+			pmsg = par_msg_get(msg);
+			copied = true;
+		}
+
+		if (pmsg == NULL) {
+			atomic_inc(&ctx->dropped);
+			continue;
+		}
+
+		atomic_inc(&pmsg->ref);
+		if (k_msgq_put(&ctx->queue, &pmsg, K_NO_WAIT) != 0) {
+			atomic_dec(&pmsg->ref);
+			atomic_inc(&ctx->dropped);
+		}
+	}
+
+	par_msg_put(pmsg);
+	msg_free(buffer, msg);
+}
+
+/* Process the queued messages on the calling thread and stop using the
+ * backend threads.
+ */
+static void par_flush(void)
+{
+	struct par_msg *pmsg;
+
+	par_sync = true;
+
+	for (uint32_t i = 0; i < par_ctx_cnt; i++) {
+		while (k_msgq_get(&par_ctxs[i].queue, &pmsg, K_NO_WAIT) == 0) {
+			par_ctx_process(&par_ctxs[i], pmsg);
+		}
+		par_ctx_process(&par_ctxs[i], NULL);
+	}
+}
+#endif /* CONFIG_LOG_PROCESS_PARALLEL */
+
 void dropped_notify(void)
 {
 	uint32_t dropped = z_log_dropped_read_and_clear();
 
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
-		if (log_backend_is_active(backend)) {
-			log_backend_dropped(backend, dropped);
+		if (!log_backend_is_active(backend)) {
+			continue;
+		}
+
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+		struct par_ctx *ctx = par_ctx_get(backend);
+
+		if (ctx != NULL) {
+			struct par_msg *report = NULL;
+
+			/* Report from the backend thread. */
+			atomic_add(&ctx->dropped, dropped);
+			(void)k_msgq_put(&ctx->queue, &report, K_NO_WAIT);
+			continue;
 		}
+#endif
+		log_backend_dropped(backend, dropped);
 	}
 }
 
@@ -529,8 +764,12 @@ bool z_impl_log_process(void)
 
 	if (msg) {
 		atomic_dec(&buffered_cnt);
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+		msg_dispatch(msg, curr_log_buffer);
+#else
 		msg_process(msg);
 		z_log_msg_free(msg);
+#endif
 	} else if (CONFIG_LOG_PROCESSING_LATENCY_US > 0 && !K_TIMEOUT_EQ(backoff, K_NO_WAIT)) {
 		/* If backoff is requested, it means that there are pending
 		 * messages but they are too new and processing shall back off
@@ -607,6 +846,41 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < CPU_LOG_BUFFERS; i++) {
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(cpu_log_buffer[i + 1], &config);
+	}
+#endif
+}
+
+/* Buffer of the CPU the caller runs on. The thread may migrate afterwards,
+ * which is fine as buffers accept messages from any CPU.
+ */
+static struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return cpu_log_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer;
+#endif
+}
+
+/* Buffer from which the message was allocated. */
+static struct mpsc_pbuf_buffer *msg_buffer(struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)cpu_buf32;
+
+	if (offset < sizeof(cpu_buf32)) {
+		return cpu_log_buffer[1 + offset / sizeof(cpu_buf32[0])];
+	}
+#endif
+	ARG_UNUSED(msg);
+
+	return &log_buffer;
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -624,7 +898,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -646,7 +920,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -659,7 +933,9 @@ union log_msg_generic *z_log_msg_local_claim(void)
 
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* If there are buffers dedicated for each link or CPU, claim the oldest message
+ * (lowest timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
@@ -733,7 +1009,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -768,7 +1045,8 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -850,6 +1128,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 1; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(cpu_log_buffer[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
+#endif
+
 	return 0;
 }
 
@@ -861,13 +1149,38 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	uint32_t cpu_max;
+	int err;
+
+	*max = 0;
+
+	/* Sum of the peaks of each buffer, which may not have happened at once */
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		err = mpsc_pbuf_get_max_utilization(cpu_log_buffer[i], &cpu_max);
+		if (err < 0) {
+			return err;
+		}
+
+		*max += cpu_max;
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
 				   union log_backend_evt_arg *arg)
 {
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
+#ifdef CONFIG_LOG_PROCESS_PARALLEL
+		/* Backend threads notify on their own. */
+		if (par_ctx_find(backend) != NULL) {
+			continue;
+		}
+#endif
 		log_backend_notify(backend, event, arg);
 	}
 }
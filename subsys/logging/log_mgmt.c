@@ -357,8 +357,199 @@ void z_log_runtime_filters_init(void)
 		LOG_FILTER_SLOT_SET(filters,
 				    LOG_FILTER_AGGR_SLOT_IDX,
 				    level);
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+		struct log_rate_limit *rl = &TYPE_SECTION_START(log_dynamic)[i].rate_limit;
+
+		rl->rate = CONFIG_LOG_RATE_LIMIT_DEFAULT_RATE;
+		rl->burst = CONFIG_LOG_RATE_LIMIT_DEFAULT_BURST;
+		rl->tokens = CONFIG_LOG_RATE_LIMIT_DEFAULT_BURST;
+#endif
+	}
+}
+
+#ifdef CONFIG_LOG_RATE_LIMIT
+#define REPEAT_WINDOW_TICKS k_ms_to_ticks_ceil32(CONFIG_LOG_RATE_LIMIT_REPEAT_WINDOW_MS)
+
+static struct k_spinlock rate_lock;
+
+#if CONFIG_LOG_RATE_LIMIT_SITES > 0
+struct site_bucket {
+	uint32_t site;
+	uint32_t stamp;
+	uint8_t tokens;
+};
+
+static struct site_bucket site_buckets[CONFIG_LOG_RATE_LIMIT_SITES];
+
+/* Number of consecutive slots in which a call site can be placed. */
+#define SITE_WAYS MIN(4, CONFIG_LOG_RATE_LIMIT_SITES)
+#endif
+
+/* Add tokens accumulated since the last refill. The stamp only advances by
+ * the time the added tokens took, so fractions are not lost.
+ */
+static uint8_t bucket_refill(uint32_t *stamp, uint8_t tokens, uint16_t rate,
+			     uint8_t burst, uint32_t now)
+{
+	uint64_t add = ((uint64_t)(now - *stamp) * rate) / CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+
+	if (add >= (uint64_t)(burst - tokens)) {
+		*stamp = now;
+		return burst;
+	}
+
+	*stamp += (uint32_t)((add * CONFIG_SYS_CLOCK_TICKS_PER_SEC) / rate);
+
+	return tokens + add;
+}
+
+#if CONFIG_LOG_RATE_LIMIT_SITES > 0
+/* Find the bucket of a call site. Fibonacci hashing of the format string
+ * address spreads adjacent strings over the table. A call site which is not
+ * found takes over a slot that is free or has a full bucket, which is the
+ * same as a fresh one. When all the slots are in use the call site shares
+ * the bucket of the first one, so colliding call sites never reset each
+ * other's limit.
+ */
+static struct site_bucket *site_bucket_get(uint32_t site, uint32_t now)
+{
+	uint32_t idx = ((uint64_t)(site * 0x9e3779b1U) * CONFIG_LOG_RATE_LIMIT_SITES) >> 32;
+	struct site_bucket *spare = NULL;
+
+	for (int i = 0; i < SITE_WAYS; i++) {
+		struct site_bucket *sb = &site_buckets[(idx + i) % CONFIG_LOG_RATE_LIMIT_SITES];
+
+		if (sb->site == 0) {
+			sb->stamp = now;
+			sb->tokens = CONFIG_LOG_RATE_LIMIT_SITE_BURST;
+		} else {
+			sb->tokens = bucket_refill(&sb->stamp, sb->tokens,
+						   CONFIG_LOG_RATE_LIMIT_SITE_RATE,
+						   CONFIG_LOG_RATE_LIMIT_SITE_BURST, now);
+		}
+
+		if (sb->site == site) {
+			return sb;
+		}
+
+		if ((spare == NULL) && (sb->tokens == CONFIG_LOG_RATE_LIMIT_SITE_BURST)) {
+			spare = sb;
+		}
+	}
+
+	if (spare == NULL) {
+		return &site_buckets[idx];
+	}
+
+	spare->site = site;
+
+	return spare;
+}
+#endif
+
+static inline uint16_t sat_inc(uint16_t val)
+{
+	return (val < UINT16_MAX) ? (val + 1) : val;
+}
+
+bool z_log_rate_limit_check(struct log_source_dynamic_data *source,
+			    const char *fmt, uint8_t level)
+{
+	struct log_rate_limit *rl = &source->rate_limit;
+	uint32_t site = (uint32_t)(uintptr_t)fmt;
+	uint32_t now = sys_clock_tick_get_32();
+	uint16_t suppressed = 0;
+	uint16_t repeated = 0;
+	bool pass = true;
+	k_spinlock_key_t key;
+
+	if ((CONFIG_LOG_RATE_LIMIT_SITES == 0) && (CONFIG_LOG_RATE_LIMIT_REPEAT_WINDOW_MS == 0) &&
+	    (rl->rate == 0) && (rl->suppressed == 0)) {
+		return true;
 	}
+
+	key = k_spin_lock(&rate_lock);
+
+	/* A run of messages from one call site is suppressed for the repeat
+	 * window, counted from the first message of the run.
+	 */
+	if ((CONFIG_LOG_RATE_LIMIT_REPEAT_WINDOW_MS > 0) && (rl->site == site) &&
+	    ((now - rl->site_stamp) < REPEAT_WINDOW_TICKS)) {
+		rl->repeated = sat_inc(rl->repeated);
+		k_spin_unlock(&rate_lock, key);
+
+		return false;
+	}
+
+	rl->site = site;
+	rl->site_stamp = now;
+
+	if (rl->rate > 0) {
+		rl->tokens = bucket_refill(&rl->stamp, rl->tokens, rl->rate, rl->burst, now);
+		pass = (rl->tokens > 0);
+	}
+
+#if CONFIG_LOG_RATE_LIMIT_SITES > 0
+	struct site_bucket *sb = site_bucket_get(site, now);
+
+	pass = pass && (sb->tokens > 0);
+	if (pass) {
+		sb->tokens--;
+	}
+#endif
+
+	if (pass) {
+		if (rl->rate > 0) {
+			rl->tokens--;
+		}
+		suppressed = rl->suppressed;
+		repeated = rl->repeated;
+		rl->suppressed = 0;
+		rl->repeated = 0;
+	} else {
+		rl->suppressed = sat_inc(rl->suppressed);
+	}
+
+	k_spin_unlock(&rate_lock, key);
+
+	/* Reports use the level of the passing message so that they are not
+	 * filtered out.
+	 */
+	if (repeated > 0) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, source, level, NULL, 0, 0,
+					 "last message repeated %u times", repeated);
+	}
+
+	if (suppressed > 0) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, source, level, NULL, 0, 0,
+					 "%u messages suppressed", suppressed);
+	}
+
+	return pass;
+}
+
+int log_rate_limit_set(uint32_t domain_id, int16_t source_id, uint16_t rate, uint8_t burst)
+{
+	struct log_rate_limit *rl;
+	k_spinlock_key_t key;
+
+	if (!z_log_is_local_domain(domain_id) || (source_id < 0) ||
+	    (source_id >= z_log_sources_count()) || (burst == 0U)) {
+		return -EINVAL;
+	}
+
+	rl = &TYPE_SECTION_START(log_dynamic)[source_id].rate_limit;
+	key = k_spin_lock(&rate_lock);
+	rl->rate = rate;
+	rl->burst = burst;
+	rl->tokens = burst;
+	rl->stamp = sys_clock_tick_get_32();
+	k_spin_unlock(&rate_lock, key);
+
+	return 0;
 }
+#endif /* CONFIG_LOG_RATE_LIMIT */
 
 int log_source_id_get(const char *name)
 {
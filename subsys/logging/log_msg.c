@@ -304,9 +304,22 @@ static inline void z_vrfy_z_log_msg_static_create(const void *source,
 #include <syscalls/z_log_msg_static_create_mrsh.c>
 #endif
 
-void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
-				uint8_t level, const void *data, size_t dlen,
-				uint32_t package_flags, const char *fmt, va_list ap)
+static int package_create(void *pkg, size_t len, uint32_t flags,
+			  const uint8_t *arg_desc, const char *fmt, va_list ap)
+{
+#ifdef CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+	return cbvprintf_package_desc(pkg, len, flags, arg_desc, fmt, ap);
+#else
+	ARG_UNUSED(arg_desc);
+
+	return cbvprintf_package(pkg, len, flags, fmt, ap);
+#endif
+}
+
+void z_log_msg_runtime_desc_vcreate(uint8_t domain_id, const void *source,
+				     uint8_t level, const void *data, size_t dlen,
+				     uint32_t package_flags, const uint8_t *arg_desc,
+				     const char *fmt, va_list ap)
 {
 	int plen;
 
@@ -314,8 +327,8 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		va_list ap2;
 
 		va_copy(ap2, ap);
-		plen = cbvprintf_package(NULL, Z_LOG_MSG_ALIGN_OFFSET,
-					 package_flags, fmt, ap2);
+		plen = package_create(NULL, Z_LOG_MSG_ALIGN_OFFSET,
+				      package_flags, arg_desc, fmt, ap2);
 		__ASSERT_NO_MSG(plen >= 0);
 		va_end(ap2);
 	} else {
@@ -341,7 +354,7 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	}
 
 	if (pkg && fmt) {
-		plen = cbvprintf_package(pkg, (size_t)plen, package_flags, fmt, ap);
+		plen = package_create(pkg, (size_t)plen, package_flags, arg_desc, fmt, ap);
 		__ASSERT_NO_MSG(plen >= 0);
 	}
 
@@ -353,3 +366,11 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		z_log_msg_finalize(msg, source, desc, data);
 	}
 }
+
+void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
+				uint8_t level, const void *data, size_t dlen,
+				uint32_t package_flags, const char *fmt, va_list ap)
+{
+	z_log_msg_runtime_desc_vcreate(domain_id, source, level, data, dlen,
+				       package_flags, NULL, fmt, ap);
+}
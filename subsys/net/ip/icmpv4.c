@@ -44,6 +44,9 @@ int net_icmpv4_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_code)
 	icmp_hdr->code   = icmp_code;
 	icmp_hdr->chksum = 0U;
 
+	/* A new message, whatever checksum the packet had no longer applies */
+	net_pkt_set_chksum_done(pkt, false);
+
 	return net_pkt_set_data(pkt, &icmpv4_access);
 }
 
@@ -64,6 +67,13 @@ int net_icmpv4_finalize(struct net_pkt *pkt, bool force_chksum)
 		return -ENOBUFS;
 	}
 
+	/* Only the echo reply path sets the flag ahead of finalizing, once
+	 * the reply is complete. Creating a message clears it again.
+	 */
+	if (net_pkt_is_chksum_done(pkt) && !force_chksum) {
+		return net_pkt_set_data(pkt, &icmpv4_access);
+	}
+
 	icmp_hdr->chksum = 0U;
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
 		icmp_hdr->chksum = net_calc_chksum_icmpv4(pkt);
@@ -410,6 +420,43 @@ static int icmpv4_handle_header_options(struct net_pkt *pkt,
 }
 #endif
 
+/* The echo reply carries the same data as the request, so update the
+ * checksum of the request instead of summing the whole payload again.
+ */
+static int icmpv4_echo_reply_chksum(struct net_pkt *reply,
+				    struct net_icmp_hdr *icmp_hdr)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmpv4_access,
+					      struct net_icmp_hdr);
+	struct net_icmp_hdr *reply_hdr;
+
+	if (!net_if_need_calc_tx_checksum(net_pkt_iface(reply))) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(reply);
+	net_pkt_set_overwrite(reply, true);
+
+	if (net_pkt_skip(reply, net_pkt_ip_hdr_len(reply) +
+			 net_pkt_ipv4_opts_len(reply))) {
+		return -ENOBUFS;
+	}
+
+	reply_hdr = (struct net_icmp_hdr *)net_pkt_get_data(reply,
+							    &icmpv4_access);
+	if (!reply_hdr) {
+		return -ENOBUFS;
+	}
+
+	reply_hdr->chksum = net_chksum_update_16(
+		icmp_hdr->chksum,
+		htons((icmp_hdr->type << 8) | icmp_hdr->code),
+		htons((reply_hdr->type << 8) | reply_hdr->code));
+	net_pkt_set_chksum_done(reply, true);
+
+	return net_pkt_set_data(reply, &icmpv4_access);
+}
+
 static int icmpv4_handle_echo_request(struct net_icmp_ctx *ctx,
 				      struct net_pkt *pkt,
 				      struct net_icmp_ip_hdr *hdr,
@@ -480,7 +527,8 @@ static int icmpv4_handle_echo_request(struct net_icmp_ctx *ctx,
 	}
 
 	if (net_icmpv4_create(reply, NET_ICMPV4_ECHO_REPLY, 0) ||
-	    net_pkt_copy(reply, pkt, payload_len)) {
+	    net_pkt_copy(reply, pkt, payload_len) ||
+	    icmpv4_echo_reply_chksum(reply, icmp_hdr)) {
 		goto drop;
 	}
 
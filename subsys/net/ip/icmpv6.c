@@ -68,6 +68,13 @@ int net_icmpv6_finalize(struct net_pkt *pkt, bool force_chksum)
 		return -ENOBUFS;
 	}
 
+	/* Only the echo reply path sets the flag ahead of finalizing, once
+	 * the reply is complete. Creating a message clears it again.
+	 */
+	if (net_pkt_is_chksum_done(pkt) && !force_chksum) {
+		return net_pkt_set_data(pkt, &icmp_access);
+	}
+
 	icmp_hdr->chksum = 0U;
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
 		icmp_hdr->chksum = net_calc_chksum_icmpv6(pkt);
@@ -92,9 +99,61 @@ int net_icmpv6_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_code)
 	icmp_hdr->code   = icmp_code;
 	icmp_hdr->chksum = 0U;
 
+	/* A new message, whatever checksum the packet had no longer applies */
+	net_pkt_set_chksum_done(pkt, false);
+
 	return net_pkt_set_data(pkt, &icmp_access);
 }
 
+/* The echo reply carries the same data as the request, so update the
+ * checksum of the request instead of summing the whole payload again.
+ * Swapping the addresses does not change the pseudo header sum, only a
+ * different source address does.
+ */
+static int icmpv6_echo_reply_chksum(struct net_pkt *reply,
+				    struct net_icmp_hdr *icmp_hdr,
+				    const struct in6_addr *old_dst,
+				    const struct in6_addr *src)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmp_access,
+					      struct net_icmp_hdr);
+	struct net_icmp_hdr *reply_hdr;
+	uint16_t chksum;
+
+	if (!net_if_need_calc_tx_checksum(net_pkt_iface(reply))) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(reply);
+	net_pkt_set_overwrite(reply, true);
+
+	if (net_pkt_skip(reply, net_pkt_ip_hdr_len(reply) +
+			 net_pkt_ipv6_ext_len(reply))) {
+		return -ENOBUFS;
+	}
+
+	reply_hdr = (struct net_icmp_hdr *)net_pkt_get_data(reply,
+							    &icmp_access);
+	if (!reply_hdr) {
+		return -ENOBUFS;
+	}
+
+	chksum = net_chksum_update_16(
+		icmp_hdr->chksum,
+		htons((icmp_hdr->type << 8) | icmp_hdr->code),
+		htons((reply_hdr->type << 8) | reply_hdr->code));
+
+	if (!net_ipv6_addr_cmp(old_dst, src)) {
+		chksum = net_chksum_update(chksum, old_dst, src,
+					   sizeof(struct in6_addr));
+	}
+
+	reply_hdr->chksum = chksum;
+	net_pkt_set_chksum_done(reply, true);
+
+	return net_pkt_set_data(reply, &icmp_access);
+}
+
 static int icmpv6_handle_echo_request(struct net_icmp_ctx *ctx,
 				      struct net_pkt *pkt,
 				      struct net_icmp_ip_hdr *hdr,
@@ -107,7 +166,6 @@ static int icmpv6_handle_echo_request(struct net_icmp_ctx *ctx,
 	int16_t payload_len;
 
 	ARG_UNUSED(user_data);
-	ARG_UNUSED(icmp_hdr);
 
 	NET_DBG("Received Echo Request from %s to %s",
 		net_sprint_ipv6_addr(&ip_hdr->src),
@@ -156,7 +214,9 @@ static int icmpv6_handle_echo_request(struct net_icmp_ctx *ctx,
 	}
 
 	if (net_icmpv6_create(reply, NET_ICMPV6_ECHO_REPLY, 0) ||
-	    net_pkt_copy(reply, pkt, payload_len)) {
+	    net_pkt_copy(reply, pkt, payload_len) ||
+	    icmpv6_echo_reply_chksum(reply, icmp_hdr,
+				     (struct in6_addr *)ip_hdr->dst, src)) {
 		NET_DBG("DROP: wrong buffer");
 		goto drop;
 	}
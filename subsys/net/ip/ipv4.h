@@ -323,15 +323,24 @@ struct net_ipv4_reassembly {
 	/** IPv4 destination address of the fragment */
 	struct in_addr dst;
 
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
+	/** Timeout for cancelling the reassembly. */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
 
+	/** Hash bucket or free list node, the slot is in use when hashed */
+	sys_snode_t node;
+
+	/** Number of payload bytes received so far */
+	uint32_t received;
+
+	/**
+	 * Payload length of the whole packet, UINT32_MAX until the last
+	 * fragment is received.
+	 */
+	uint32_t total_len;
+
 	/** IPv4 fragment identification */
 	uint16_t id;
 	uint8_t protocol;
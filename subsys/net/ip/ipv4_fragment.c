@@ -29,85 +29,113 @@ LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 
 static void reassembly_timeout(struct k_work *work);
 
+/* Reassembly slots are looked up through a hash table keyed by the source
+ * and destination address, the identification and the protocol. The unused
+ * slots are kept in a free list.
+ */
+#define REASSEMBLY_BUCKETS NHPOT(CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT)
+
 static struct net_ipv4_reassembly reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+static sys_slist_t reassembly_hash[REASSEMBLY_BUCKETS];
+static sys_slist_t reassembly_free;
+static uint32_t reassembly_seed;
+static K_MUTEX_DEFINE(reassembly_lock);
 
-static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *src,
-						  struct in_addr *dst, uint8_t protocol)
+static uint32_t reassembly_bucket(uint16_t id, const struct in_addr *src,
+				  const struct in_addr *dst, uint8_t protocol)
 {
-	int i, avail = -1;
-
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
-		    reassembly[i].id == id &&
-		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
-		    net_ipv4_addr_cmp(dst, &reassembly[i].dst) &&
-		    reassembly[i].protocol == protocol) {
-			return &reassembly[i];
-		}
+	uint32_t hash = reassembly_seed;
 
-		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
+	hash = (hash ^ sys_get_be32(src->s4_addr)) * 0x9e3779b1U;
+	hash = (hash ^ sys_get_be32(dst->s4_addr)) * 0x9e3779b1U;
+	hash = (hash ^ ((uint32_t)id << 8 | protocol)) * 0x9e3779b1U;
+
+	return (hash >> 16) & (REASSEMBLY_BUCKETS - 1);
+}
+
+static sys_slist_t *reassembly_list(struct net_ipv4_reassembly *reass)
+{
+	return &reassembly_hash[reassembly_bucket(reass->id, &reass->src, &reass->dst,
+						  reass->protocol)];
+}
+
+static bool reassembly_in_use(struct net_ipv4_reassembly *reass)
+{
+	struct net_ipv4_reassembly *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(reassembly_list(reass), entry, node) {
+		if (entry == reass) {
+			return true;
 		}
+	}
 
-		if (avail < 0) {
-			avail = i;
+	return false;
+}
+
+static struct net_ipv4_reassembly *reassembly_get(uint16_t id, struct in_addr *src,
+						  struct in_addr *dst, uint8_t protocol)
+{
+	sys_slist_t *list = &reassembly_hash[reassembly_bucket(id, src, dst, protocol)];
+	struct net_ipv4_reassembly *reass;
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, reass, node) {
+		if (reass->id == id &&
+		    net_ipv4_addr_cmp(src, &reass->src) &&
+		    net_ipv4_addr_cmp(dst, &reass->dst) &&
+		    reass->protocol == protocol) {
+			return reass;
 		}
 	}
 
-	if (avail < 0) {
+	node = sys_slist_get(&reassembly_free);
+	if (!node) {
 		return NULL;
 	}
 
-	k_work_reschedule(&reassembly[avail].timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+	reass = CONTAINER_OF(node, struct net_ipv4_reassembly, node);
+
+	k_work_reschedule(&reass->timer, K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT));
+
+	net_ipaddr_copy(&reass->src, src);
+	net_ipaddr_copy(&reass->dst, dst);
 
-	net_ipaddr_copy(&reassembly[avail].src, src);
-	net_ipaddr_copy(&reassembly[avail].dst, dst);
+	reass->protocol = protocol;
+	reass->id = id;
+	reass->received = 0U;
+	reass->total_len = UINT32_MAX;
 
-	reassembly[avail].protocol = protocol;
-	reassembly[avail].id = id;
+	sys_slist_prepend(list, &reass->node);
 
-	return &reassembly[avail];
+	return reass;
 }
 
-static bool reassembly_cancel(uint32_t id, struct in_addr *src, struct in_addr *dst)
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
 {
-	int i, j;
+	int32_t remaining;
+	int j;
 
-	LOG_DBG("Cancel 0x%x", id);
+	LOG_DBG("Cancel 0x%x", reass->id);
 
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		int32_t remaining;
+	remaining = k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer));
+	k_work_cancel_delayable(&reass->timer);
+
+	LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reass->id, remaining);
 
-		if (reassembly[i].id != id ||
-		    !net_ipv4_addr_cmp(src, &reassembly[i].src) ||
-		    !net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+	for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
+		if (!reass->pkt[j]) {
 			continue;
 		}
 
-		remaining = k_ticks_to_ms_ceil32(
-			k_work_delayable_remaining_get(&reassembly[i].timer));
-		k_work_cancel_delayable(&reassembly[i].timer);
-
-		LOG_DBG("IPv4 reassembly id 0x%x remaining %d ms", reassembly[i].id, remaining);
+		LOG_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data", j, reass->pkt[j],
+			net_pkt_get_len(reass->pkt[j]));
 
-		reassembly[i].id = 0U;
-
-		for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
-			if (!reassembly[i].pkt[j]) {
-				continue;
-			}
-
-			LOG_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data", j,
-				reassembly[i].pkt[j], net_pkt_get_len(reassembly[i].pkt[j]));
-
-			net_pkt_unref(reassembly[i].pkt[j]);
-			reassembly[i].pkt[j] = NULL;
-		}
-
-		return true;
+		net_pkt_unref(reass->pkt[j]);
+		reass->pkt[j] = NULL;
 	}
 
-	return false;
+	sys_slist_find_and_remove(reassembly_list(reass), &reass->node);
+	sys_slist_prepend(&reassembly_free, &reass->node);
 }
 
 static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
@@ -125,6 +153,16 @@ static void reassembly_timeout(struct k_work *work)
 	struct net_ipv4_reassembly *reass =
 		CONTAINER_OF(dwork, struct net_ipv4_reassembly, timer);
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The slot might have been released, or even reused, while we were
+	 * waiting for the lock.
+	 */
+	if (k_work_delayable_remaining_get(&reass->timer) ||
+	    !reassembly_in_use(reass)) {
+		goto out;
+	}
+
 	reassembly_info("Reassembly cancelled", reass);
 
 	/* Send a ICMPv4 Time Exceeded only if we received the first fragment */
@@ -133,9 +171,15 @@ static void reassembly_timeout(struct k_work *work)
 				      NET_ICMPV4_TIME_EXCEEDED_FRAGMENT_REASSEMBLY_TIME);
 	}
 
-	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+	reassembly_cancel(reass);
+
+out:
+	k_mutex_unlock(&reassembly_lock);
 }
 
+/* The fragments are chained together without copying their data: the
+ * buffers of every fragment are appended to the buffers of the first one.
+ */
 static void reassemble_packet(struct net_ipv4_reassembly *reass)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
@@ -160,17 +204,12 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		net_pkt_cursor_init(pkt);
 
 		/* Get rid of IPv4 header which is at the beginning of the fragment. */
-		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
-		if (!ipv4_hdr) {
-			goto error;
-		}
-
 		LOG_DBG("Removing %d bytes from start of pkt %p", net_pkt_ip_hdr_len(pkt),
 			pkt->buffer);
 
 		if (net_pkt_pull(pkt, net_pkt_ip_hdr_len(pkt))) {
 			LOG_ERR("Failed to pull headers");
-			reassembly_cancel(reass->id, &reass->src, &reass->dst);
+			reassembly_cancel(reass);
 			return;
 		}
 
@@ -187,6 +226,9 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 	pkt = reass->pkt[0];
 	reass->pkt[0] = NULL;
 
+	/* The slot is not needed anymore */
+	reassembly_cancel(reass);
+
 	/* Update the header details for the packet */
 	net_pkt_cursor_init(pkt);
 
@@ -223,118 +265,126 @@ error:
 
 void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
 {
+	struct net_ipv4_reassembly *reass;
 	int i;
 
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
-		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
-			continue;
-		}
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
 
-		cb(&reassembly[i], user_data);
+	for (i = 0; i < REASSEMBLY_BUCKETS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&reassembly_hash[i], reass, node) {
+			cb(reass, user_data);
+		}
 	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+static int fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+}
+
+static unsigned int fragment_end(struct net_pkt *pkt)
+{
+	return net_pkt_ipv4_fragment_offset(pkt) + fragment_payload_len(pkt);
 }
 
-/* Verify that we have all the fragments received and in correct order.
+/* Store the fragment in the reassembly slot, ordered by offset, and account
+ * for the payload it covers.
  * Return:
  * - a negative value if the fragments are erroneous and must be dropped
  * - zero if we are expecting more fragments
  * - a positive value if we can proceed with the reassembly
  */
-static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+static int fragment_insert(struct net_ipv4_reassembly *reass, struct net_pkt *pkt)
 {
-	unsigned int expected_offset = 0;
-	bool more = true;
-	int i;
+	unsigned int offset = net_pkt_ipv4_fragment_offset(pkt);
+	int payload_len = fragment_payload_len(pkt);
+	unsigned int end;
+	int i, last;
+
+	if (payload_len < 0) {
+		return -EBADMSG;
+	}
+
+	end = offset + payload_len;
 
 	/* Fragments can arrive in any order, for example in reverse order:
 	 *   1 -> Fragment3(M=0, offset=x2)
 	 *   2 -> Fragment2(M=1, offset=x1)
 	 *   3 -> Fragment1(M=1, offset=0)
-	 * We have to test several requirements before proceeding with the reassembly:
-	 * - We received the first fragment (Fragment Offset is 0)
-	 * - All intermediate fragments are contiguous
-	 * - The More bit of the last fragment is 0
+	 * The stored fragments never overlap, so checking the neighbours of
+	 * the new fragment is enough to detect overlapping or duplicated
+	 * fragments, which are dropped.
 	 */
-	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		struct net_pkt *pkt = reass->pkt[i];
-		unsigned int offset;
-		int payload_len;
-
-		if (!pkt) {
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT && reass->pkt[i]; i++) {
+		if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) >= offset) {
 			break;
 		}
+	}
 
-		offset = net_pkt_ipv4_fragment_offset(pkt);
+	last = i;
+	while (last < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT && reass->pkt[last]) {
+		last++;
+	}
 
-		if (offset < expected_offset) {
-			/* Overlapping or duplicated, drop it */
-			return -EBADMSG;
-		} else if (offset != expected_offset) {
-			/* Not contiguous, let's wait for fragments */
-			return 0;
-		}
+	if (i > 0 && fragment_end(reass->pkt[i - 1]) > offset) {
+		return -EBADMSG;
+	}
 
-		payload_len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt);
+	if (i < last && (net_pkt_ipv4_fragment_offset(reass->pkt[i]) < end ||
+			 net_pkt_ipv4_fragment_offset(reass->pkt[i]) == offset)) {
+		return -EBADMSG;
+	}
 
-		if (payload_len < 0) {
+	if (!net_pkt_ipv4_fragment_more(pkt)) {
+		/* Only one last fragment, and nothing beyond it */
+		if (reass->total_len != UINT32_MAX || i < last) {
 			return -EBADMSG;
 		}
 
-		expected_offset += payload_len;
-		more = net_pkt_ipv4_fragment_more(pkt);
+		reass->total_len = end;
+	} else if (end > reass->total_len) {
+		return -EBADMSG;
 	}
 
-	if (more) {
-		return 0;
+	if (last == CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
+		/* We do not have free space left in the array */
+		return -ENOMEM;
 	}
 
-	return 1;
-}
-
-static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
-{
-	int i;
-
-	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (!reass->pkt[i]) {
-			LOG_DBG("Moving [%d] %p (offset 0x%x) to [%d]", pos, reass->pkt[pos],
-				net_pkt_ipv4_fragment_offset(reass->pkt[pos]), pos + 1);
-
-			/* pkt[i] is free, so shift everything between [pos] and [i - 1] by one
-			 * element
-			 */
-			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
-				sizeof(void *) * (i - pos));
+	memmove(&reass->pkt[i + 1], &reass->pkt[i], sizeof(void *) * (last - i));
 
-			/* pkt[pos] is now free */
-			reass->pkt[pos] = NULL;
+	LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i, offset);
+	reass->pkt[i] = pkt;
+	reass->received += payload_len;
 
-			return 0;
-		}
-	}
-
-	/* We do not have free space left in the array */
-	return -ENOMEM;
+	/* Nothing overlaps, so all the fragments are there once the
+	 * received payload adds up to the length of the packet.
+	 */
+	return reass->received == reass->total_len;
 }
 
 enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ipv4_hdr *hdr)
 {
 	struct net_ipv4_reassembly *reass = NULL;
+	enum net_verdict verdict = NET_OK;
 	uint16_t flag;
-	bool found;
 	uint8_t more;
 	uint16_t id;
 	int ret;
-	int i;
 
 	flag = ntohs(*((uint16_t *)&hdr->offset));
 	id = ntohs(*((uint16_t *)&hdr->id));
 
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
 	reass = reassembly_get(id, (struct in_addr *)hdr->src,
 			       (struct in_addr *)hdr->dst, hdr->proto);
 	if (!reass) {
 		LOG_ERR("Cannot get reassembly slot, dropping pkt %p", pkt);
-		goto drop;
+		verdict = NET_DROP;
+		goto out;
 	}
 
 	more = (flag & NET_IPV4_MORE_FRAG_MASK) ? true : false;
@@ -352,72 +402,37 @@ enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt, struct net_ip
 	/* The fragments might come in wrong order so place them in the reassembly chain in the
 	 * correct order.
 	 */
-	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
-		if (reass->pkt[i]) {
-			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
-			    net_pkt_ipv4_fragment_offset(pkt)) {
-				continue;
-			}
-
-			/* Make room for this fragment. If there is no room then it will discard
-			 * the whole reassembly.
-			 */
-			if (shift_packets(reass, i)) {
-				break;
-			}
-		}
-
-		LOG_DBG("Storing pkt %p to slot %d offset %d", pkt, i,
-			net_pkt_ipv4_fragment_offset(pkt));
-		reass->pkt[i] = pkt;
-		found = true;
-
-		break;
-	}
-
-	if (!found) {
+	ret = fragment_insert(reass, pkt);
+	if (ret == -ENOMEM) {
 		/* We could not add this fragment into our saved fragment list. The whole packet
 		 * must be discarded at this point.
 		 */
 		LOG_ERR("No slots available for 0x%x", reass->id);
-		net_pkt_unref(pkt);
 		goto drop;
-	}
-
-	ret = fragments_are_ready(reass);
-	if (ret < 0) {
+	} else if (ret < 0) {
 		LOG_ERR("Reassembled IPv4 verify failed, dropping id %u", reass->id);
-
-		/* Let the caller release the already inserted pkt */
-		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
-			reass->pkt[i] = NULL;
-		}
-
-		net_pkt_unref(pkt);
 		goto drop;
 	} else if (ret == 0) {
 		reassembly_info("Reassembly nth pkt", reass);
 
 		LOG_DBG("More fragments to be received");
-		goto accept;
+		goto out;
 	}
 
 	reassembly_info("Reassembly last pkt", reass);
 
 	/* The last fragment received, reassemble the packet */
 	reassemble_packet(reass);
-
-accept:
-	return NET_OK;
+	goto out;
 
 drop:
-	if (reass) {
-		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
-			return NET_OK;
-		}
-	}
+	net_pkt_unref(pkt);
+	reassembly_cancel(reass);
+
+out:
+	k_mutex_unlock(&reassembly_lock);
 
-	return NET_DROP;
+	return verdict;
 }
 
 static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t rand_id, uint16_t fit_len,
@@ -669,5 +684,8 @@ void net_ipv4_setup_fragment_buffers(void)
 	 */
 	for (int i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
 		k_work_init_delayable(&reassembly[i].timer, reassembly_timeout);
+		sys_slist_append(&reassembly_free, &reassembly[i].node);
 	}
+
+	reassembly_seed = sys_rand32_get();
 }
@@ -449,15 +449,24 @@ struct net_ipv6_reassembly {
 	/** IPv6 destination address of the fragment */
 	struct in6_addr dst;
 
-	/**
-	 * Timeout for cancelling the reassembly. The timer is used
-	 * also to detect if this reassembly slot is used or not.
-	 */
+	/** Timeout for cancelling the reassembly. */
 	struct k_work_delayable timer;
 
-	/** Pointers to pending fragments */
+	/** Pointers to pending fragments, sorted by fragment offset */
 	struct net_pkt *pkt[CONFIG_NET_IPV6_FRAGMENT_MAX_PKT];
 
+	/** Hash bucket or free list node, the slot is in use when hashed */
+	sys_snode_t node;
+
+	/** Number of payload bytes received so far */
+	uint32_t received;
+
+	/**
+	 * Payload length of the whole packet, UINT32_MAX until the last
+	 * fragment is received.
+	 */
+	uint32_t total_len;
+
 	/** IPv6 fragment identification */
 	uint32_t id;
 };
@@ -57,12 +57,12 @@ struct net_nbr *net_nbr_ref(struct net_nbr *nbr)
 	return nbr;
 }
 
-static inline struct net_nbr *get_nbr(struct net_nbr *start, int idx)
+static inline struct net_nbr *get_nbr(struct net_nbr_table *table, int idx)
 {
-	NET_ASSERT(idx < CONFIG_NET_IPV6_MAX_NEIGHBORS);
+	NET_ASSERT(idx < table->nbr_count);
 
-	return (struct net_nbr *)((uint8_t *)start +
-			((sizeof(struct net_nbr) + start->size) * idx));
+	return (struct net_nbr *)((uint8_t *)table->nbr +
+			((sizeof(struct net_nbr) + table->nbr->size) * idx));
 }
 
 struct net_nbr *net_nbr_get(struct net_nbr_table *table)
@@ -70,7 +70,7 @@ struct net_nbr *net_nbr_get(struct net_nbr_table *table)
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+		struct net_nbr *nbr = get_nbr(table, i);
 
 		if (!nbr->ref) {
 			nbr->data = nbr->__nbr;
@@ -163,7 +163,7 @@ struct net_nbr *net_nbr_lookup(struct net_nbr_table *table,
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
+		struct net_nbr *nbr = get_nbr(table, i);
 
 		if (nbr->ref && nbr->iface == iface &&
 		    net_neighbor_lladdr[nbr->idx].ref &&
@@ -190,11 +190,20 @@ void net_nbr_clear_table(struct net_nbr_table *table)
 	int i;
 
 	for (i = 0; i < table->nbr_count; i++) {
-		struct net_nbr *nbr = get_nbr(table->nbr, i);
-		struct net_linkaddr lladdr = {
-			.addr = net_neighbor_lladdr[i].lladdr.addr,
-			.len = net_neighbor_lladdr[i].lladdr.len
-		};
+		struct net_nbr *nbr = get_nbr(table, i);
+		struct net_linkaddr_storage *storage;
+		struct net_linkaddr lladdr;
+
+		/* The table can be larger than the link address array, so
+		 * only entries linked to an address are looked up in it.
+		 */
+		if (!nbr->ref || nbr->idx == NET_NBR_LLADDR_UNKNOWN) {
+			continue;
+		}
+
+		storage = net_nbr_get_lladdr(nbr->idx);
+		lladdr.addr = storage->addr;
+		lladdr.len = storage->len;
 
 		net_nbr_unlink(nbr, &lladdr);
 	}
@@ -210,7 +219,7 @@ void net_nbr_print(struct net_nbr_table *table)
 		int i;
 
 		for (i = 0; i < table->nbr_count; i++) {
-			struct net_nbr *nbr = get_nbr(table->nbr, i);
+			struct net_nbr *nbr = get_nbr(table, i);
 
 			if (!nbr->ref) {
 				continue;
@@ -579,6 +579,8 @@ int net_context_unref(struct net_context *context)
 
 	context->flags &= ~NET_CONTEXT_IN_USE;
 
+	net_pkt_cache_flush(context);
+
 	NET_DBG("Context %p released", context);
 
 	k_mutex_unlock(&context->lock);
@@ -1817,10 +1819,10 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 					 sa_family_t family,
 					 size_t len, k_timeout_t timeout)
 {
-	struct net_pkt *pkt;
-
 #if defined(CONFIG_NET_CONTEXT_NET_PKT_POOL)
 	if (context->tx_slab) {
+		struct net_pkt *pkt;
+
 		pkt = net_pkt_alloc_from_slab(context->tx_slab(), timeout);
 		if (!pkt) {
 			return NULL;
@@ -1841,15 +1843,9 @@ static struct net_pkt *context_alloc_pkt(struct net_context *context,
 		return pkt;
 	}
 #endif
-	pkt = net_pkt_alloc_with_buffer(net_context_get_iface(context), len,
-					family,
-					net_context_get_proto(context),
-					timeout);
-	if (pkt) {
-		net_pkt_set_context(pkt, context);
-	}
-
-	return pkt;
+	return net_pkt_cache_alloc(context, net_context_get_iface(context), len,
+				   family, net_context_get_proto(context),
+				   timeout);
 }
 
 static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
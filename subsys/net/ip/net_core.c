@@ -59,8 +59,8 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
-static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+static inline enum net_verdict process_l2(struct net_pkt *pkt,
+					  bool is_loopback)
 {
 	int ret;
 	bool locally_routed = false;
@@ -118,6 +118,13 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
+	return NET_CONTINUE;
+}
+
+static inline enum net_verdict process_l3(struct net_pkt *pkt,
+					  bool is_loopback)
+{
+	int ret;
 	uint8_t family = net_pkt_family(pkt);
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (family == AF_INET || family == AF_INET6 ||
@@ -150,15 +157,30 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	return NET_DROP;
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static inline enum net_verdict process_data(struct net_pkt *pkt,
+					    bool is_loopback)
+{
+	enum net_verdict ret;
+
+	ret = process_l2(pkt, is_loopback);
+	if (ret != NET_CONTINUE) {
+		return ret;
+	}
+
+	return process_l3(pkt, is_loopback);
+}
+
+static void processing_verdict(struct net_pkt *pkt, enum net_verdict verdict,
+			       bool is_loopback)
 {
 again:
-	switch (process_data(pkt, is_loopback)) {
+	switch (verdict) {
 	case NET_CONTINUE:
 		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
 			/* If we have a tunneling packet, feed it back
 			 * to the stack in this case.
 			 */
+			verdict = process_data(pkt, is_loopback);
 			goto again;
 		} else {
 			NET_DBG("Dropping pkt %p", pkt);
@@ -176,6 +198,11 @@ again:
 	}
 }
 
+static void processing_data(struct net_pkt *pkt, bool is_loopback)
+{
+	processing_verdict(pkt, process_data(pkt, is_loopback), is_loopback);
+}
+
 /* Things to setup after we are able to RX and TX */
 static void net_post_init(void)
 {
@@ -429,7 +456,7 @@ int net_send_data(struct net_pkt *pkt)
 	return 0;
 }
 
-static void net_rx(struct net_if *iface, struct net_pkt *pkt)
+static bool net_rx_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
 	bool is_loopback = false;
 	size_t pkt_len;
@@ -448,6 +475,15 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 	}
 
+	return is_loopback;
+}
+
+static void net_rx(struct net_if *iface, struct net_pkt *pkt)
+{
+	bool is_loopback;
+
+	is_loopback = net_rx_prepare(iface, pkt);
+
 	processing_data(pkt, is_loopback);
 
 	net_print_statistics();
@@ -458,16 +494,466 @@ void net_process_rx_packet(struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	net_capture_pkt(net_pkt_iface(pkt), pkt);
+	net_capture_pkt_dir(net_pkt_iface(pkt), pkt, NET_CAPTURE_INBOUND);
 
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
+#if defined(CONFIG_NET_GRO)
+/* A TCP segment that is a candidate for receive coalescing. The IP and
+ * TCP headers are located in the first fragment of the packet, after
+ * the L2 header has been removed.
+ */
+struct gro_seg {
+	struct net_pkt *pkt;
+	struct net_tcp_hdr *tcp_hdr;
+	uint16_t hdr_len;
+	uint16_t payload_len;
+	uint32_t seq;
+	uint8_t segs;
+	bool is_loopback;
+};
+
+#if defined(CONFIG_NET_IPV4)
+static bool gro_prepare_ipv4(struct net_pkt *pkt, uint16_t *ip_hdr_len)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	uint16_t frag;
+
+	if (pkt->buffer->len < sizeof(struct net_ipv4_hdr)) {
+		return false;
+	}
+
+	/* No IPv4 options, no fragments */
+	frag = sys_get_be16(hdr->offset);
+
+	if (hdr->vhl != 0x45 || hdr->proto != IPPROTO_TCP ||
+	    (frag & NET_IPV4_FRAGH_OFFSET_MASK) != 0U ||
+	    ((frag >> 13) & NET_IPV4_MF) != 0U) {
+		return false;
+	}
+
+	if (ntohs(hdr->len) != net_pkt_get_len(pkt) ||
+	    !net_ipv4_is_my_addr((struct in_addr *)hdr->dst)) {
+		return false;
+	}
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv4_hdr));
+	net_pkt_set_ipv4_opts_len(pkt, 0);
+
+	if (net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+	    net_calc_chksum_ipv4(pkt) != 0U) {
+		return false;
+	}
+
+	*ip_hdr_len = sizeof(struct net_ipv4_hdr);
+
+	return true;
+}
+
+static void gro_set_ipv4_len(struct net_pkt *pkt, uint16_t len)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+	hdr->len = htons(len);
+	hdr->chksum = 0U;
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+}
+#else
+static inline bool gro_prepare_ipv4(struct net_pkt *pkt, uint16_t *ip_hdr_len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr_len);
+
+	return false;
+}
+
+static inline void gro_set_ipv4_len(struct net_pkt *pkt, uint16_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(len);
+}
+#endif /* CONFIG_NET_IPV4 */
+
+static bool gro_prepare_ipv6(struct net_pkt *pkt, uint16_t *ip_hdr_len)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+
+	if (pkt->buffer->len < sizeof(struct net_ipv6_hdr)) {
+		return false;
+	}
+
+	/* No extension headers */
+	if (hdr->nexthdr != IPPROTO_TCP ||
+	    ntohs(hdr->len) + sizeof(struct net_ipv6_hdr) !=
+						net_pkt_get_len(pkt) ||
+	    !net_ipv6_is_my_addr((struct in6_addr *)hdr->dst)) {
+		return false;
+	}
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+
+	*ip_hdr_len = sizeof(struct net_ipv6_hdr);
+
+	return true;
+}
+
+/* Check whether the packet is a plain TCP data segment that can be
+ * coalesced with its neighbours. If the checksum needs to be verified in
+ * software, it is done here once per segment and the packet is marked so
+ * that TCP does not verify the (now stale) checksum of the coalesced
+ * packet again.
+ */
+static bool gro_prepare(struct net_pkt *pkt, bool is_loopback,
+			struct gro_seg *seg)
+{
+	struct net_tcp_hdr *tcp_hdr;
+	uint16_t ip_hdr_len;
+	uint16_t hdr_len;
+	size_t pkt_len;
+	uint8_t vtc_vhl;
+
+	if (pkt->buffer == NULL || pkt->buffer->len == 0U) {
+		return false;
+	}
+
+	vtc_vhl = NET_IPV6_HDR(pkt)->vtc & 0xf0;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && vtc_vhl == 0x40 &&
+	    net_pkt_family(pkt) == AF_INET) {
+		if (!gro_prepare_ipv4(pkt, &ip_hdr_len)) {
+			return false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && vtc_vhl == 0x60 &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		if (!gro_prepare_ipv6(pkt, &ip_hdr_len)) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+
+	if (pkt->buffer->len < ip_hdr_len + sizeof(struct net_tcp_hdr)) {
+		return false;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)(pkt->buffer->data + ip_hdr_len);
+	hdr_len = ip_hdr_len + (tcp_hdr->offset >> 4) * 4U;
+	pkt_len = net_pkt_get_len(pkt);
+
+	if (hdr_len < ip_hdr_len + sizeof(struct net_tcp_hdr) ||
+	    pkt->buffer->len < hdr_len || pkt_len <= hdr_len) {
+		return false;
+	}
+
+	/* Only segments carrying data with ACK (and optionally PSH) set */
+	if ((tcp_hdr->flags & ~(ACK | PSH)) != 0U ||
+	    (tcp_hdr->flags & ACK) == 0U) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+		if (net_calc_chksum_tcp(pkt) != 0U) {
+			return false;
+		}
+
+		net_pkt_set_gro_chksum_ok(pkt, true);
+	}
+
+	seg->pkt = pkt;
+	seg->tcp_hdr = tcp_hdr;
+	seg->hdr_len = hdr_len;
+	seg->payload_len = pkt_len - hdr_len;
+	seg->seq = sys_get_be32(tcp_hdr->seq);
+	seg->segs = 1U;
+	seg->is_loopback = is_loopback;
+
+	return true;
+}
+
+static bool gro_same_flow(struct gro_seg *held, struct gro_seg *seg)
+{
+	uint8_t *hdr1 = held->pkt->buffer->data;
+	uint8_t *hdr2 = seg->pkt->buffer->data;
+
+	if (net_pkt_iface(held->pkt) != net_pkt_iface(seg->pkt) ||
+	    net_pkt_family(held->pkt) != net_pkt_family(seg->pkt) ||
+	    held->hdr_len != seg->hdr_len) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(held->pkt) == AF_INET) {
+		struct net_ipv4_hdr *ip1 = (struct net_ipv4_hdr *)hdr1;
+		struct net_ipv4_hdr *ip2 = (struct net_ipv4_hdr *)hdr2;
+
+		if (ip1->tos != ip2->tos || ip1->ttl != ip2->ttl ||
+		    memcmp(ip1->src, ip2->src, 2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(held->pkt) == AF_INET6) {
+		struct net_ipv6_hdr *ip1 = (struct net_ipv6_hdr *)hdr1;
+		struct net_ipv6_hdr *ip2 = (struct net_ipv6_hdr *)hdr2;
+
+		/* Version, traffic class and flow label */
+		if (memcmp(ip1, ip2, 4) != 0 ||
+		    ip1->hop_limit != ip2->hop_limit ||
+		    memcmp(ip1->src, ip2->src, 2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+
+	/* Ports must match and so must the acknowledgment number and
+	 * the TCP options.
+	 */
+	return held->tcp_hdr->src_port == seg->tcp_hdr->src_port &&
+	       held->tcp_hdr->dst_port == seg->tcp_hdr->dst_port &&
+	       memcmp(held->tcp_hdr->ack, seg->tcp_hdr->ack,
+		      sizeof(held->tcp_hdr->ack)) == 0 &&
+	       memcmp(held->tcp_hdr->optdata, seg->tcp_hdr->optdata,
+		      held->hdr_len - net_pkt_ip_hdr_len(held->pkt) -
+		      sizeof(struct net_tcp_hdr)) == 0;
+}
+
+static bool gro_can_merge(struct gro_seg *held, struct gro_seg *seg)
+{
+	/* PSH does not stop coalescing as the held segment is flushed
+	 * at the end of the burst anyway, so no data is delayed.
+	 */
+	if (held->seq + held->payload_len != seg->seq) {
+		return false;
+	}
+
+	if (held->hdr_len + held->payload_len + seg->payload_len >
+							CONFIG_NET_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	if (net_pkt_is_gro_chksum_ok(held->pkt) !=
+					net_pkt_is_gro_chksum_ok(seg->pkt)) {
+		return false;
+	}
+
+	return gro_same_flow(held, seg);
+}
+
+static void gro_merge(struct gro_seg *held, struct gro_seg *seg)
+{
+	struct net_buf *frags = seg->pkt->buffer;
+
+	/* The newest segment carries the latest window and PSH */
+	memcpy(held->tcp_hdr->wnd, seg->tcp_hdr->wnd,
+	       sizeof(held->tcp_hdr->wnd));
+	held->tcp_hdr->flags |= seg->tcp_hdr->flags & PSH;
+
+	seg->pkt->buffer = NULL;
+
+	net_buf_pull(frags, seg->hdr_len);
+	if (frags->len == 0U) {
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	if (frags != NULL) {
+		net_pkt_frag_add(held->pkt, frags);
+	}
+
+	held->payload_len += seg->payload_len;
+	held->segs++;
+
+	NET_DBG("Coalesced pkt %p into pkt %p (%u segments)", seg->pkt,
+		held->pkt, held->segs);
+
+	net_pkt_unref(seg->pkt);
+}
+
+static void gro_flush(struct gro_seg *held)
+{
+	struct net_pkt *pkt = held->pkt;
+	uint16_t len;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	held->pkt = NULL;
+
+	if (held->segs > 1U) {
+		len = held->hdr_len + held->payload_len;
+
+		if (net_pkt_family(pkt) == AF_INET) {
+			gro_set_ipv4_len(pkt, len);
+		} else {
+			NET_IPV6_HDR(pkt)->len =
+				htons(len - sizeof(struct net_ipv6_hdr));
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	processing_verdict(pkt, process_l3(pkt, held->is_loopback),
+			   held->is_loopback);
+}
+
+/* Process a burst of packets from the RX queue. The first packet has
+ * already been taken from the queue by the caller, the rest are taken
+ * as long as they are immediately available.
+ */
+void net_process_rx_burst(struct k_fifo *fifo, struct net_pkt *pkt)
+{
+	struct gro_seg held = { 0 };
+	struct gro_seg seg;
+	enum net_verdict verdict;
+	bool is_loopback;
+	int count = 0;
+
+	do {
+		net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+		net_capture_pkt_dir(net_pkt_iface(pkt), pkt, NET_CAPTURE_INBOUND);
+
+		is_loopback = net_rx_prepare(net_pkt_iface(pkt), pkt);
+
+		verdict = process_l2(pkt, is_loopback);
+		if (verdict != NET_CONTINUE) {
+			processing_verdict(pkt, verdict, is_loopback);
+		} else if (!gro_prepare(pkt, is_loopback, &seg)) {
+			gro_flush(&held);
+			processing_verdict(pkt, process_l3(pkt, is_loopback),
+					   is_loopback);
+		} else if (held.pkt != NULL && gro_can_merge(&held, &seg)) {
+			gro_merge(&held, &seg);
+		} else {
+			gro_flush(&held);
+			held = seg;
+		}
+	} while (++count < CONFIG_NET_GRO_BURST_MAX &&
+		 (pkt = k_fifo_get(fifo, K_NO_WAIT)) != NULL);
+
+	gro_flush(&held);
+
+	net_print_statistics();
+	net_pkt_print();
+}
+#endif /* CONFIG_NET_GRO */
+
+#if defined(CONFIG_NET_RX_STEERING)
+static uint32_t rx_flow_mix(uint32_t hash, uint32_t val)
+{
+	val *= 0xcc9e2d51U;
+	val = (val << 15) | (val >> 17);
+	hash ^= val * 0x1b873593U;
+	hash = (hash << 13) | (hash >> 19);
+
+	return hash * 5U + 0xe6546b64U;
+}
+
+/* Compute a flow hash from the headers found in the first buffer of the
+ * packet. The L4 ports are only used for unfragmented TCP and UDP packets,
+ * so that all fragments of a datagram end up in the same queue. Anything
+ * that cannot be parsed is hashed by interface only.
+ */
+static uint32_t rx_flow_hash(struct net_if *iface, struct net_pkt *pkt)
+{
+	const uint8_t *data = pkt->buffer->data;
+	size_t len = pkt->buffer->len;
+	uint32_t hash = rx_flow_mix(0, net_if_get_by_iface(iface));
+	size_t addr_len, l4_offset = 0;
+	const uint8_t *addr;
+	uint8_t proto;
+	int i;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		size_t hdr_len = sizeof(struct net_eth_hdr);
+		uint16_t type;
+
+		if (len < hdr_len) {
+			goto out;
+		}
+
+		type = UNALIGNED_GET(&((struct net_eth_hdr *)data)->type);
+		if (type == htons(NET_ETH_PTYPE_VLAN) && len >= hdr_len + 4) {
+			type = UNALIGNED_GET((uint16_t *)(data + hdr_len + 2));
+			hdr_len += 4;
+		}
+
+		if (type != htons(NET_ETH_PTYPE_IP) &&
+		    type != htons(NET_ETH_PTYPE_IPV6)) {
+			goto out;
+		}
+
+		data += hdr_len;
+		len -= hdr_len;
+	}
+#endif
+
+	if (len < 1) {
+		goto out;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (data[0] & 0xf0) == 0x40 &&
+	    len >= sizeof(struct net_ipv4_hdr)) {
+		const struct net_ipv4_hdr *hdr = (const void *)data;
+
+		proto = hdr->proto;
+		addr = hdr->src;
+		addr_len = 2 * sizeof(struct in_addr);
+
+		if ((hdr->offset[0] & 0x3f) == 0 && hdr->offset[1] == 0) {
+			l4_offset = (hdr->vhl & 0x0f) * 4;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (data[0] & 0xf0) == 0x60 &&
+		   len >= sizeof(struct net_ipv6_hdr)) {
+		const struct net_ipv6_hdr *hdr = (const void *)data;
+
+		proto = hdr->nexthdr;
+		addr = hdr->src;
+		addr_len = 2 * sizeof(struct in6_addr);
+		l4_offset = sizeof(struct net_ipv6_hdr);
+	} else {
+		goto out;
+	}
+
+	/* Source and destination address are adjacent in both headers */
+	for (i = 0; i < addr_len; i += sizeof(uint32_t)) {
+		hash = rx_flow_mix(hash, UNALIGNED_GET((uint32_t *)(addr + i)));
+	}
+
+	hash = rx_flow_mix(hash, proto);
+
+	if (l4_offset > 0 && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= l4_offset + sizeof(uint32_t)) {
+		/* Source and destination port */
+		hash = rx_flow_mix(hash,
+				   UNALIGNED_GET((uint32_t *)(data + l4_offset)));
+	}
+
+out:
+	/* 0 means no hash */
+	return hash != 0 ? hash : 1;
+}
+#endif /* CONFIG_NET_RX_STEERING */
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
 
+#if defined(CONFIG_NET_RX_STEERING)
+	if (net_pkt_rx_hash(pkt) == 0) {
+		net_pkt_set_rx_hash(pkt, rx_flow_hash(iface, pkt));
+	}
+
+	net_stats_update_rx_queue(iface, tc,
+				  net_rx_hash2queue(net_pkt_rx_hash(pkt)),
+				  net_pkt_get_len(pkt));
+#endif
+
 #if defined(CONFIG_NET_STATISTICS)
 	net_stats_update_tc_recv_pkt(iface, tc);
 	net_stats_update_tc_recv_bytes(iface, tc, net_pkt_get_len(pkt));
@@ -541,6 +1027,7 @@ static inline void l3_init(void)
 	net_tcp_init();
 
 	net_route_init();
+	net_route_ipv4_init();
 
 	NET_DBG("Network L3 init done");
 }
@@ -504,6 +504,10 @@ static inline struct net_buf_pool *get_data_pool(struct net_context *context)
 #define get_data_pool(...) NULL
 #endif /* CONFIG_NET_CONTEXT_NET_PKT_POOL */
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+static bool pkt_cache_put(struct net_pkt *pkt);
+#endif
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 void net_pkt_unref_debug(struct net_pkt *pkt, const char *caller, int line)
 {
@@ -593,6 +597,12 @@ done:
 		return;
 	}
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+	if (pkt->cache_context && pkt_cache_put(pkt)) {
+		return;
+	}
+#endif
+
 	if (pkt->frags) {
 		net_pkt_frag_unref(pkt->frags);
 	}
@@ -1258,33 +1268,9 @@ int net_pkt_alloc_buffer_raw(struct net_pkt *pkt, size_t size,
 	return 0;
 }
 
-#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout,
-				 const char *caller, int line)
-#else
-static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
-#endif
+static void pkt_setup(struct net_pkt *pkt, struct k_mem_slab *slab,
+		      uint32_t create_time)
 {
-	struct net_pkt *pkt;
-	uint32_t create_time;
-	int ret;
-
-	if (k_is_in_isr()) {
-		timeout = K_NO_WAIT;
-	}
-
-	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
-	    IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
-		create_time = k_cycle_get_32();
-	} else {
-		ARG_UNUSED(create_time);
-	}
-
-	ret = k_mem_slab_alloc(slab, (void **)&pkt, timeout);
-	if (ret) {
-		return NULL;
-	}
-
 	memset(pkt, 0, sizeof(struct net_pkt));
 
 	pkt->atomic_ref = ATOMIC_INIT(1);
@@ -1315,15 +1301,47 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
 	    IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 		net_pkt_set_create_time(pkt, create_time);
+	} else {
+		ARG_UNUSED(create_time);
 	}
 
 	net_pkt_set_vlan_tag(pkt, NET_VLAN_TAG_UNSPEC);
 
+	net_pkt_cursor_init(pkt);
+}
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-	net_pkt_alloc_add(pkt, true, caller, line);
+static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout,
+				 const char *caller, int line)
+#else
+static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 #endif
+{
+	struct net_pkt *pkt;
+	uint32_t create_time;
+	int ret;
 
-	net_pkt_cursor_init(pkt);
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
+		create_time = k_cycle_get_32();
+	} else {
+		create_time = 0U;
+	}
+
+	ret = k_mem_slab_alloc(slab, (void **)&pkt, timeout);
+	if (ret) {
+		return NULL;
+	}
+
+	pkt_setup(pkt, slab, create_time);
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	net_pkt_alloc_add(pkt, true, caller, line);
+#endif
 
 	return pkt;
 }
@@ -1541,6 +1559,206 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
 #endif
 }
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+/* Serialises returning a packet to a cache with flushing the cache when
+ * the context is released, so that nothing is cached in a free context.
+ */
+static struct k_spinlock pkt_cache_lock;
+
+static bool pkt_cache_put(struct net_pkt *pkt)
+{
+	struct net_context *context = pkt->cache_context;
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+	bool cached = false;
+	int i;
+
+	if (!pkt->buffer) {
+		return false;
+	}
+
+	/* Only keep buffers that nobody else holds, a clone or a packet
+	 * in a retransmit queue might still refer to them.
+	 */
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		if (buf->ref != 1U || buf->flags != 0U ||
+		    net_buf_pool_get(buf->pool_id) != &tx_bufs) {
+			return false;
+		}
+	}
+
+	key = k_spin_lock(&pkt_cache_lock);
+
+	if (net_context_is_used(context)) {
+		for (i = 0; i < ARRAY_SIZE(context->pkt_cache); i++) {
+			if (atomic_ptr_cas(&context->pkt_cache[i], NULL, pkt)) {
+				cached = true;
+				break;
+			}
+		}
+	}
+
+	k_spin_unlock(&pkt_cache_lock, key);
+
+	return cached;
+}
+
+static void pkt_cache_free(struct net_pkt *pkt)
+{
+	if (pkt->buffer) {
+		net_buf_unref(pkt->buffer);
+	}
+
+	k_mem_slab_free(pkt->slab, (void *)pkt);
+}
+
+/* Reset the cached buffers and drop the ones that are not needed for
+ * alloc_len bytes, for example a L2 header buffer that was inserted in
+ * front of the data. Returns the number of bytes that are still missing
+ * if the buffers are too small.
+ */
+static size_t pkt_cache_fit(struct net_buf **buffer, size_t alloc_len)
+{
+	struct net_buf *buf, *last = NULL;
+	size_t total = 0;
+
+	for (buf = *buffer; buf; buf = buf->frags) {
+		net_buf_simple_reset(&buf->b);
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+		buf->size = CONFIG_NET_BUF_DATA_SIZE;
+#endif
+		total += buf->size;
+	}
+
+	if (total < alloc_len) {
+		return alloc_len - total;
+	}
+
+	while (total - (*buffer)->size >= alloc_len && (*buffer)->frags) {
+		buf = *buffer;
+		*buffer = buf->frags;
+		total -= buf->size;
+
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+
+	for (buf = *buffer; buf && alloc_len; buf = buf->frags) {
+		last = buf;
+
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+		/* Same sizes as pkt_alloc_buffer() would give */
+		if (buf->size > alloc_len) {
+			buf->size = alloc_len;
+		}
+#endif
+		alloc_len -= MIN(buf->size, alloc_len);
+	}
+
+	if (last && last->frags) {
+		net_buf_unref(last->frags);
+		last->frags = NULL;
+	}
+
+	return 0;
+}
+
+struct net_pkt *net_pkt_cache_alloc(struct net_context *context,
+				    struct net_if *iface, size_t size,
+				    sa_family_t family,
+				    enum net_ip_protocol proto,
+				    k_timeout_t timeout)
+{
+	struct net_pkt *pkt = NULL;
+	struct net_buf *buffer;
+	size_t alloc_len;
+	size_t missing;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(context->pkt_cache); i++) {
+		pkt = atomic_ptr_clear(&context->pkt_cache[i]);
+		if (pkt) {
+			break;
+		}
+	}
+
+	if (!pkt) {
+		pkt = net_pkt_alloc_with_buffer(iface, size, family, proto,
+						timeout);
+		if (pkt) {
+			net_pkt_set_context(pkt, context);
+			net_pkt_cache_enable(pkt, context);
+		}
+
+		return pkt;
+	}
+
+	buffer = pkt->buffer;
+
+	pkt_setup(pkt, &tx_pkts,
+		  (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		   IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) ?
+		  k_cycle_get_32() : 0U);
+
+	net_pkt_set_iface(pkt, iface);
+	net_pkt_set_family(pkt, family);
+	net_pkt_set_context(pkt, context);
+	pkt->cache_context = context;
+
+	/* Same length as net_pkt_alloc_buffer() would allocate */
+	alloc_len = pkt_buffer_length(pkt,
+				      size + pkt_estimate_headers_length(pkt, family,
+									 proto),
+				      proto, 0);
+
+	missing = pkt_cache_fit(&buffer, alloc_len);
+
+	net_pkt_append_buffer(pkt, buffer);
+
+	/* Keep the cached buffers and only allocate the rest, the chain then
+	 * grows to the largest packet sent on the context.
+	 */
+	if (missing > 0) {
+		NET_DBG("Cached pkt %p misses %zu bytes", pkt, missing);
+
+		if (net_pkt_alloc_buffer_raw(pkt, missing, timeout) < 0) {
+			net_pkt_unref(pkt);
+			return NULL;
+		}
+	}
+
+	return pkt;
+}
+
+void net_pkt_cache_enable(struct net_pkt *pkt, struct net_context *context)
+{
+	if (pkt->slab == &tx_pkts) {
+		pkt->cache_context = context;
+	}
+}
+
+void net_pkt_cache_flush(struct net_context *context)
+{
+	struct net_pkt *pkts[ARRAY_SIZE(context->pkt_cache)];
+	k_spinlock_key_t key;
+	int i;
+
+	key = k_spin_lock(&pkt_cache_lock);
+
+	for (i = 0; i < ARRAY_SIZE(context->pkt_cache); i++) {
+		pkts[i] = atomic_ptr_clear(&context->pkt_cache[i]);
+	}
+
+	k_spin_unlock(&pkt_cache_lock, key);
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		if (pkts[i]) {
+			pkt_cache_free(pkts[i]);
+		}
+	}
+}
+#endif /* CONFIG_NET_CONTEXT_PKT_CACHE */
+
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 {
 	if (!pkt->buffer) {
@@ -1868,6 +2086,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_vlan_tag(clone_pkt, net_pkt_vlan_tag(pkt));
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
+	net_pkt_set_rx_hash(clone_pkt, net_pkt_rx_hash(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
 	net_pkt_set_eof(clone_pkt, net_pkt_eof(pkt));
@@ -60,6 +60,7 @@ extern void net_if_post_init(void);
 extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
+extern void net_process_rx_burst(struct k_fifo *fifo, struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
 
 extern int net_icmp_call_ipv4_handlers(struct net_pkt *pkt,
@@ -130,6 +131,13 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+
+/* Select the RX queue of a traffic class from the flow hash of a packet */
+static inline uint8_t net_rx_hash2queue(uint32_t hash)
+{
+	return NET_TC_RX_QUEUE_COUNT > 1 ? hash % NET_TC_RX_QUEUE_COUNT : 0;
+}
+
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -191,6 +199,62 @@ enum net_verdict net_gptp_recv(struct net_if *iface, struct net_pkt *pkt);
 #define net_gptp_recv(iface, pkt) NET_DROP
 #endif /* CONFIG_NET_GPTP */
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+/**
+ * @brief Allocate a TX packet with a data buffer, reusing a packet from
+ *        the packet cache of a context if there is one.
+ *
+ * @param context Network context that sends the packet.
+ * @param iface Network interface the packet is sent on.
+ * @param size Data size, like for net_pkt_alloc_with_buffer().
+ * @param family Address family of the packet.
+ * @param proto Protocol used to estimate the header length.
+ * @param timeout Time to wait for the packet or for the missing buffers.
+ *
+ * @return Packet with the context and interface set, NULL if it could
+ *         not be allocated.
+ */
+struct net_pkt *net_pkt_cache_alloc(struct net_context *context,
+				    struct net_if *iface, size_t size,
+				    sa_family_t family,
+				    enum net_ip_protocol proto,
+				    k_timeout_t timeout);
+
+/**
+ * @brief Return a TX packet to the cache of a context when it is freed.
+ *
+ * @param pkt Packet allocated for sending.
+ * @param context Network context that owns the cache.
+ */
+void net_pkt_cache_enable(struct net_pkt *pkt, struct net_context *context);
+
+/**
+ * @brief Free the packets in the cache of a context.
+ *
+ * @param context Network context.
+ */
+void net_pkt_cache_flush(struct net_context *context);
+#else
+static inline struct net_pkt *net_pkt_cache_alloc(struct net_context *context,
+						  struct net_if *iface,
+						  size_t size, sa_family_t family,
+						  enum net_ip_protocol proto,
+						  k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, size, family, proto, timeout);
+	if (pkt) {
+		net_pkt_set_context(pkt, context);
+	}
+
+	return pkt;
+}
+
+#define net_pkt_cache_enable(pkt, context)
+#define net_pkt_cache_flush(context)
+#endif /* CONFIG_NET_CONTEXT_PKT_CACHE */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
 				 uint16_t pkt_len, uint16_t mtu);
@@ -208,6 +272,46 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update an Internet checksum after a 16-bit word of the
+ *        checksummed data has changed (RFC 1624).
+ *
+ * All the values are in the byte order they have in the packet. For UDP,
+ * the caller must send a resulting 0x0000 checksum as 0xffff.
+ *
+ * @param chksum Checksum field value before the change
+ * @param old_val Old value of the changed word
+ * @param new_val New value of the changed word
+ *
+ * @return Checksum field value after the change
+ */
+static inline uint16_t net_chksum_update_16(uint16_t chksum, uint16_t old_val,
+					    uint16_t new_val)
+{
+	/* HC' = ~(~HC + ~m + m') */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a part of the checksummed data,
+ *        for example an address of the pseudo header, has changed
+ *        (RFC 1624).
+ *
+ * @param chksum Checksum field value before the change
+ * @param old_data Old data
+ * @param new_data New data
+ * @param len Length of the changed data, must be even
+ *
+ * @return Checksum field value after the change
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -21,15 +21,22 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With RX flow steering, the RX threads are named "rx_q[y.z]" where z is the
+ * flow queue of the traffic class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+
+/* Number of RX queues and threads, each traffic class has
+ * NET_TC_RX_QUEUE_COUNT of them.
+ */
+#define NET_RX_QUEUES (NET_TC_RX_COUNT * NET_TC_RX_QUEUE_COUNT)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_RX_QUEUES,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,7 +44,7 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_RX_QUEUES];
 #endif
 
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
@@ -63,9 +70,12 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	uint8_t queue = net_rx_hash2queue(net_pkt_rx_hash(pkt));
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[tc * NET_TC_RX_QUEUE_COUNT + queue].fifo,
+			pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -254,7 +264,11 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 			continue;
 		}
 
-		net_process_rx_packet(pkt);
+		if (IS_ENABLED(CONFIG_NET_GRO)) {
+			net_process_rx_burst(fifo, pkt);
+		} else {
+			net_process_rx_packet(pkt);
+		}
 	}
 }
 #endif
@@ -354,12 +368,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_RX_QUEUES; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_TC_RX_QUEUE_COUNT);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -389,10 +403,22 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_TC_RX_QUEUE_COUNT > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_TC_RX_QUEUE_COUNT,
+					 i % NET_TC_RX_QUEUE_COUNT);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_RX_STEERING_CPU_PIN)
+		(void)k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUE_COUNT) %
+					    arch_num_cpus());
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -40,6 +40,11 @@ static sys_slist_t active_route_lifetime_timers;
 /* Timer that manages expired route entries. */
 static struct k_work_delayable route_lifetime_timer;
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Longest prefix match table of the routes */
+static struct net_route_lpm routes_lpm;
+#endif
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -267,15 +272,37 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM)
+static bool route_iface_match(struct net_route_lpm_entry *entry,
+			      const void *user_data)
+{
+	const struct net_if *iface = user_data;
+
+	return !iface ||
+	       CONTAINER_OF(entry, struct net_route_entry, lpm)->iface == iface;
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct net_route_lpm_entry *entry;
+
+	entry = net_route_lpm_lookup(&routes_lpm, dst->s6_addr,
+				     route_iface_match, iface);
+	if (!entry) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry, lpm);
+}
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +325,18 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -442,6 +481,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	if (net_route_lpm_insert(&routes_lpm, route->addr.s6_addr,
+				 prefix_len, &route->lpm) < 0) {
+		NET_ERR("No free route lookup nodes!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -596,6 +646,11 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	(void)net_route_lpm_remove(&routes_lpm, route->addr.s6_addr,
+				   route->prefix_len, &route->lpm);
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -1028,4 +1083,8 @@ void net_route_init(void)
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
 
 	k_work_init_delayable(&route_lifetime_timer, route_lifetime_timeout);
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_lpm_init(&routes_lpm, sizeof(struct in6_addr));
+#endif
 }
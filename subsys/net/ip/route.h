@@ -20,6 +20,7 @@
 #include <zephyr/net/net_timeout.h>
 
 #include "nbr.h"
+#include "route_lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -61,6 +62,11 @@ struct net_route_entry {
 	/** IPv6 address/prefix of the route. */
 	struct in6_addr addr;
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Entry in the longest prefix match table. */
+	struct net_route_lpm_entry lpm;
+#endif
+
 	/** IPv6 address/prefix length. */
 	uint8_t prefix_len;
 
@@ -303,6 +309,115 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/**
+ * @brief IPv4 route entry.
+ */
+struct net_route_entry_ipv4 {
+	/** Entry in the longest prefix match table. */
+	struct net_route_lpm_entry lpm;
+
+	/** Network interface for the route. */
+	struct net_if *iface;
+
+	/** IPv4 address/prefix of the route. */
+	struct in_addr addr;
+
+	/** Gateway, unspecified if the prefix is directly reachable. */
+	struct in_addr gw;
+
+	/** IPv4 address/prefix length. */
+	uint8_t prefix_len;
+
+	/** Is this entry in use or not */
+	bool is_used;
+};
+
+typedef void (*net_route_ipv4_cb_t)(struct net_route_entry_ipv4 *entry,
+				    void *user_data);
+
+#if defined(CONFIG_NET_ROUTE_LPM) && defined(CONFIG_NET_IPV4) && \
+	defined(CONFIG_NET_NATIVE)
+/**
+ * @brief Add an IPv4 route to routing table.
+ *
+ * If a route to the same prefix already exists for the interface, its
+ * gateway is updated.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 address/prefix.
+ * @param prefix_len Length of the IPv4 prefix.
+ * @param gw Gateway address, NULL or unspecified if the prefix is
+ *        directly reachable via the interface.
+ *
+ * @return Return created route entry, NULL if could not be created.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						const struct in_addr *addr,
+						uint8_t prefix_len,
+						const struct in_addr *gw);
+
+/**
+ * @brief Delete an IPv4 route from routing table.
+ *
+ * @param route Existing route entry.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route);
+
+/**
+ * @brief Lookup IPv4 route to a given destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ *
+ * @return Route entry with the longest prefix matching the destination,
+ * NULL if not found.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   const struct in_addr *dst);
+
+/**
+ * @brief Get the next hop of an IPv4 destination.
+ *
+ * @param iface Network interface, NULL checks all interfaces.
+ * @param dst Destination IPv4 address.
+ * @param nexthop The gateway of the route, or @a dst if the route is
+ *        directly reachable, is returned here.
+ *
+ * @return 0 if there is a route to the destination, -ENOENT otherwise.
+ */
+int net_route_ipv4_get_nexthop(struct net_if *iface,
+			       const struct in_addr *dst,
+			       struct in_addr *nexthop);
+
+/**
+ * @brief Go through all the IPv4 routing entries and call callback
+ * for each entry that is in use.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Total number of IPv4 routing entries found.
+ */
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data);
+
+void net_route_ipv4_init(void);
+#else
+static inline int net_route_ipv4_get_nexthop(struct net_if *iface,
+					     const struct in_addr *dst,
+					     struct in_addr *nexthop)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(nexthop);
+
+	return -ENOENT;
+}
+
+#define net_route_ipv4_init(...)
+#endif /* CONFIG_NET_ROUTE_LPM && CONFIG_NET_IPV4 && CONFIG_NET_NATIVE */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -0,0 +1,226 @@
+/** @file
+ * @brief IPv4 route handling.
+ *
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_route_ipv4, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <errno.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+
+#include "net_private.h"
+#include "route.h"
+
+static struct net_route_entry_ipv4 routes_ipv4[CONFIG_NET_MAX_IPV4_ROUTES];
+
+/* Longest prefix match table of the routes */
+static struct net_route_lpm routes_ipv4_lpm;
+
+static K_MUTEX_DEFINE(lock);
+
+static bool prefix_equal(const struct in_addr *a, const struct in_addr *b,
+			 uint8_t prefix_len)
+{
+	uint32_t mask = prefix_len ? htonl(UINT32_MAX << (32 - prefix_len)) : 0;
+
+	return ((a->s_addr ^ b->s_addr) & mask) == 0U;
+}
+
+static bool route_iface_match(struct net_route_lpm_entry *entry,
+			      const void *user_data)
+{
+	const struct net_if *iface = user_data;
+
+	return !iface ||
+	       CONTAINER_OF(entry, struct net_route_entry_ipv4, lpm)->iface == iface;
+}
+
+static struct net_route_entry_ipv4 *route_find(struct net_if *iface,
+					       const struct in_addr *dst)
+{
+	struct net_route_lpm_entry *entry;
+
+	entry = net_route_lpm_lookup(&routes_ipv4_lpm, dst->s4_addr,
+				     route_iface_match, iface);
+	if (!entry) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry_ipv4, lpm);
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						const struct in_addr *addr,
+						uint8_t prefix_len,
+						const struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route = NULL;
+	int i;
+
+	NET_ASSERT(iface);
+	NET_ASSERT(addr);
+
+	if (prefix_len > 32) {
+		return NULL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(routes_ipv4); i++) {
+		if (routes_ipv4[i].is_used &&
+		    routes_ipv4[i].iface == iface &&
+		    routes_ipv4[i].prefix_len == prefix_len &&
+		    prefix_equal(&routes_ipv4[i].addr, addr, prefix_len)) {
+			route = &routes_ipv4[i];
+			goto update;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(routes_ipv4); i++) {
+		if (!routes_ipv4[i].is_used) {
+			route = &routes_ipv4[i];
+			break;
+		}
+	}
+
+	if (!route) {
+		NET_DBG("No free IPv4 route entries");
+		goto out;
+	}
+
+	route->iface = iface;
+	route->prefix_len = prefix_len;
+	net_ipaddr_copy(&route->addr, addr);
+
+	if (net_route_lpm_insert(&routes_ipv4_lpm, route->addr.s4_addr,
+				 prefix_len, &route->lpm) < 0) {
+		NET_ERR("No free route lookup nodes!");
+		route = NULL;
+		goto out;
+	}
+
+	route->is_used = true;
+
+update:
+	if (gw) {
+		net_ipaddr_copy(&route->gw, gw);
+	} else {
+		route->gw.s_addr = INADDR_ANY;
+	}
+
+	NET_DBG("Added route to %s/%d via %s (iface %p)",
+		net_sprint_ipv4_addr(addr), prefix_len,
+		net_sprint_ipv4_addr(&route->gw), iface);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return route;
+}
+
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route)
+{
+	int ret;
+
+	if (!route) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!route->is_used) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	ret = net_route_lpm_remove(&routes_ipv4_lpm, route->addr.s4_addr,
+				   route->prefix_len, &route->lpm);
+
+	route->is_used = false;
+
+	NET_DBG("Deleted route to %s/%d (iface %p)",
+		net_sprint_ipv4_addr(&route->addr), route->prefix_len,
+		route->iface);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   const struct in_addr *dst)
+{
+	struct net_route_entry_ipv4 *route;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	route = route_find(iface, dst);
+	k_mutex_unlock(&lock);
+
+	return route;
+}
+
+int net_route_ipv4_get_nexthop(struct net_if *iface,
+			       const struct in_addr *dst,
+			       struct in_addr *nexthop)
+{
+	struct net_route_entry_ipv4 *route;
+	int ret = -ENOENT;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	route = route_find(iface, dst);
+	if (route) {
+		if (net_ipv4_is_addr_unspecified(&route->gw)) {
+			net_ipaddr_copy(nexthop, dst);
+		} else {
+			net_ipaddr_copy(nexthop, &route->gw);
+		}
+
+		ret = 0;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data)
+{
+	int i, ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(routes_ipv4); i++) {
+		if (!routes_ipv4[i].is_used) {
+			continue;
+		}
+
+		cb(&routes_ipv4[i], user_data);
+
+		ret++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void net_route_ipv4_init(void)
+{
+	net_route_lpm_init(&routes_ipv4_lpm, sizeof(struct in_addr));
+
+	NET_DBG("Allocated %d IPv4 routing entries (%zu bytes)",
+		CONFIG_NET_MAX_IPV4_ROUTES, sizeof(routes_ipv4));
+}
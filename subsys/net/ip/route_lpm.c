@@ -0,0 +1,318 @@
+/** @file
+ * @brief Longest prefix match route lookup.
+ *
+ * The routes are stored in a path compressed binary (Patricia) trie.
+ * Each node stores a prefix and the two subtrees of longer prefixes
+ * that continue with a 0 or 1 bit. Nodes without entries are only used
+ * to branch, so a trie with n prefixes has at most 2n - 1 nodes and the
+ * lookup only visits the nodes whose prefix matches the key.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <errno.h>
+
+#include "route_lpm.h"
+
+struct net_route_lpm_node {
+	/* Subtrees with longer prefixes, indexed by the next key bit */
+	struct net_route_lpm_node *child[2];
+
+	/* Entries with this prefix, empty for a branching node */
+	sys_slist_t entries;
+
+	uint8_t prefix_len;
+
+	uint8_t key[NET_ROUTE_LPM_KEY_LEN];
+};
+
+#if defined(CONFIG_NET_ROUTE)
+#define LPM_IPV6_ROUTES CONFIG_NET_MAX_ROUTES
+#else
+#define LPM_IPV6_ROUTES 0
+#endif
+
+#if defined(CONFIG_NET_MAX_IPV4_ROUTES)
+#define LPM_IPV4_ROUTES CONFIG_NET_MAX_IPV4_ROUTES
+#else
+#define LPM_IPV4_ROUTES 0
+#endif
+
+/* Every prefix needs at most one branching node besides its own node */
+#define LPM_MAX_NODES MAX(2 * (LPM_IPV6_ROUTES + LPM_IPV4_ROUTES), 2)
+
+K_MEM_SLAB_DEFINE_STATIC(lpm_nodes, sizeof(struct net_route_lpm_node),
+			 LPM_MAX_NODES, sizeof(void *));
+
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_ROUTE_LPM_CACHE_SIZE),
+	     "CONFIG_NET_ROUTE_LPM_CACHE_SIZE must be a power of two");
+#endif
+
+static inline uint8_t key_bit(const uint8_t *key, uint8_t bit)
+{
+	return (key[bit / 8] >> (7 - (bit % 8))) & 1;
+}
+
+/* Return the number of leading bits, at most max_len, that are equal */
+static uint8_t common_prefix_len(const uint8_t *a, const uint8_t *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0;
+	int i;
+
+	for (i = 0; len < max_len; i++, len += 8) {
+		uint8_t diff = a[i] ^ b[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - (32 - 8);
+			break;
+		}
+	}
+
+	return MIN(len, max_len);
+}
+
+static bool prefix_matches(const struct net_route_lpm_node *node,
+			   const uint8_t *key)
+{
+	uint8_t bytes = node->prefix_len / 8;
+	uint8_t bits = node->prefix_len % 8;
+
+	if (memcmp(node->key, key, bytes) != 0) {
+		return false;
+	}
+
+	if (bits == 0U) {
+		return true;
+	}
+
+	return ((node->key[bytes] ^ key[bytes]) & (0xff << (8 - bits))) == 0U;
+}
+
+static struct net_route_lpm_node *node_alloc(const uint8_t *key,
+					     uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node;
+	uint8_t bytes = DIV_ROUND_UP(prefix_len, 8);
+
+	if (k_mem_slab_alloc(&lpm_nodes, (void **)&node, K_NO_WAIT) != 0) {
+		return NULL;
+	}
+
+	(void)memset(node, 0, sizeof(*node));
+	sys_slist_init(&node->entries);
+
+	node->prefix_len = prefix_len;
+	memcpy(node->key, key, bytes);
+
+	/* Keep the bits after the prefix zero */
+	if ((prefix_len % 8) != 0U) {
+		node->key[bytes - 1] &= 0xff << (8 - (prefix_len % 8));
+	}
+
+	return node;
+}
+
+static void node_free(struct net_route_lpm_node *node)
+{
+	k_mem_slab_free(&lpm_nodes, node);
+}
+
+static void table_changed(struct net_route_lpm *table)
+{
+	table->gen++;
+
+	if (table->gen == 0U) {
+		/* Old cache entries would become valid again on wrap */
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+		(void)memset(table->cache, 0, sizeof(table->cache));
+#endif
+		table->gen = 1U;
+	}
+}
+
+void net_route_lpm_init(struct net_route_lpm *table, uint8_t key_len)
+{
+	__ASSERT_NO_MSG(key_len <= NET_ROUTE_LPM_KEY_LEN);
+
+	(void)memset(table, 0, sizeof(*table));
+
+	table->key_len = key_len;
+	table->gen = 1U;
+}
+
+int net_route_lpm_insert(struct net_route_lpm *table, const uint8_t *key,
+			 uint8_t prefix_len, struct net_route_lpm_entry *entry)
+{
+	struct net_route_lpm_node **link = &table->root;
+	struct net_route_lpm_node *node, *new_node, *branch;
+	uint8_t len;
+
+	__ASSERT_NO_MSG(prefix_len <= table->key_len * 8);
+
+	while ((node = *link) != NULL) {
+		len = common_prefix_len(node->key, key,
+					MIN(node->prefix_len, prefix_len));
+
+		if (len < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			sys_slist_append(&node->entries, &entry->node);
+			goto out;
+		}
+
+		link = &node->child[key_bit(key, node->prefix_len)];
+	}
+
+	/* A new node and possibly a branching node are needed */
+	if (k_mem_slab_num_free_get(&lpm_nodes) < 2) {
+		return -ENOMEM;
+	}
+
+	new_node = node_alloc(key, prefix_len);
+	sys_slist_append(&new_node->entries, &entry->node);
+
+	if (node == NULL) {
+		*link = new_node;
+	} else if (len == prefix_len) {
+		/* The new prefix is a prefix of the existing node */
+		new_node->child[key_bit(node->key, len)] = node;
+		*link = new_node;
+	} else {
+		/* The prefixes diverge after len bits */
+		branch = node_alloc(key, len);
+		branch->child[key_bit(key, len)] = new_node;
+		branch->child[key_bit(node->key, len)] = node;
+		*link = branch;
+	}
+
+out:
+	table_changed(table);
+
+	return 0;
+}
+
+int net_route_lpm_remove(struct net_route_lpm *table, const uint8_t *key,
+			 uint8_t prefix_len, struct net_route_lpm_entry *entry)
+{
+	struct net_route_lpm_node **parent_link = NULL;
+	struct net_route_lpm_node **link = &table->root;
+	struct net_route_lpm_node *node, *parent;
+
+	while ((node = *link) != NULL) {
+		if (node->prefix_len > prefix_len ||
+		    !prefix_matches(node, key)) {
+			return -ENOENT;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			break;
+		}
+
+		parent_link = link;
+		link = &node->child[key_bit(key, node->prefix_len)];
+	}
+
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->entries, &entry->node)) {
+		return -ENOENT;
+	}
+
+	table_changed(table);
+
+	if (!sys_slist_is_empty(&node->entries) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		/* Still needed for branching */
+		return 0;
+	}
+
+	*link = node->child[0] != NULL ? node->child[0] : node->child[1];
+	node_free(node);
+
+	/* The parent might now be a branching node with a single child */
+	if (parent_link == NULL || *link != NULL) {
+		return 0;
+	}
+
+	parent = *parent_link;
+	if (!sys_slist_is_empty(&parent->entries)) {
+		return 0;
+	}
+
+	*parent_link = parent->child[0] != NULL ? parent->child[0] :
+						  parent->child[1];
+	node_free(parent);
+
+	return 0;
+}
+
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+static struct net_route_lpm_cache *cache_slot(struct net_route_lpm *table,
+					      const uint8_t *key,
+					      const void *user_data)
+{
+	uint32_t hash = (uint32_t)(uintptr_t)user_data;
+	int i;
+
+	for (i = 0; i < table->key_len; i++) {
+		hash = (hash ^ key[i]) * 0x01000193;
+	}
+
+	hash ^= hash >> 16;
+
+	return &table->cache[hash & (CONFIG_NET_ROUTE_LPM_CACHE_SIZE - 1)];
+}
+#endif
+
+struct net_route_lpm_entry *net_route_lpm_lookup(struct net_route_lpm *table,
+						 const uint8_t *key,
+						 net_route_lpm_match_cb_t cb,
+						 const void *user_data)
+{
+	struct net_route_lpm_entry *found = NULL, *entry;
+	struct net_route_lpm_node *node = table->root;
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+	struct net_route_lpm_cache *cache = cache_slot(table, key, user_data);
+
+	if (cache->gen == table->gen && cache->user_data == user_data &&
+	    memcmp(cache->key, key, table->key_len) == 0) {
+		table->cache_hits++;
+		return cache->entry;
+	}
+
+	table->cache_misses++;
+#endif
+
+	while (node != NULL && prefix_matches(node, key)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, entry, node) {
+			if (cb == NULL || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+
+		if (node->prefix_len == table->key_len * 8) {
+			break;
+		}
+
+		node = node->child[key_bit(key, node->prefix_len)];
+	}
+
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+	memcpy(cache->key, key, table->key_len);
+	cache->user_data = user_data;
+	cache->entry = found;
+	cache->gen = table->gen;
+#endif
+
+	return found;
+}
@@ -0,0 +1,143 @@
+/** @file
+ * @brief Longest prefix match route lookup
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_LPM_H
+#define __ROUTE_LPM_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum key length in bytes, enough for an IPv6 address */
+#define NET_ROUTE_LPM_KEY_LEN 16
+
+/**
+ * @brief Route entry stored in a LPM table.
+ *
+ * This is embedded into the route entry of the caller. Several entries
+ * can share the same prefix, for example routes to the same prefix via
+ * different network interfaces.
+ */
+struct net_route_lpm_entry {
+	/** Next entry with the same prefix */
+	sys_snode_t node;
+};
+
+struct net_route_lpm_node;
+
+/** @cond INTERNAL_HIDDEN */
+struct net_route_lpm_cache {
+	uint8_t key[NET_ROUTE_LPM_KEY_LEN];
+	const void *user_data;
+	struct net_route_lpm_entry *entry;
+	uint32_t gen;
+};
+/** @endcond */
+
+/**
+ * @brief Path compressed binary (Patricia) trie for longest prefix match.
+ *
+ * The table is not locked, the caller must serialize the access to it.
+ */
+struct net_route_lpm {
+	/** Root of the trie */
+	struct net_route_lpm_node *root;
+
+#if CONFIG_NET_ROUTE_LPM_CACHE_SIZE > 0
+	/** Recent lookup results */
+	struct net_route_lpm_cache cache[CONFIG_NET_ROUTE_LPM_CACHE_SIZE];
+
+	/** Lookup cache hit count */
+	uint32_t cache_hits;
+
+	/** Lookup cache miss count */
+	uint32_t cache_misses;
+#endif
+
+	/** Incremented when the table changes, invalidates the cache */
+	uint32_t gen;
+
+	/** Key length in bytes */
+	uint8_t key_len;
+};
+
+/**
+ * @brief Callback used to select an entry during lookup.
+ *
+ * @param entry Entry whose prefix matches the key.
+ * @param user_data User data given to net_route_lpm_lookup().
+ *
+ * @return True if the entry can be used, false otherwise.
+ */
+typedef bool (*net_route_lpm_match_cb_t)(struct net_route_lpm_entry *entry,
+					 const void *user_data);
+
+/**
+ * @brief Initialize a LPM table.
+ *
+ * @param table LPM table.
+ * @param key_len Length of the keys in bytes, 4 for IPv4 and 16 for IPv6.
+ */
+void net_route_lpm_init(struct net_route_lpm *table, uint8_t key_len);
+
+/**
+ * @brief Insert an entry to a LPM table.
+ *
+ * @param table LPM table.
+ * @param key Prefix, the bits after @a prefix_len are ignored.
+ * @param prefix_len Prefix length in bits.
+ * @param entry Entry to insert.
+ *
+ * @return 0 if ok, -ENOMEM if there are no free trie nodes.
+ */
+int net_route_lpm_insert(struct net_route_lpm *table, const uint8_t *key,
+			 uint8_t prefix_len, struct net_route_lpm_entry *entry);
+
+/**
+ * @brief Remove an entry from a LPM table.
+ *
+ * @param table LPM table.
+ * @param key Prefix the entry was inserted with.
+ * @param prefix_len Prefix length the entry was inserted with.
+ * @param entry Entry to remove.
+ *
+ * @return 0 if ok, -ENOENT if the entry was not found.
+ */
+int net_route_lpm_remove(struct net_route_lpm *table, const uint8_t *key,
+			 uint8_t prefix_len, struct net_route_lpm_entry *entry);
+
+/**
+ * @brief Find the entry with the longest prefix matching a key.
+ *
+ * The result is cached by @a key and @a user_data, so the result of
+ * @a cb must only depend on the entry and @a user_data.
+ *
+ * @param table LPM table.
+ * @param key Key to find, for example a destination address.
+ * @param cb Callback to select an entry, NULL accepts all entries.
+ * @param user_data User data passed to the callback.
+ *
+ * @return Matching entry, NULL if not found.
+ */
+struct net_route_lpm_entry *net_route_lpm_lookup(struct net_route_lpm *table,
+						 const uint8_t *key,
+						 net_route_lpm_match_cb_t cb,
+						 const void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_LPM_H */
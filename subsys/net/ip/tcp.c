@@ -1494,6 +1494,11 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		/* Data segments are not kept after sending, so their buffers
+		 * can go back to the packet cache.
+		 */
+		net_pkt_cache_enable(pkt, conn->context);
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -1625,6 +1630,86 @@ static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 	return ret;
 }
 
+/* Allocate TX buffers for len bytes and let the caller write the data
+ * directly into them. As with tcp_pkt_append(), the buffers are allocated
+ * all at once so that a failure does not drain the pool. The fill callback
+ * may return less than requested (end of data), in which case the unused
+ * buffers are freed. This is done without holding the connection lock, as
+ * the callback may be slow (e.g. reading from storage).
+ */
+static int tcp_buf_fill(struct tcp *conn, size_t len, net_tcp_fill_cb_t cb,
+			void *user_data, struct net_buf **frags)
+{
+	struct net_buf *buf, *prev = NULL;
+	size_t room = 0;
+	size_t filled = 0;
+	int ret = 0;
+
+	*frags = NULL;
+
+	while (room < len) {
+		size_t min_len = len - room;
+
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+		min_len = MIN(min_len, CONFIG_NET_BUF_DATA_SIZE);
+#endif
+
+		buf = net_pkt_get_frag(conn->send_data, min_len,
+				       TCP_PKT_ALLOC_TIMEOUT);
+		if (buf == NULL) {
+			if (*frags != NULL) {
+				net_buf_unref(*frags);
+				*frags = NULL;
+			}
+
+			return -ENOBUFS;
+		}
+
+		room += net_buf_tailroom(buf);
+
+		if (*frags == NULL) {
+			*frags = buf;
+		} else {
+			net_buf_frag_add(*frags, buf);
+		}
+	}
+
+	for (buf = *frags; buf != NULL && filled < len; buf = buf->frags) {
+		size_t write_len = MIN(len - filled, net_buf_tailroom(buf));
+		ssize_t got;
+
+		got = cb(net_buf_tail(buf), write_len, user_data);
+		if (got < 0) {
+			ret = got;
+			break;
+		}
+
+		net_buf_add(buf, got);
+		filled += got;
+
+		if (got < write_len) {
+			break;
+		}
+	}
+
+	/* Drop the buffers that were allocated but not filled */
+	for (buf = *frags; buf != NULL; ) {
+		if (buf->len == 0) {
+			buf = net_buf_frag_del(prev, buf);
+			if (prev == NULL) {
+				*frags = buf;
+			}
+
+			continue;
+		}
+
+		prev = buf;
+		buf = buf->frags;
+	}
+
+	return (filled > 0) ? filled : ret;
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1686,7 +1771,7 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	pkt = tcp_data_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -3620,6 +3705,30 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account newly queued data and push it out. Called with conn->lock held. */
+static int tcp_queue_commit(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		  const struct msghdr *msg)
 {
@@ -3688,25 +3797,64 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	ret = tcp_queue_commit(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
-	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
-		goto out;
+	return ret;
+}
+
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t cb, void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct net_buf *frags;
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
 	}
 
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
 	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		k_mutex_unlock(&conn->lock);
+		return -EAGAIN;
 	}
 
-	ret = queued_len;
+	len = MIN(conn->send_win - conn->send_data_total, len);
+
+	/* Keep the connection alive while it is not locked, a reset or
+	 * net_context_put() could release it otherwise.
+	 */
+	tcp_conn_ref(conn);
+
+	k_mutex_unlock(&conn->lock);
+
+	/* The data is produced without the lock so that a slow fill does not
+	 * hold up ACK processing and the timers of the connection. If the
+	 * window shrinks meanwhile, the extra data simply waits in the queue.
+	 */
+	ret = tcp_buf_fill(conn, len, cb, user_data, &frags);
+	if (ret <= 0) {
+		goto unref;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED) {
+		net_buf_unref(frags);
+		ret = -ENOTCONN;
+		goto out;
+	}
+
+	net_pkt_append_buffer(conn->send_data, frags);
+
+	ret = tcp_queue_commit(conn, ret);
 out:
 	k_mutex_unlock(&conn->lock);
+unref:
+	tcp_conn_unref(conn);
 
 	return ret;
 }
@@ -3995,9 +4143,13 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 {
 	struct net_tcp_hdr *tcp_hdr;
 
+	/* The checksum of coalesced (GRO) segments was verified before
+	 * the segments were merged.
+	 */
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
+	    !net_pkt_is_gro_chksum_ok(pkt) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -312,6 +312,49 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Callback that writes outgoing data directly into a TX buffer
+ *
+ * @param dst		Tail of the network buffer to write to
+ * @param len		Maximum number of bytes to write
+ * @param user_data	User data given to net_tcp_queue_fill()
+ *
+ * @return Number of bytes written, less than @a len at end of data,
+ *         or < 0 on error.
+ */
+typedef ssize_t (*net_tcp_fill_cb_t)(void *dst, size_t len, void *user_data);
+
+/**
+ * @brief Enqueue data for transmission, filling the TX buffers in place
+ *
+ * Allocates TX buffers for at most @a len bytes, limited by the free space
+ * in the send window, and lets @a cb write the data straight into them.
+ * The callback is called without holding the connection lock.
+ *
+ * @param context	Network context
+ * @param len		Maximum number of bytes to queue
+ * @param cb		Callback that produces the data
+ * @param user_data	User data passed to @a cb
+ *
+ * @return Number of bytes queued, 0 if @a cb had no more data,
+ *         -EAGAIN if the send window is full, < 0 on other errors.
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_fill(struct net_context *context, size_t len,
+		       net_tcp_fill_cb_t cb, void *user_data);
+#else
+static inline int net_tcp_queue_fill(struct net_context *context, size_t len,
+				     net_tcp_fill_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(len);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -78,6 +78,32 @@
 	_pkt;								\
 })
 
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+/* Segment data is allocated from the packet cache of the context. With
+ * variable sized buffers room for a full segment is allocated, so that
+ * the recycled buffer fits every later segment of the connection.
+ */
+#define tcp_data_pkt_alloc(_conn, _len)					\
+({									\
+	struct net_pkt *_pkt;						\
+									\
+	_pkt = net_pkt_cache_alloc(					\
+		(_conn)->context,					\
+		(_conn)->iface,						\
+		IS_ENABLED(CONFIG_NET_BUF_VARIABLE_DATA_SIZE) ?		\
+		MAX((_len), conn_mss(_conn)) : (_len),			\
+		net_context_get_family((_conn)->context),		\
+		IPPROTO_TCP,						\
+		TCP_PKT_ALLOC_TIMEOUT);					\
+									\
+	tp_pkt_alloc(_pkt, tp_basename(__FILE__), __LINE__);		\
+									\
+	_pkt;								\
+})
+#else
+#define tcp_data_pkt_alloc(_conn, _len) tcp_pkt_alloc(_conn, _len)
+#endif
+
 #define tcp_rx_pkt_alloc(_conn, _len)					\
 ({									\
 	struct net_pkt *_pkt;						\
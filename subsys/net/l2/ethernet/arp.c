@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #include "arp.h"
 #include "net_private.h"
+#include "route.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
@@ -338,6 +339,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				struct in_addr *current_ip)
 {
 	bool is_ipv4_ll_used = false;
+	struct in_addr nexthop;
 	struct arp_entry *entry;
 	struct in_addr *addr;
 
@@ -359,7 +361,10 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	    !net_if_ipv4_addr_mask_cmp(net_pkt_iface(pkt), request_ip)) {
 		struct net_if_ipv4 *ipv4 = net_pkt_iface(pkt)->config.ip.ipv4;
 
-		if (ipv4) {
+		if (net_route_ipv4_get_nexthop(net_pkt_iface(pkt), request_ip,
+					       &nexthop) == 0) {
+			addr = &nexthop;
+		} else if (ipv4) {
 			addr = &ipv4->gw;
 			if (net_ipv4_is_addr_unspecified(addr)) {
 				NET_ERR("Gateway not set for iface %p",
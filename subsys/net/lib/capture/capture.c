@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "udp_internal.h"
+#include "capture_internal.h"
 
 #define PKT_ALLOC_TIME K_MSEC(50)
 #define DEFAULT_PORT 4242
@@ -47,6 +48,9 @@ NET_BUF_POOL_VAR_DEFINE(capture_bufs, CONFIG_NET_CAPTURE_BUF_COUNT,
 
 static sys_slist_t net_capture_devlist;
 
+/* Number of enabled capture devices, checked without the lock */
+static atomic_t enabled_count;
+
 struct net_capture {
 	sys_snode_t node;
 
@@ -481,6 +485,7 @@ static int capture_enable(const struct device *dev, struct net_if *iface)
 
 	ctx->capture_iface = iface;
 	ctx->is_enabled = true;
+	atomic_inc(&enabled_count);
 
 	net_if_up(ctx->tunnel_iface);
 
@@ -491,6 +496,10 @@ static int capture_disable(const struct device *dev)
 {
 	struct net_capture *ctx = dev->data;
 
+	if (ctx->is_enabled) {
+		atomic_dec(&enabled_count);
+	}
+
 	ctx->capture_iface = NULL;
 	ctx->is_enabled = false;
 
@@ -499,7 +508,8 @@ static int capture_disable(const struct device *dev)
 	return 0;
 }
 
-void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
+void net_capture_pkt_dir(struct net_if *iface, struct net_pkt *pkt,
+			 enum net_capture_dir dir)
 {
 	struct k_mem_slab *orig_slab;
 	struct net_pkt *captured;
@@ -512,6 +522,14 @@ void net_capture_pkt(struct net_if *iface, struct net_pkt *pkt)
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CAPTURE_RING)) {
+		net_capture_ring_pkt(iface, pkt, dir);
+	}
+
+	if (atomic_get(&enabled_count) == 0) {
+		return;
+	}
+
 	k_mutex_lock(&lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_NODE_SAFE(&net_capture_devlist, sn, sns) {
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __CAPTURE_INTERNAL_H
+#define __CAPTURE_INTERNAL_H
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/capture.h>
+
+/* Store a copy of the packet in the capture ring if it is running */
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt,
+			  enum net_capture_dir dir);
+
+#endif /* __CAPTURE_INTERNAL_H */
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Bottom/Linux side of the capture ring file output for the ARCH_POSIX
+ * architecture
+ */
+
+#undef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "nsi_tracing.h"
+#include "capture_native_bottom.h"
+
+int net_capture_native_open(const char *path)
+{
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (fd < 0) {
+		nsi_print_warning("Cannot open capture file %s (%s)\n", path,
+				  strerror(errno));
+		return -1;
+	}
+
+	return fd;
+}
+
+int net_capture_native_write(int fd, const void *data, size_t len)
+{
+	const char *pos = data;
+	ssize_t ret;
+
+	while (len > 0) {
+		ret = write(fd, pos, len);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if (ret <= 0) {
+			return -1;
+		}
+
+		pos += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+void net_capture_native_close(int fd)
+{
+	(void)close(fd);
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_NET_LIB_CAPTURE_NATIVE_BOTTOM_H
+#define SUBSYS_NET_LIB_CAPTURE_NATIVE_BOTTOM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The functions return -1 on error, host errno values are not usable */
+int net_capture_native_open(const char *path);
+int net_capture_native_write(int fd, const void *data, size_t len);
+void net_capture_native_close(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_NET_LIB_CAPTURE_NATIVE_BOTTOM_H */
@@ -0,0 +1,908 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/capture.h>
+
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
+#if defined(CONFIG_ARCH_POSIX)
+#include "capture_native_bottom.h"
+#endif
+
+#include "capture_internal.h"
+
+/* pcapng block types, see draft-ietf-opsawg-pcapng */
+#define PCAPNG_SHB 0x0a0d0d0aU
+#define PCAPNG_IDB 0x00000001U
+#define PCAPNG_ISB 0x00000005U
+#define PCAPNG_EPB 0x00000006U
+
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1a2b3c4dU
+
+#define PCAPNG_OPT_END              0
+#define PCAPNG_OPT_EPB_FLAGS        2
+#define PCAPNG_OPT_ISB_IFRECV       4
+#define PCAPNG_OPT_ISB_FILTERACCEPT 6
+#define PCAPNG_OPT_ISB_OSDROP       7
+
+#define PCAPNG_EPB_FLAGS_INBOUND  1U
+#define PCAPNG_EPB_FLAGS_OUTBOUND 2U
+
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW      101
+
+/* Interfaces with a bigger index are not captured */
+#define MAX_IFACES 32
+
+#define FILTER_MEM_WORDS 16
+
+/* Packet loads past this offset can never succeed */
+#define FILTER_MAX_OFFSET UINT16_MAX
+
+#define RING_WORDS (CONFIG_NET_CAPTURE_RING_SIZE / sizeof(uint32_t))
+
+/* Captured packet stored in the ring, followed by its data */
+struct capture_record {
+	MPSC_PBUF_HDR;
+	uint32_t wlen: 14;
+	uint32_t caplen: 16;
+	uint32_t orig_len: 16;
+	uint32_t iface: 15;
+	uint32_t outbound: 1;
+	uint32_t ts_low;
+	uint32_t ts_high;
+	uint8_t data[];
+};
+
+BUILD_ASSERT(sizeof(struct capture_record) == 16);
+
+#define MAX_CAPLEN MIN((BIT(14) - 1) * sizeof(uint32_t) - sizeof(struct capture_record), \
+		       CONFIG_NET_CAPTURE_RING_SIZE / 2)
+
+struct pcapng_block_hdr {
+	uint32_t type;
+	uint32_t len;
+};
+
+struct pcapng_shb {
+	struct pcapng_block_hdr hdr;
+	uint32_t magic;
+	uint16_t major;
+	uint16_t minor;
+	int64_t section_len;
+	uint32_t len;
+} __packed;
+
+struct pcapng_idb {
+	struct pcapng_block_hdr hdr;
+	uint16_t linktype;
+	uint16_t reserved;
+	uint32_t snaplen;
+	uint32_t len;
+};
+
+struct pcapng_epb {
+	struct pcapng_block_hdr hdr;
+	uint32_t iface;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t caplen;
+	uint32_t orig_len;
+};
+
+struct pcapng_opt_u32 {
+	uint16_t code;
+	uint16_t len;
+	uint32_t value;
+};
+
+struct pcapng_epb_opts {
+	struct pcapng_opt_u32 flags;
+	uint32_t end;
+};
+
+struct pcapng_opt_u64 {
+	uint16_t code;
+	uint16_t len;
+	uint32_t value[2];
+};
+
+struct pcapng_isb {
+	struct pcapng_block_hdr hdr;
+	uint32_t iface;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	struct pcapng_opt_u64 recv;
+	struct pcapng_opt_u64 accept;
+	struct pcapng_opt_u64 drop;
+	uint32_t end;
+	uint32_t len;
+};
+
+struct capture_sink {
+	net_capture_ring_write_t write;
+	void (*close)(void *user_data);
+	void *user_data;
+};
+
+static uint32_t capture_get_wlen(const union mpsc_pbuf_generic *packet)
+{
+	return ((const struct capture_record *)packet)->wlen;
+}
+
+static uint32_t ring_buf[RING_WORDS];
+
+static const struct mpsc_pbuf_buffer_config ring_config = {
+	.buf = ring_buf,
+	.size = RING_WORDS,
+	.get_wlen = capture_get_wlen,
+	.flags = IS_POWER_OF_TWO(RING_WORDS) ? MPSC_PBUF_SIZE_POW2 : 0,
+};
+
+static struct mpsc_pbuf_buffer ring;
+
+static struct {
+	atomic_t received;
+	atomic_t filtered;
+	atomic_t captured;
+	atomic_t dropped;
+	atomic_t truncated;
+	atomic_t written;
+	atomic_t write_errors;
+} stats;
+
+/* Producers check this flag after registering themselves, so that stopping
+ * the capture can wait for the packets being stored. The last producer to
+ * leave once the capture is stopped gives the semaphore.
+ */
+static atomic_t running;
+static atomic_t producers;
+static K_SEM_DEFINE(producers_done, 0, 1);
+
+static struct net_if *ring_iface;
+static size_t ring_snaplen;
+
+static struct net_capture_filter_insn filter[CONFIG_NET_CAPTURE_RING_FILTER_LEN];
+static size_t filter_len;
+
+/* Only used while draining, protected by the lock */
+static struct capture_sink sink;
+static uint8_t pcapng_ids[MAX_IFACES];
+static uint32_t pcapng_iface_count;
+
+static K_MUTEX_DEFINE(lock);
+
+static void drain_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(drain_work, drain_work_handler);
+
+/* Copy packet data without touching the packet cursor */
+static bool pkt_load(struct net_pkt *pkt, uint32_t offset, void *dst, size_t len)
+{
+	struct net_buf *frag = pkt->buffer;
+
+	/* Fast path, most loads are in the first buffer */
+	if (frag != NULL && offset < frag->len && len <= frag->len - offset) {
+		memcpy(dst, frag->data + offset, len);
+		return true;
+	}
+
+	return net_buf_linearize(dst, len, frag, offset, len) == len;
+}
+
+static uint32_t filter_run(struct net_pkt *pkt, uint32_t pkt_len)
+{
+	uint32_t mem[FILTER_MEM_WORDS];
+	uint32_t a = 0U, x = 0U;
+	uint8_t bytes[4];
+	uint32_t offset;
+	size_t pc;
+
+	for (pc = 0; pc < filter_len; pc++) {
+		const struct net_capture_filter_insn *insn = &filter[pc];
+		uint32_t operand = (insn->code & NET_CAPTURE_BPF_X) ? x : insn->k;
+
+		switch (insn->code & 0x07) {
+		case NET_CAPTURE_BPF_LD:
+		case NET_CAPTURE_BPF_LDX: {
+			uint32_t size = insn->code & 0x18;
+			uint32_t *reg = (insn->code & 0x07) == NET_CAPTURE_BPF_LD ? &a : &x;
+			size_t len = size == NET_CAPTURE_BPF_B ? 1 :
+				     size == NET_CAPTURE_BPF_H ? 2 : 4;
+
+			switch (insn->code & 0xe0) {
+			case NET_CAPTURE_BPF_IMM:
+				*reg = insn->k;
+				continue;
+			case NET_CAPTURE_BPF_MEM:
+				*reg = mem[insn->k];
+				continue;
+			case NET_CAPTURE_BPF_LEN:
+				*reg = pkt_len;
+				continue;
+			case NET_CAPTURE_BPF_MSH:
+				/* IPv4 header length */
+				if (!pkt_load(pkt, insn->k, bytes, 1)) {
+					return 0U;
+				}
+
+				*reg = (bytes[0] & 0x0f) * 4U;
+				continue;
+			case NET_CAPTURE_BPF_IND:
+				offset = x + insn->k;
+				break;
+			default:
+				offset = insn->k;
+				break;
+			}
+
+			if (!pkt_load(pkt, offset, bytes, len)) {
+				return 0U;
+			}
+
+			*reg = len == 1 ? bytes[0] :
+			       len == 2 ? sys_get_be16(bytes) : sys_get_be32(bytes);
+			break;
+		}
+		case NET_CAPTURE_BPF_ST:
+			mem[insn->k] = a;
+			break;
+		case NET_CAPTURE_BPF_STX:
+			mem[insn->k] = x;
+			break;
+		case NET_CAPTURE_BPF_ALU:
+			switch (insn->code & 0xf0) {
+			case NET_CAPTURE_BPF_ADD:
+				a += operand;
+				break;
+			case NET_CAPTURE_BPF_SUB:
+				a -= operand;
+				break;
+			case NET_CAPTURE_BPF_MUL:
+				a *= operand;
+				break;
+			case NET_CAPTURE_BPF_DIV:
+				if (operand == 0U) {
+					return 0U;
+				}
+
+				a /= operand;
+				break;
+			case NET_CAPTURE_BPF_MOD:
+				if (operand == 0U) {
+					return 0U;
+				}
+
+				a %= operand;
+				break;
+			case NET_CAPTURE_BPF_OR:
+				a |= operand;
+				break;
+			case NET_CAPTURE_BPF_AND:
+				a &= operand;
+				break;
+			case NET_CAPTURE_BPF_XOR:
+				a ^= operand;
+				break;
+			case NET_CAPTURE_BPF_LSH:
+				a = operand < 32U ? a << operand : 0U;
+				break;
+			case NET_CAPTURE_BPF_RSH:
+				a = operand < 32U ? a >> operand : 0U;
+				break;
+			case NET_CAPTURE_BPF_NEG:
+				a = -a;
+				break;
+			}
+
+			break;
+		case NET_CAPTURE_BPF_JMP: {
+			bool cond;
+
+			switch (insn->code & 0xf0) {
+			case NET_CAPTURE_BPF_JA:
+				pc += insn->k;
+				continue;
+			case NET_CAPTURE_BPF_JEQ:
+				cond = a == operand;
+				break;
+			case NET_CAPTURE_BPF_JGT:
+				cond = a > operand;
+				break;
+			case NET_CAPTURE_BPF_JGE:
+				cond = a >= operand;
+				break;
+			default:
+				cond = (a & operand) != 0U;
+				break;
+			}
+
+			pc += cond ? insn->jt : insn->jf;
+			break;
+		}
+		case NET_CAPTURE_BPF_RET:
+			return (insn->code & 0x18) == NET_CAPTURE_BPF_A ? a : insn->k;
+		case NET_CAPTURE_BPF_MISC:
+			if (insn->code & NET_CAPTURE_BPF_TXA) {
+				a = x;
+			} else {
+				x = a;
+			}
+
+			break;
+		}
+	}
+
+	/* Not reached, programs are checked to end with a return */
+	return 0U;
+}
+
+static bool filter_insn_valid(const struct net_capture_filter_insn *prog, size_t len,
+			      size_t pc)
+{
+	const struct net_capture_filter_insn *insn = &prog[pc];
+	uint16_t code = insn->code;
+
+	switch (code & 0x07) {
+	case NET_CAPTURE_BPF_LD:
+	case NET_CAPTURE_BPF_LDX:
+		if ((code & 0x07) == NET_CAPTURE_BPF_LDX) {
+			if (code != (NET_CAPTURE_BPF_LDX | NET_CAPTURE_BPF_W | NET_CAPTURE_BPF_IMM) &&
+			    code != (NET_CAPTURE_BPF_LDX | NET_CAPTURE_BPF_W | NET_CAPTURE_BPF_MEM) &&
+			    code != (NET_CAPTURE_BPF_LDX | NET_CAPTURE_BPF_W | NET_CAPTURE_BPF_LEN) &&
+			    code != (NET_CAPTURE_BPF_LDX | NET_CAPTURE_BPF_B | NET_CAPTURE_BPF_MSH)) {
+				return false;
+			}
+		} else if ((code & 0x18) == 0x18 || (code & 0xe0) > NET_CAPTURE_BPF_LEN ||
+			   (code & ~0xf8) != 0) {
+			return false;
+		}
+
+		switch (code & 0xe0) {
+		case NET_CAPTURE_BPF_MEM:
+			return insn->k < FILTER_MEM_WORDS;
+		case NET_CAPTURE_BPF_ABS:
+		case NET_CAPTURE_BPF_IND:
+		case NET_CAPTURE_BPF_MSH:
+			return insn->k <= FILTER_MAX_OFFSET;
+		default:
+			return true;
+		}
+	case NET_CAPTURE_BPF_ST:
+	case NET_CAPTURE_BPF_STX:
+		return (code & ~0x07) == 0 && insn->k < FILTER_MEM_WORDS;
+	case NET_CAPTURE_BPF_ALU:
+		if ((code & 0xf0) > NET_CAPTURE_BPF_XOR || (code & ~0xff) != 0) {
+			return false;
+		}
+
+		/* Constant divisions by zero are rejected upfront */
+		return ((code & 0xf0) != NET_CAPTURE_BPF_DIV &&
+			(code & 0xf0) != NET_CAPTURE_BPF_MOD) ||
+		       (code & NET_CAPTURE_BPF_X) || insn->k != 0U;
+	case NET_CAPTURE_BPF_JMP:
+		if ((code & 0xf0) > NET_CAPTURE_BPF_JSET || (code & ~0xff) != 0) {
+			return false;
+		}
+
+		/* Jumps only go forward, and stay within the program */
+		if ((code & 0xf0) == NET_CAPTURE_BPF_JA) {
+			return insn->k < len - pc - 1;
+		}
+
+		return insn->jt < len - pc - 1 && insn->jf < len - pc - 1;
+	case NET_CAPTURE_BPF_RET:
+		return code == (NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K) ||
+		       code == (NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_A);
+	default:
+		return code == (NET_CAPTURE_BPF_MISC | NET_CAPTURE_BPF_TAX) ||
+		       code == (NET_CAPTURE_BPF_MISC | NET_CAPTURE_BPF_TXA);
+	}
+}
+
+int net_capture_ring_set_filter(const struct net_capture_filter_insn *prog, size_t len)
+{
+	int ret = 0;
+	size_t pc;
+
+	if (prog != NULL) {
+		if (len == 0) {
+			return -EINVAL;
+		}
+
+		if (len > ARRAY_SIZE(filter)) {
+			return -ENOMEM;
+		}
+
+		/* The last instruction must return, so that every path does */
+		if ((prog[len - 1].code & 0x07) != NET_CAPTURE_BPF_RET) {
+			return -EINVAL;
+		}
+
+		for (pc = 0; pc < len; pc++) {
+			if (!filter_insn_valid(prog, len, pc)) {
+				NET_DBG("Invalid filter instruction %zu (0x%04x)", pc,
+					prog[pc].code);
+				return -EINVAL;
+			}
+		}
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (atomic_get(&running)) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	if (prog != NULL) {
+		memcpy(filter, prog, len * sizeof(*prog));
+		filter_len = len;
+	} else {
+		filter_len = 0;
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt,
+			  enum net_capture_dir dir)
+{
+	struct capture_record *record;
+	uint32_t ts = 0U;
+	size_t pkt_len;
+	size_t caplen;
+	int index;
+
+	atomic_inc(&producers);
+
+	if (!atomic_get(&running) || (ring_iface != NULL && ring_iface != iface)) {
+		goto out;
+	}
+
+	index = net_if_get_by_iface(iface);
+	if (index <= 0 || index > MAX_IFACES) {
+		goto out;
+	}
+
+	atomic_inc(&stats.received);
+
+	pkt_len = net_pkt_get_len(pkt);
+	caplen = MIN(pkt_len, ring_snaplen);
+
+	if (filter_len > 0) {
+		ts = filter_run(pkt, pkt_len);
+		if (ts == 0U) {
+			atomic_inc(&stats.filtered);
+			goto out;
+		}
+
+		caplen = MIN(caplen, ts);
+	}
+
+	if (caplen < pkt_len) {
+		atomic_inc(&stats.truncated);
+	}
+
+	record = (struct capture_record *)mpsc_pbuf_alloc(
+		&ring, DIV_ROUND_UP(sizeof(*record) + caplen, sizeof(uint32_t)), K_NO_WAIT);
+	if (record == NULL) {
+		atomic_inc(&stats.dropped);
+		goto out;
+	}
+
+	uint64_t now = k_ticks_to_us_floor64(k_uptime_ticks());
+
+	record->wlen = DIV_ROUND_UP(sizeof(*record) + caplen, sizeof(uint32_t));
+	record->caplen = caplen;
+	record->orig_len = MIN(pkt_len, UINT16_MAX);
+	record->iface = index;
+	record->outbound = (dir == NET_CAPTURE_OUTBOUND);
+	record->ts_low = (uint32_t)now;
+	record->ts_high = (uint32_t)(now >> 32);
+
+	(void)net_buf_linearize(record->data, caplen, pkt->buffer, 0, caplen);
+
+	mpsc_pbuf_commit(&ring, (union mpsc_pbuf_generic *)record);
+	atomic_inc(&stats.captured);
+
+	k_work_schedule(&drain_work, K_MSEC(CONFIG_NET_CAPTURE_RING_DRAIN_DELAY));
+
+out:
+	if (atomic_dec(&producers) == 1 && !atomic_get(&running)) {
+		k_sem_give(&producers_done);
+	}
+}
+
+static void stream_write(const void *data, size_t len)
+{
+	if (sink.write(data, len, sink.user_data) < 0) {
+		atomic_inc(&stats.write_errors);
+	}
+}
+
+static uint32_t pcapng_iface_id(int index)
+{
+	struct net_if *iface = net_if_get_by_index(index);
+	struct pcapng_idb idb = {
+		.hdr.type = PCAPNG_IDB,
+		.hdr.len = sizeof(idb),
+		.linktype = LINKTYPE_RAW,
+		.snaplen = MAX_CAPLEN,
+		.len = sizeof(idb),
+	};
+
+	if (pcapng_ids[index - 1] != 0U) {
+		return pcapng_ids[index - 1] - 1;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	/* Other link layers are captured without their header */
+	if (iface != NULL && net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		idb.linktype = LINKTYPE_ETHERNET;
+	}
+#else
+	ARG_UNUSED(iface);
+#endif
+
+	stream_write(&idb, sizeof(idb));
+
+	pcapng_ids[index - 1] = ++pcapng_iface_count;
+
+	return pcapng_iface_count - 1;
+}
+
+static void write_record(const struct capture_record *record)
+{
+	static const uint8_t padding[sizeof(uint32_t)];
+	size_t padded = ROUND_UP(record->caplen, sizeof(uint32_t));
+	struct pcapng_epb epb = {
+		.hdr.type = PCAPNG_EPB,
+		.hdr.len = sizeof(epb) + padded + sizeof(struct pcapng_epb_opts) +
+			   sizeof(uint32_t),
+		.ts_high = record->ts_high,
+		.ts_low = record->ts_low,
+		.caplen = record->caplen,
+		.orig_len = record->orig_len,
+	};
+	struct pcapng_epb_opts opts = {
+		.flags.code = PCAPNG_OPT_EPB_FLAGS,
+		.flags.len = sizeof(uint32_t),
+		.flags.value = record->outbound ? PCAPNG_EPB_FLAGS_OUTBOUND :
+						  PCAPNG_EPB_FLAGS_INBOUND,
+		.end = PCAPNG_OPT_END,
+	};
+
+	epb.iface = pcapng_iface_id(record->iface);
+
+	stream_write(&epb, sizeof(epb));
+	stream_write(record->data, record->caplen);
+	stream_write(padding, padded - record->caplen);
+	stream_write(&opts, sizeof(opts));
+	stream_write(&epb.hdr.len, sizeof(epb.hdr.len));
+
+	atomic_inc(&stats.written);
+}
+
+static void drain(void)
+{
+	const union mpsc_pbuf_generic *packet;
+
+	while ((packet = mpsc_pbuf_claim(&ring)) != NULL) {
+		write_record((const struct capture_record *)packet);
+		mpsc_pbuf_free(&ring, packet);
+	}
+}
+
+static void drain_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (sink.write != NULL) {
+		drain();
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static void set_opt_u64(struct pcapng_opt_u64 *opt, uint16_t code, uint64_t value)
+{
+	opt->code = code;
+	opt->len = sizeof(uint64_t);
+	memcpy(opt->value, &value, sizeof(value));
+}
+
+/* The statistics only make sense for a single interface */
+static void write_stats(void)
+{
+	uint64_t now = k_ticks_to_us_floor64(k_uptime_ticks());
+	struct pcapng_isb isb = {
+		.hdr.type = PCAPNG_ISB,
+		.hdr.len = sizeof(isb),
+		.ts_high = (uint32_t)(now >> 32),
+		.ts_low = (uint32_t)now,
+		.end = PCAPNG_OPT_END,
+		.len = sizeof(isb),
+	};
+	int index;
+
+	if (ring_iface == NULL) {
+		return;
+	}
+
+	index = net_if_get_by_iface(ring_iface);
+	if (index <= 0 || index > MAX_IFACES) {
+		return;
+	}
+
+	isb.iface = pcapng_iface_id(index);
+
+	set_opt_u64(&isb.recv, PCAPNG_OPT_ISB_IFRECV, atomic_get(&stats.received));
+	set_opt_u64(&isb.accept, PCAPNG_OPT_ISB_FILTERACCEPT,
+		    atomic_get(&stats.received) - atomic_get(&stats.filtered));
+	set_opt_u64(&isb.drop, PCAPNG_OPT_ISB_OSDROP, atomic_get(&stats.dropped));
+
+	stream_write(&isb, sizeof(isb));
+}
+
+static int ring_start(struct net_if *iface, size_t snaplen, const struct capture_sink *new_sink)
+{
+	struct pcapng_shb shb = {
+		.hdr.type = PCAPNG_SHB,
+		.hdr.len = sizeof(shb),
+		.magic = PCAPNG_BYTE_ORDER_MAGIC,
+		.major = 1,
+		.minor = 0,
+		.section_len = -1,
+		.len = sizeof(shb),
+	};
+	int ret;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (atomic_get(&running)) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	ret = new_sink->write(&shb, sizeof(shb), new_sink->user_data);
+	if (ret < 0) {
+		NET_ERR("Cannot write capture header (%d)", ret);
+		goto out;
+	}
+
+	memset(&stats, 0, sizeof(stats));
+	memset(pcapng_ids, 0, sizeof(pcapng_ids));
+	pcapng_iface_count = 0U;
+
+	sink = *new_sink;
+	ring_iface = iface;
+	ring_snaplen = snaplen == 0 ? MAX_CAPLEN : MIN(snaplen, MAX_CAPLEN);
+
+	mpsc_pbuf_init(&ring, &ring_config);
+
+	atomic_set(&running, 1);
+
+	NET_DBG("Capturing %s%d into the ring, snaplen %zu",
+		iface ? "interface " : "all interfaces", net_if_get_by_iface(iface),
+		ring_snaplen);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int net_capture_ring_start(struct net_if *iface, size_t snaplen,
+			   net_capture_ring_write_t write, void *user_data)
+{
+	const struct capture_sink new_sink = {
+		.write = write,
+		.user_data = user_data,
+	};
+
+	if (write == NULL) {
+		return -EINVAL;
+	}
+
+	return ring_start(iface, snaplen, &new_sink);
+}
+
+int net_capture_ring_stop(void)
+{
+	struct k_work_sync sync;
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	k_sem_reset(&producers_done);
+
+	if (!atomic_cas(&running, 1, 0)) {
+		k_mutex_unlock(&lock);
+		return -EALREADY;
+	}
+
+	/* Let the packets being stored reach the ring. Producers do not take
+	 * the lock, a lower priority one can finish while we wait.
+	 */
+	while (atomic_get(&producers) > 0) {
+		(void)k_sem_take(&producers_done, K_FOREVER);
+	}
+
+	k_mutex_unlock(&lock);
+
+	(void)k_work_cancel_delayable_sync(&drain_work, &sync);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	drain();
+	write_stats();
+
+	if (atomic_get(&stats.write_errors) > 0) {
+		ret = -EIO;
+	}
+
+	if (sink.close != NULL) {
+		sink.close(sink.user_data);
+	}
+
+	sink.write = NULL;
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void net_capture_ring_get_stats(struct net_capture_ring_stats *ring_stats)
+{
+	ring_stats->received = atomic_get(&stats.received);
+	ring_stats->filtered = atomic_get(&stats.filtered);
+	ring_stats->captured = atomic_get(&stats.captured);
+	ring_stats->dropped = atomic_get(&stats.dropped);
+	ring_stats->truncated = atomic_get(&stats.truncated);
+	ring_stats->written = atomic_get(&stats.written);
+	ring_stats->write_errors = atomic_get(&stats.write_errors);
+}
+
+#if defined(CONFIG_FILE_SYSTEM)
+static struct fs_file_t capture_file;
+
+static int file_write(const void *data, size_t len, void *user_data)
+{
+	ssize_t ret = fs_write(user_data, data, len);
+
+	return ret == len ? 0 : (ret < 0 ? ret : -ENOSPC);
+}
+
+static void file_close(void *user_data)
+{
+	(void)fs_close(user_data);
+}
+
+int net_capture_ring_start_file(struct net_if *iface, size_t snaplen, const char *path)
+{
+	const struct capture_sink new_sink = {
+		.write = file_write,
+		.close = file_close,
+		.user_data = &capture_file,
+	};
+	int ret;
+
+	/* The file is in use until the capture is stopped */
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (atomic_get(&running)) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	fs_file_t_init(&capture_file);
+
+	ret = fs_open(&capture_file, path, FS_O_CREATE | FS_O_WRITE);
+	if (ret < 0) {
+		NET_ERR("Cannot open %s (%d)", path, ret);
+		goto out;
+	}
+
+	ret = fs_truncate(&capture_file, 0);
+	if (ret == 0) {
+		ret = ring_start(iface, snaplen, &new_sink);
+	}
+
+	if (ret < 0) {
+		(void)fs_close(&capture_file);
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+#else
+int net_capture_ring_start_file(struct net_if *iface, size_t snaplen, const char *path)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(snaplen);
+	ARG_UNUSED(path);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
+#if defined(CONFIG_ARCH_POSIX)
+static int host_write(const void *data, size_t len, void *user_data)
+{
+	if (net_capture_native_write(POINTER_TO_INT(user_data), data, len) < 0) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void host_close(void *user_data)
+{
+	net_capture_native_close(POINTER_TO_INT(user_data));
+}
+
+int net_capture_ring_start_host(struct net_if *iface, size_t snaplen, const char *path)
+{
+	struct capture_sink new_sink = {
+		.write = host_write,
+		.close = host_close,
+	};
+	int ret;
+	int fd;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (atomic_get(&running)) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	fd = net_capture_native_open(path);
+	if (fd < 0) {
+		ret = -EIO;
+		goto out;
+	}
+
+	new_sink.user_data = INT_TO_POINTER(fd);
+
+	ret = ring_start(iface, snaplen, &new_sink);
+	if (ret < 0) {
+		net_capture_native_close(fd);
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+#else
+int net_capture_ring_start_host(struct net_if *iface, size_t snaplen, const char *path)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(snaplen);
+	ARG_UNUSED(path);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_ARCH_POSIX */
@@ -16,6 +16,7 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/net/coap_link_format.h>
 #include <zephyr/net/coap_mgmt.h>
 #include <zephyr/net/coap_service.h>
+#include <zephyr/sys/byteorder.h>
 #ifdef CONFIG_ARCH_POSIX
 #include <fcntl.h>
 #else
@@ -85,6 +86,180 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+#if defined(CONFIG_COAP_SERVER_RESOURCE_TRIE)
+struct coap_path_node {
+	struct coap_path_node *child;
+	struct coap_path_node *sibling;
+	/* First resource, in definition order, with the path ending here */
+	struct coap_resource *resource;
+	const char *segment;
+	uint8_t len;
+	/* '+', '#' or 0 if the segment isn't a wildcard */
+	char wildcard;
+};
+
+/* Tries are built once per service and never released, resources are static */
+static struct coap_path_node path_nodes[CONFIG_COAP_SERVER_RESOURCE_TRIE_NODES];
+static size_t path_nodes_used;
+
+static struct coap_path_node *coap_path_node_alloc(const char *segment, size_t len)
+{
+	struct coap_path_node *node;
+
+	if (path_nodes_used == ARRAY_SIZE(path_nodes)) {
+		return NULL;
+	}
+
+	node = &path_nodes[path_nodes_used++];
+	memset(node, 0, sizeof(*node));
+
+	node->segment = segment;
+	node->len = len;
+
+	if (IS_ENABLED(CONFIG_COAP_URI_WILDCARD) && len == 1 &&
+	    (*segment == '+' || *segment == '#')) {
+		node->wildcard = *segment;
+	}
+
+	return node;
+}
+
+static int coap_path_trie_insert(struct coap_path_node *root, struct coap_resource *resource)
+{
+	struct coap_path_node *node = root;
+	struct coap_path_node *child;
+
+	for (const char * const *segment = resource->path; *segment != NULL; segment++) {
+		size_t len = strlen(*segment);
+
+		/* An URI path option can't be longer, the path never matches */
+		if (len > UINT8_MAX) {
+			return 0;
+		}
+
+		for (child = node->child; child != NULL; child = child->sibling) {
+			if (child->len == len && memcmp(child->segment, *segment, len) == 0) {
+				break;
+			}
+		}
+
+		if (child == NULL) {
+			child = coap_path_node_alloc(*segment, len);
+			if (child == NULL) {
+				return -ENOMEM;
+			}
+
+			child->sibling = node->child;
+			node->child = child;
+		}
+
+		node = child;
+
+		/* The segments after a multi-level wildcard are never compared */
+		if (node->wildcard == '#') {
+			break;
+		}
+	}
+
+	if (node->resource == NULL) {
+		node->resource = resource;
+	}
+
+	return 0;
+}
+
+static void coap_path_trie_build(const struct coap_service *service)
+{
+	size_t used = path_nodes_used;
+	struct coap_path_node *root;
+	int ret;
+
+	if (service->data->path_trie != NULL) {
+		return;
+	}
+
+	root = coap_path_node_alloc(NULL, 0);
+	if (root == NULL) {
+		goto fail;
+	}
+
+	COAP_SERVICE_FOREACH_RESOURCE(service, it) {
+		if (it->path == NULL) {
+			continue;
+		}
+
+		ret = coap_path_trie_insert(root, it);
+		if (ret < 0) {
+			goto fail;
+		}
+	}
+
+	service->data->path_trie = root;
+
+	return;
+
+fail:
+	path_nodes_used = used;
+
+	LOG_WRN("Not enough path trie nodes for %s, increase "
+		"CONFIG_COAP_SERVER_RESOURCE_TRIE_NODES", service->name);
+}
+
+static void coap_path_trie_match(const struct coap_path_node *node,
+				 const struct coap_option **segments, size_t count,
+				 struct coap_resource **match)
+{
+	const struct coap_path_node *child;
+
+	if (count == 0) {
+		if (node->resource != NULL && (*match == NULL || node->resource < *match)) {
+			*match = node->resource;
+		}
+
+		return;
+	}
+
+	/* Wildcards can match as well, keep the resource defined first like a linear search */
+	for (child = node->child; child != NULL; child = child->sibling) {
+		switch (child->wildcard) {
+		case '#':
+			if (*match == NULL || child->resource < *match) {
+				*match = child->resource;
+			}
+			break;
+		case '+':
+			coap_path_trie_match(child, segments + 1, count - 1, match);
+			break;
+		default:
+			if (child->len == segments[0]->len &&
+			    memcmp(child->segment, segments[0]->value, child->len) == 0) {
+				coap_path_trie_match(child, segments + 1, count - 1, match);
+			}
+			break;
+		}
+	}
+}
+
+static struct coap_resource *coap_path_trie_lookup(const struct coap_service *service,
+						   struct coap_option *options,
+						   uint8_t opt_num)
+{
+	const struct coap_option *segments[MAX_OPTIONS];
+	struct coap_resource *match = NULL;
+	size_t count = 0;
+
+	for (uint8_t i = 0; i < opt_num && count < ARRAY_SIZE(segments); i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			segments[count++] = &options[i];
+		}
+	}
+
+	coap_path_trie_match(service->data->path_trie, segments, count, &match);
+
+	return match;
+}
+#endif /* CONFIG_COAP_SERVER_RESOURCE_TRIE */
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
@@ -142,8 +317,6 @@ static int coap_server_process(int sock_fd)
 
 	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
 				  &client_addr_len);
-	__ASSERT_NO_MSG(received <= sizeof(buf));
-
 	if (received < 0) {
 		if (errno == EWOULDBLOCK) {
 			return 0;
@@ -153,6 +326,8 @@ static int coap_server_process(int sock_fd)
 		return -errno;
 	}
 
+	__ASSERT_NO_MSG(received <= sizeof(buf));
+
 	ret = coap_packet_parse(&request, buf, received, options, opt_num);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
@@ -218,8 +393,17 @@ static int coap_server_process(int sock_fd)
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
 	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
+		struct coap_resource *resources = service->res_begin;
+		size_t resources_len = COAP_SERVICE_RESOURCE_COUNT(service);
+
+#if defined(CONFIG_COAP_SERVER_RESOURCE_TRIE)
+		if (service->data->path_trie != NULL) {
+			resources = coap_path_trie_lookup(service, options, opt_num);
+			resources_len = (resources == NULL) ? 0 : 1;
+		}
+#endif
+
+		ret = coap_handle_request_len(&request, resources, resources_len,
 					      options, opt_num, &client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
@@ -445,6 +629,10 @@ int coap_service_start(const struct coap_service *service)
 		goto close;
 	}
 
+#if defined(CONFIG_COAP_SERVER_RESOURCE_TRIE)
+	coap_path_trie_build(service);
+#endif
+
 	if (*service->port == 0) {
 		/* ephemeral port - read back the port number */
 		len = sizeof(addr_storage);
@@ -523,6 +711,51 @@ int coap_service_is_running(const struct coap_service *service)
 	return ret;
 }
 
+/* Track a confirmable message for retransmission, the caller must hold the lock */
+static bool coap_service_add_pending(const struct coap_service *service,
+				     const struct iovec *iov, size_t iovcnt,
+				     const struct sockaddr *addr,
+				     const struct coap_transmission_parameters *params)
+{
+	struct coap_pending *pending;
+	struct coap_packet cpkt = { 0 };
+	size_t len = 0;
+	int ret;
+
+	pending = coap_pending_next_unused(service->data->pending, MAX_PENDINGS);
+	if (pending == NULL) {
+		LOG_WRN("No pending message available for %s", service->name);
+		return false;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		len += iov[i].iov_len;
+	}
+
+	cpkt.data = coap_server_alloc(len);
+	if (cpkt.data == NULL) {
+		LOG_WRN("Failed to allocate pending message data for %s", service->name);
+		return false;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		memcpy(cpkt.data + cpkt.offset, iov[i].iov_base, iov[i].iov_len);
+		cpkt.offset += iov[i].iov_len;
+	}
+	cpkt.max_len = len;
+
+	ret = coap_pending_init(pending, &cpkt, addr, params);
+	if (ret < 0) {
+		LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
+		coap_server_free(cpkt.data);
+		return false;
+	}
+
+	coap_pending_cycle(pending);
+
+	return true;
+}
+
 int coap_service_send(const struct coap_service *service, const struct coap_packet *cpkt,
 		      const struct sockaddr *addr, socklen_t addr_len,
 		      const struct coap_transmission_parameters *params)
@@ -546,36 +779,17 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 	 * try to send.
 	 */
 	if (coap_header_get_type(cpkt) == COAP_TYPE_CON) {
-		struct coap_pending *pending = coap_pending_next_unused(service->data->pending,
-									MAX_PENDINGS);
-
-		if (pending == NULL) {
-			LOG_WRN("No pending message available for %s", service->name);
-			goto send;
+		struct iovec iov = {
+			.iov_base = cpkt->data,
+			.iov_len = cpkt->offset,
+		};
+
+		if (coap_service_add_pending(service, &iov, 1, addr, params)) {
+			/* Trigger event in receive loop to schedule retransmit */
+			coap_server_update_services();
 		}
-
-		ret = coap_pending_init(pending, cpkt, addr, params);
-		if (ret < 0) {
-			LOG_WRN("Failed to init pending message for %s (%d)", service->name, ret);
-			goto send;
-		}
-
-		/* Replace tracked data with our allocated copy */
-		pending->data = coap_server_alloc(pending->len);
-		if (pending->data == NULL) {
-			LOG_WRN("Failed to allocate pending message data for %s", service->name);
-			coap_pending_clear(pending);
-			goto send;
-		}
-		memcpy(pending->data, cpkt->data, pending->len);
-
-		coap_pending_cycle(pending);
-
-		/* Trigger event in receive loop to schedule retransmit */
-		coap_server_update_services();
 	}
 
-send:
 	(void)k_mutex_unlock(&lock);
 
 	ret = zsock_sendto(service->data->sock_fd, cpkt->data, cpkt->offset, 0, addr, addr_len);
@@ -602,6 +816,96 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 	return -ENOENT;
 }
 
+int coap_resource_send_notification(struct coap_resource *resource,
+				    const struct coap_packet *cpkt,
+				    const struct coap_transmission_parameters *params)
+{
+	const struct coap_service *service = NULL;
+	uint8_t hdr[COAP_TOKEN_MAX_LEN + 4U];
+	struct iovec iov[2];
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	struct coap_observer *observer;
+	bool confirmable;
+	bool pending = false;
+	int sent = 0;
+	int ret;
+
+	if (cpkt->hdr_len < 4U || cpkt->offset < cpkt->hdr_len) {
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	confirmable = coap_header_get_type(cpkt) == COAP_TYPE_CON;
+
+	/* Version, type and code are shared, the token length is patched */
+	hdr[0] = cpkt->data[0] & 0xf0;
+	hdr[1] = cpkt->data[1];
+
+	/* Options and payload are sent from the caller's buffer for every observer */
+	iov[0].iov_base = hdr;
+	iov[1].iov_base = cpkt->data + cpkt->hdr_len;
+	iov[1].iov_len = cpkt->offset - cpkt->hdr_len;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		sent = -EBADF;
+		goto unlock;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, observer, list) {
+		hdr[0] = (cpkt->data[0] & 0xf0) | observer->tkl;
+		sys_put_be16(coap_next_id(), &hdr[2]);
+		memcpy(&hdr[4], observer->token, observer->tkl);
+		iov[0].iov_len = 4U + observer->tkl;
+
+		msg.msg_name = &observer->addr;
+		msg.msg_namelen = ADDRLEN(&observer->addr);
+
+		if (confirmable) {
+			if (coap_service_add_pending(service, iov, ARRAY_SIZE(iov),
+						     &observer->addr, params)) {
+				pending = true;
+			} else {
+				/* It could not be retransmitted, so do not ask for an ACK */
+				hdr[0] = (hdr[0] & 0xcf) | (COAP_TYPE_NON_CON << 4);
+			}
+		}
+
+		ret = zsock_sendmsg(service->data->sock_fd, &msg, 0);
+		if (ret < 0) {
+			LOG_ERR("Failed to send CoAP notification (%d)", -errno);
+			continue;
+		}
+
+		sent++;
+	}
+
+	if (pending) {
+		/* Trigger event in receive loop to schedule retransmits */
+		coap_server_update_services();
+	}
+
+unlock:
+	(void)k_mutex_unlock(&lock);
+
+	return sent;
+}
+
 int coap_resource_parse_observe(struct coap_resource *resource, const struct coap_packet *request,
 				const struct sockaddr *addr)
 {
@@ -0,0 +1,214 @@
+/** @file
+ * @brief DNS resolver cache
+ *
+ * Positive and negative answers are kept for the time given by their
+ * TTL, limited by CONFIG_DNS_RESOLVER_CACHE_MAX_TTL.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+
+#include <zephyr/net/dns_resolve.h>
+#include "dns_cache.h"
+
+struct dns_cache_entry {
+	/** Resolved addresses, none for a negative answer */
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+
+	/** Uptime in milliseconds when the entry expires */
+	int64_t expiry;
+
+	/** Query type */
+	enum dns_query_type type;
+
+	/** Number of addresses in info */
+	uint8_t count;
+
+	/** Is this entry in use */
+	bool in_use;
+
+	/** Name that was resolved */
+	char query[CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN + 1];
+};
+
+static struct dns_cache_entry cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+static struct dns_resolve_cache_stats cache_stats;
+
+static K_MUTEX_DEFINE(lock);
+
+/* Must be invoked with the lock held */
+static struct dns_cache_entry *cache_get(const char *query,
+					 enum dns_query_type type,
+					 int64_t now)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!cache[i].in_use) {
+			continue;
+		}
+
+		if (cache[i].expiry <= now) {
+			cache[i].in_use = false;
+			continue;
+		}
+
+		/* DNS names are case insensitive, RFC 4343 */
+		if (cache[i].type == type &&
+		    strncasecmp(cache[i].query, query,
+				sizeof(cache[i].query)) == 0) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, size_t *count)
+{
+	struct dns_cache_entry *entry;
+	int ret;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	entry = cache_get(query, type, k_uptime_get());
+	if (!entry) {
+		cache_stats.misses++;
+		ret = -ENOENT;
+		goto out;
+	}
+
+	if (entry->count == 0U) {
+		cache_stats.negative_hits++;
+		*count = 0;
+		ret = DNS_EAI_NODATA;
+		goto out;
+	}
+
+	cache_stats.hits++;
+
+	*count = MIN(*count, entry->count);
+	memcpy(info, entry->info, *count * sizeof(*info));
+	ret = 0;
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, size_t count,
+		   uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	size_t len = strlen(query);
+	int64_t now;
+	int i;
+
+	if (len > CONFIG_DNS_RESOLVER_CACHE_MAX_NAME_LEN) {
+		return;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+	if (ttl == 0U) {
+		/* RFC 1035 ch 3.2.1, zero TTL answers must not be cached */
+		return;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	now = k_uptime_get();
+
+	entry = cache_get(query, type, now);
+	if (!entry) {
+		/* Use a free slot, or replace the entry expiring first */
+		for (i = 0; i < ARRAY_SIZE(cache); i++) {
+			if (!cache[i].in_use) {
+				entry = &cache[i];
+				break;
+			}
+
+			if (!entry || cache[i].expiry < entry->expiry) {
+				entry = &cache[i];
+			}
+		}
+
+		if (entry->in_use) {
+			NET_DBG("Evicting %s from DNS cache", entry->query);
+			cache_stats.evictions++;
+		}
+	}
+
+	count = MIN(count, ARRAY_SIZE(entry->info));
+
+	memcpy(entry->query, query, len + 1);
+	entry->type = type;
+	entry->count = count;
+	entry->expiry = now + (int64_t)ttl * MSEC_PER_SEC;
+	entry->in_use = true;
+
+	if (count > 0) {
+		memcpy(entry->info, info, count * sizeof(*info));
+	}
+
+	cache_stats.inserts++;
+
+	NET_DBG("Cached %s type %d, %zu addresses, ttl %u s", query, type,
+		count, ttl);
+
+	k_mutex_unlock(&lock);
+}
+
+int dns_resolve_cache_stats_get(struct dns_resolve_cache_stats *stats)
+{
+	int64_t now;
+	int i;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	*stats = cache_stats;
+	stats->entries = 0U;
+	stats->max_entries = ARRAY_SIZE(cache);
+
+	now = k_uptime_get();
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].in_use && cache[i].expiry > now) {
+			stats->entries++;
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+void dns_resolve_cache_flush(void)
+{
+	int i;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		cache[i].in_use = false;
+	}
+
+	k_mutex_unlock(&lock);
+}
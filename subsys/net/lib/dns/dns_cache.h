@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DNS_CACHE_H_
+#define DNS_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/net/dns_resolve.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/**
+ * @brief Find a cached answer.
+ *
+ * @param query Name to resolve.
+ * @param type Query type.
+ * @param info Addresses of a positive answer are stored here.
+ * @param count In: size of @p info, out: number of addresses stored.
+ *
+ * @return 0 for a positive answer, DNS_EAI_NODATA for a negative answer,
+ *         -ENOENT if there is no valid entry.
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, size_t *count);
+
+/**
+ * @brief Store an answer in the cache.
+ *
+ * @param query Name that was resolved.
+ * @param type Query type.
+ * @param info Resolved addresses, NULL for a negative answer.
+ * @param count Number of addresses in @p info, 0 for a negative answer.
+ * @param ttl Time to live of the answer in seconds.
+ */
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, size_t count,
+		   uint32_t ttl);
+#else
+#define dns_cache_find(query, type, info, count) (-ENOENT)
+#define dns_cache_add(query, type, info, count, ttl)
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DNS_CACHE_H_ */
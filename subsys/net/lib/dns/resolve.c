@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include <zephyr/net/dns_resolve.h>
 #include "dns_pack.h"
 #include "dns_internal.h"
+#include "dns_cache.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -460,6 +461,21 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+/* A NOERROR response without answers tells that the name exists but has
+ * no records of the queried type, RFC 2308 ch 2.2.
+ */
+static bool dns_is_nodata_response(struct dns_msg_t *dns_msg, uint16_t dns_id)
+{
+	uint8_t *hdr = dns_msg->msg;
+
+	return dns_id > 0 && dns_msg->msg_size >= DNS_MSG_HEADER_SIZE &&
+	       dns_header_opcode(hdr) == DNS_QUERY &&
+	       dns_header_z(hdr) == 0 &&
+	       dns_header_rcode(hdr) == DNS_HEADER_NOERROR &&
+	       dns_header_qdcount(hdr) == 1 &&
+	       dns_header_ancount(hdr) == 0;
+}
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -473,6 +489,10 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 {
 	struct dns_addrinfo info = { 0 };
 	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_addrinfo answers[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+	uint32_t min_ttl = UINT32_MAX;
+#endif
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -510,7 +530,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 	}
 
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
-	if (ret < 0) {
+	if (ret < 0 && !dns_is_nodata_response(dns_msg, *dns_id)) {
 		ret = DNS_EAI_FAIL;
 		goto quit;
 	}
@@ -556,6 +576,11 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 			goto quit;
 		}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+		/* A CNAME is valid only as long as the answers it points to */
+		min_ttl = MIN(min_ttl, ttl);
+#endif
+
 		switch (dns_msg->response_type) {
 		case DNS_RESPONSE_IP:
 			if (*query_idx >= 0) {
@@ -635,6 +660,12 @@ query_known:
 
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+			if (items < ARRAY_SIZE(answers)) {
+				answers[items] = info;
+			}
+#endif
 			items++;
 			break;
 
@@ -706,6 +737,24 @@ query_known:
 		ret = DNS_EAI_ALLDONE;
 	}
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (ctx->queries[*query_idx].query != NULL) {
+		if (items > 0) {
+			dns_cache_add(ctx->queries[*query_idx].query,
+				      ctx->queries[*query_idx].query_type,
+				      answers, MIN(items, ARRAY_SIZE(answers)),
+				      min_ttl);
+		} else if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NOERROR ||
+			   dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+			/* Server failures are not cached, RFC 2308 ch 7.1 */
+			dns_cache_add(ctx->queries[*query_idx].query,
+				      ctx->queries[*query_idx].query_type,
+				      NULL, 0,
+				      CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+	}
+#endif
+
 quit:
 	return ret;
 }
@@ -719,7 +768,7 @@ static int dns_read(struct dns_resolve_context *ctx,
 		    uint16_t *query_hash)
 {
 	/* Helper struct to track the dns msg received from the server */
-	struct dns_msg_t dns_msg;
+	struct dns_msg_t dns_msg = { 0 };
 	int data_len;
 	int ret;
 	int query_idx = -1;
@@ -1107,6 +1156,41 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+/* Returns 0 if the query was answered from the cache */
+static int dns_resolve_from_cache(const char *query, enum dns_query_type type,
+				  dns_resolve_cb_t cb, void *user_data)
+{
+	struct dns_addrinfo info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES];
+	size_t count = ARRAY_SIZE(info);
+	int ret, i;
+
+	if (type != DNS_QUERY_TYPE_A && type != DNS_QUERY_TYPE_AAAA) {
+		return -ENOENT;
+	}
+
+	ret = dns_cache_find(query, type, info, &count);
+	if (ret == -ENOENT) {
+		return ret;
+	}
+
+	NET_DBG("Query %s type %d answered from cache (%d)", query, type, ret);
+
+	if (ret < 0) {
+		cb(ret, NULL, user_data);
+		return 0;
+	}
+
+	for (i = 0; i < count; i++) {
+		cb(DNS_EAI_INPROGRESS, &info[i], user_data);
+	}
+
+	cb(DNS_EAI_ALLDONE, NULL, user_data);
+
+	return 0;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 int dns_resolve_name(struct dns_resolve_context *ctx,
 		     const char *query,
 		     enum dns_query_type type,
@@ -1184,6 +1268,16 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	if (dns_resolve_from_cache(query, type, cb, user_data) == 0) {
+		if (dns_id) {
+			*dns_id = 0U;
+		}
+
+		return 0;
+	}
+#endif
+
 	k_mutex_lock(&ctx->lock, K_FOREVER);
 
 	if (ctx->state != DNS_RESOLVE_CONTEXT_ACTIVE) {
@@ -1473,6 +1567,9 @@ int dns_resolve_reconfigure(struct dns_resolve_context *ctx,
 		}
 	}
 
+	/* The cached answers came from the old servers */
+	dns_resolve_cache_flush();
+
 	err = dns_resolve_init_locked(ctx, servers, servers_sa);
 
 unlock:
@@ -0,0 +1,968 @@
+/** @file
+ * @brief HTTP/1.1 server
+ *
+ * The listening sockets and the client connections are monitored by the
+ * socket service, so the server does not need a thread of its own. The
+ * requests are parsed with http_parser as the data arrives and each
+ * request is answered as soon as it is complete, which keeps pipelined
+ * responses in order.
+ *
+ * The responses are sent without blocking. What the socket does not take
+ * is kept in the client context and sent when the socket is writable
+ * again. Meanwhile the client is not polled for input and its parser is
+ * paused, the following requests stay in the socket until the response
+ * is sent.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
+#include <zephyr/net/http/parser.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/http/status.h>
+
+#define MAX_SERVICES CONFIG_HTTP_SERVER_MAX_SERVICES
+#define MAX_CLIENTS CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define SOCK_COUNT (MAX_SERVICES + MAX_CLIENTS)
+
+/* Status line and the headers of a response */
+#define RESPONSE_HEADER_LEN 192
+
+/* Hexadecimal chunk size and CRLF */
+#define CHUNK_HEADER_LEN (sizeof(size_t) * 2 + 2 + 1)
+
+#define INACTIVITY_TIMEOUT K_SECONDS(CONFIG_HTTP_SERVER_CLIENT_INACTIVITY_TIMEOUT)
+
+BUILD_ASSERT(CONFIG_HTTP_SERVER_CLIENT_OUTPUT_BUFFER_SIZE >
+	     RESPONSE_HEADER_LEN + CHUNK_HEADER_LEN + 2,
+	     "Output buffer does not fit the response headers and a chunk");
+
+struct http_client_ctx {
+	/** Client socket, -1 if not in use */
+	int fd;
+
+	/** Service the client connected to */
+	const struct http_service_desc *service;
+
+	/** Resource of the current request */
+	const struct http_resource_detail *detail;
+
+	/** Request parser */
+	struct http_parser parser;
+
+	/** Closes idle connections */
+	struct k_work_delayable inactivity_timer;
+
+	/** Error status to respond with, 0 if the request is ok */
+	uint16_t status;
+
+	/** Length of the request URL */
+	uint16_t url_len;
+
+	/** The dynamic resource callback has been given request data */
+	bool body_started;
+
+	/** Close the connection after the response */
+	bool close;
+
+	/** The dynamic resource callback has more response data */
+	bool dynamic;
+
+	/** The headers of the dynamic response are in the output buffer */
+	bool dynamic_started;
+
+	/** Length of the data in the output buffer */
+	uint16_t out_len;
+
+	/** Part of the output buffer already sent */
+	uint16_t out_sent;
+
+	/** Static content sent after the output buffer */
+	const uint8_t *body;
+
+	/** Length of the static content not sent yet */
+	size_t body_len;
+
+	/** URL of the current request */
+	char url[CONFIG_HTTP_SERVER_MAX_URL_LENGTH + 1];
+
+	/** Response headers, chunks of dynamic responses and errors */
+	uint8_t out_buf[CONFIG_HTTP_SERVER_CLIENT_OUTPUT_BUFFER_SIZE];
+};
+
+static struct http_server_ctx {
+	/** Listening sockets first, then the client sockets */
+	struct zsock_pollfd fds[SOCK_COUNT];
+
+	/** Service of each listening socket */
+	const struct http_service_desc *services[MAX_SERVICES];
+
+	/** Client connections, same order as the client sockets */
+	struct http_client_ctx clients[MAX_CLIENTS];
+
+	/** Receive buffer, the socket service serves one socket at a time */
+	uint8_t recv_buf[CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE];
+
+	bool running;
+} server;
+
+static K_MUTEX_DEFINE(server_lock);
+
+static void http_server_cb(struct k_work *work);
+
+NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(svc_http, NULL, http_server_cb,
+				      SOCK_COUNT);
+
+static const char *status_str(uint16_t status)
+{
+	switch (status) {
+	case HTTP_200_OK:
+		return "OK";
+	case HTTP_400_BAD_REQUEST:
+		return "Bad Request";
+	case HTTP_404_NOT_FOUND:
+		return "Not Found";
+	case HTTP_405_METHOD_NOT_ALLOWED:
+		return "Method Not Allowed";
+	case HTTP_414_URI_TOO_LONG:
+		return "URI Too Long";
+	case HTTP_503_SERVICE_UNAVAILABLE:
+		return "Service Unavailable";
+	default:
+		return "Internal Server Error";
+	}
+}
+
+static void update_poll_fds(void)
+{
+	(void)net_socket_service_register(&svc_http, server.fds,
+					  ARRAY_SIZE(server.fds), NULL);
+}
+
+/* Must be invoked with the server lock held */
+static void close_client(struct http_client_ctx *client)
+{
+	int idx = client - server.clients;
+	int i;
+
+	(void)k_work_cancel_delayable(&client->inactivity_timer);
+
+	if (client->body_started) {
+		const struct http_resource_detail_dynamic *dynamic =
+			(const struct http_resource_detail_dynamic *)client->detail;
+
+		(void)dynamic->cb(client, HTTP_SERVER_DATA_ABORTED, NULL, 0,
+				  dynamic->user_data);
+		client->body_started = false;
+	}
+
+	NET_DBG("Closing client %d (fd %d)", idx, client->fd);
+
+	(void)zsock_close(client->fd);
+	client->fd = -1;
+	client->dynamic = false;
+	client->out_len = 0U;
+	client->out_sent = 0U;
+	client->body_len = 0U;
+	server.fds[MAX_SERVICES + idx].fd = -1;
+	server.fds[MAX_SERVICES + idx].events = ZSOCK_POLLIN;
+
+	/* Resume accepting if it was paused */
+	for (i = 0; i < MAX_SERVICES; i++) {
+		server.fds[i].events = ZSOCK_POLLIN;
+	}
+
+	update_poll_fds();
+}
+
+static void client_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct http_client_ctx *client =
+		CONTAINER_OF(dwork, struct http_client_ctx, inactivity_timer);
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	if (client->fd >= 0) {
+		NET_DBG("Client %d inactive", client->fd);
+		close_client(client);
+	}
+
+	k_mutex_unlock(&server_lock);
+}
+
+/* Poll the client for output space while a response is pending, for
+ * input otherwise.
+ */
+static void client_wait_output(struct http_client_ctx *client, bool wait)
+{
+	struct zsock_pollfd *pfd = &server.fds[MAX_SERVICES +
+					       (client - server.clients)];
+	short events = wait ? ZSOCK_POLLOUT : ZSOCK_POLLIN;
+
+	if (pfd->events != events) {
+		pfd->events = events;
+		update_poll_fds();
+	}
+}
+
+/* Send as much of the pending response as the socket takes */
+static int client_flush(struct http_client_ctx *client)
+{
+	struct iovec iov[2];
+	struct msghdr msg = {
+		.msg_iov = iov,
+	};
+	ssize_t sent;
+	size_t len;
+
+	while (client->out_sent < client->out_len || client->body_len > 0U) {
+		msg.msg_iovlen = 0;
+
+		if (client->out_sent < client->out_len) {
+			iov[msg.msg_iovlen].iov_base =
+				client->out_buf + client->out_sent;
+			iov[msg.msg_iovlen++].iov_len =
+				client->out_len - client->out_sent;
+		}
+
+		if (client->body_len > 0U) {
+			iov[msg.msg_iovlen].iov_base = (void *)client->body;
+			iov[msg.msg_iovlen++].iov_len = client->body_len;
+		}
+
+		sent = zsock_sendmsg(client->fd, &msg, ZSOCK_MSG_DONTWAIT);
+		if (sent < 0) {
+			return -errno;
+		}
+
+		len = MIN(sent, client->out_len - client->out_sent);
+		client->out_sent += len;
+		sent -= len;
+
+		client->body += sent;
+		client->body_len -= sent;
+	}
+
+	client->out_len = 0U;
+	client->out_sent = 0U;
+
+	return 0;
+}
+
+static int header_append(char *buf, int len, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if (len < 0) {
+		return len;
+	}
+
+	va_start(ap, fmt);
+	ret = vsnprintk(buf + len, RESPONSE_HEADER_LEN - len, fmt, ap);
+	va_end(ap);
+
+	if (ret < 0 || ret >= RESPONSE_HEADER_LEN - len) {
+		return -ENOMEM;
+	}
+
+	return len + ret;
+}
+
+static int response_header(struct http_client_ctx *client, char *buf,
+			   uint16_t status, const char *length_header)
+{
+	const struct http_resource_detail *detail =
+		status == HTTP_200_OK ? client->detail : NULL;
+	int len;
+
+	len = header_append(buf, 0, "HTTP/1.1 %u %s\r\n%s", status,
+			    status_str(status), length_header);
+
+	if (detail != NULL && detail->content_type != NULL) {
+		len = header_append(buf, len, "Content-Type: %s\r\n",
+				    detail->content_type);
+	}
+
+	if (detail != NULL && detail->content_encoding != NULL) {
+		len = header_append(buf, len, "Content-Encoding: %s\r\n",
+				    detail->content_encoding);
+	}
+
+	if (client->close) {
+		len = header_append(buf, len, "Connection: close\r\n");
+	} else if (client->parser.http_minor == 0) {
+		len = header_append(buf, len, "Connection: keep-alive\r\n");
+	}
+
+	return header_append(buf, len, "\r\n");
+}
+
+static int dynamic_fill(struct http_client_ctx *client);
+
+/* Send the pending response, generating the rest of a dynamic response as
+ * the output buffer is sent. Returns -EAGAIN when the socket is full.
+ */
+static int client_send(struct http_client_ctx *client)
+{
+	int ret;
+
+	for (;;) {
+		ret = client_flush(client);
+		if (ret < 0 || !client->dynamic) {
+			return ret;
+		}
+
+		ret = dynamic_fill(client);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+}
+
+static int send_error(struct http_client_ctx *client, uint16_t status)
+{
+	int len;
+
+	len = response_header(client, (char *)client->out_buf, status,
+			      "Content-Length: 0\r\n");
+	if (len < 0) {
+		return len;
+	}
+
+	client->out_len = len;
+
+	return client_send(client);
+}
+
+static int send_static(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_static *res =
+		(const struct http_resource_detail_static *)client->detail;
+	char length_header[sizeof("Content-Length: \r\n") + 10];
+	int len;
+
+	snprintk(length_header, sizeof(length_header),
+		 "Content-Length: %zu\r\n", res->static_data_len);
+
+	len = response_header(client, (char *)client->out_buf, HTTP_200_OK,
+			      length_header);
+	if (len < 0) {
+		return len;
+	}
+
+	client->out_len = len;
+
+	/* The content is sent from where it is stored, for example ROM */
+	if (client->parser.method != HTTP_HEAD) {
+		client->body = res->static_data;
+		client->body_len = res->static_data_len;
+	}
+
+	return client_send(client);
+}
+
+/* Get the next part of a dynamic response from the resource callback and
+ * add it to the empty output buffer. The response headers are added with
+ * the first part, so that an error can still be reported.
+ */
+static int dynamic_fill(struct http_client_ctx *client)
+{
+	const struct http_resource_detail_dynamic *res =
+		(const struct http_resource_detail_dynamic *)client->detail;
+	/* HTTP/1.0 clients do not support chunked transfer encoding, so
+	 * the end of the response is marked by closing the connection.
+	 */
+	bool chunked = client->parser.http_minor > 0;
+	size_t room = sizeof(client->out_buf);
+	int len = 0;
+	int ret;
+
+	if (!client->dynamic_started) {
+		room -= RESPONSE_HEADER_LEN;
+	}
+
+	if (chunked) {
+		room -= CHUNK_HEADER_LEN + 2;
+	}
+
+	room = MIN(room, res->data_buffer_len);
+
+	ret = res->cb(client, HTTP_SERVER_DATA_FINAL, res->data_buffer, room,
+		      res->user_data);
+	if (ret < 0) {
+		client->dynamic = false;
+
+		if (!client->dynamic_started) {
+			/* Nothing sent yet */
+			return send_error(client,
+					  HTTP_500_INTERNAL_SERVER_ERROR);
+		}
+
+		/* The response cannot be completed */
+		client->close = true;
+
+		return ret;
+	}
+
+	ret = MIN(ret, room);
+
+	if (!client->dynamic_started) {
+		len = response_header(client, (char *)client->out_buf,
+				      HTTP_200_OK,
+				      chunked ?
+				      "Transfer-Encoding: chunked\r\n" : "");
+		if (len < 0) {
+			client->dynamic = false;
+			return len;
+		}
+
+		client->dynamic_started = true;
+	}
+
+	if (chunked) {
+		/* The last chunk is empty */
+		len += snprintk((char *)client->out_buf + len, CHUNK_HEADER_LEN,
+				"%x\r\n", ret);
+	}
+
+	memcpy(client->out_buf + len, res->data_buffer, ret);
+	len += ret;
+
+	if (chunked) {
+		memcpy(client->out_buf + len, "\r\n", 2);
+		len += 2;
+	}
+
+	client->out_len = len;
+
+	if (ret == 0) {
+		client->dynamic = false;
+	}
+
+	return 0;
+}
+
+static int send_dynamic(struct http_client_ctx *client)
+{
+	if (client->parser.http_minor == 0) {
+		client->close = true;
+	}
+
+	client->dynamic = true;
+	client->dynamic_started = false;
+
+	return client_send(client);
+}
+
+static const struct http_resource_detail *find_resource(
+	const struct http_service_desc *service, const char *url)
+{
+	size_t path_len = strcspn(url, "?");
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, res) {
+		if (strncmp(res->resource, url, path_len) == 0 &&
+		    res->resource[path_len] == '\0') {
+			return res->detail;
+		}
+	}
+
+	return NULL;
+}
+
+static bool method_allowed(const struct http_resource_detail *detail,
+			   enum http_method method)
+{
+	uint32_t methods = detail->bitmask_of_supported_http_methods;
+
+	/* HEAD of a static resource is answered like GET */
+	if (detail->type == HTTP_RESOURCE_TYPE_STATIC && method == HTTP_HEAD) {
+		method = HTTP_GET;
+	}
+
+	return method < 32 && (methods & BIT(method)) != 0U;
+}
+
+static int on_message_begin(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+
+	client->detail = NULL;
+	client->status = 0U;
+	client->url_len = 0U;
+	client->body_started = false;
+
+	return 0;
+}
+
+static int on_url(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser->data;
+
+	if (client->url_len + length > CONFIG_HTTP_SERVER_MAX_URL_LENGTH) {
+		client->status = HTTP_414_URI_TOO_LONG;
+		return 0;
+	}
+
+	memcpy(client->url + client->url_len, at, length);
+	client->url_len += length;
+
+	return 0;
+}
+
+static int on_headers_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+
+	client->url[client->url_len] = '\0';
+
+	if (client->status != 0U) {
+		return 0;
+	}
+
+	client->detail = find_resource(client->service, client->url);
+	if (client->detail == NULL) {
+		client->status = HTTP_404_NOT_FOUND;
+	} else if (!method_allowed(client->detail, parser->method)) {
+		client->status = HTTP_405_METHOD_NOT_ALLOWED;
+	}
+
+	NET_DBG("%s %s (%u)", http_method_str(parser->method), client->url,
+		client->status);
+
+	return 0;
+}
+
+static int on_body(struct http_parser *parser, const char *at, size_t length)
+{
+	struct http_client_ctx *client = parser->data;
+	const struct http_resource_detail_dynamic *res;
+	int ret;
+
+	if (client->status != 0U ||
+	    client->detail->type != HTTP_RESOURCE_TYPE_DYNAMIC) {
+		/* The body is not needed */
+		return 0;
+	}
+
+	res = (const struct http_resource_detail_dynamic *)client->detail;
+
+	client->body_started = true;
+
+	ret = res->cb(client, HTTP_SERVER_DATA_MORE, (uint8_t *)at, length,
+		      res->user_data);
+	if (ret < 0) {
+		client->status = HTTP_500_INTERNAL_SERVER_ERROR;
+		client->body_started = false;
+	}
+
+	return 0;
+}
+
+static int on_message_complete(struct http_parser *parser)
+{
+	struct http_client_ctx *client = parser->data;
+	int ret;
+
+	client->body_started = false;
+	client->close = !http_should_keep_alive(parser);
+
+	if (client->status != 0U) {
+		ret = send_error(client, client->status);
+	} else if (client->detail->type == HTTP_RESOURCE_TYPE_STATIC) {
+		ret = send_static(client);
+	} else {
+		ret = send_dynamic(client);
+	}
+
+	if (ret == -EAGAIN) {
+		/* Parse the next request once the response is sent */
+		http_parser_pause(parser, 1);
+		return 0;
+	}
+
+	if (ret < 0) {
+		NET_DBG("Cannot send response (%d)", ret);
+		client->close = true;
+	}
+
+	/* Stop parsing if the connection is closed */
+	return client->close ? 1 : 0;
+}
+
+static const struct http_parser_settings parser_settings = {
+	.on_message_begin = on_message_begin,
+	.on_url = on_url,
+	.on_headers_complete = on_headers_complete,
+	.on_body = on_body,
+	.on_message_complete = on_message_complete,
+};
+
+/* Must be invoked with the server lock held */
+static void accept_client(int idx)
+{
+	const struct http_service_desc *service = server.services[idx];
+	struct http_client_ctx *client = NULL;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	size_t clients = 0;
+	int fd, i;
+
+	for (i = 0; i < ARRAY_SIZE(server.clients); i++) {
+		if (server.clients[i].fd < 0) {
+			if (client == NULL) {
+				client = &server.clients[i];
+			}
+		} else if (server.clients[i].service == service) {
+			clients++;
+		}
+	}
+
+	if (client == NULL || clients >= service->concurrent) {
+		fd = -1;
+		NET_DBG("Too many clients for %s", service->host);
+	} else {
+		fd = zsock_accept(server.fds[idx].fd, &addr, &addrlen);
+		if (fd < 0) {
+			NET_DBG("accept failed (%d)", -errno);
+		}
+	}
+
+	if (fd < 0) {
+		/* The connection stays in the listen queue, so stop polling
+		 * the listening socket until a client is closed.
+		 */
+		server.fds[idx].events = 0;
+		update_poll_fds();
+		return;
+	}
+
+	client->fd = fd;
+	client->service = service;
+	client->detail = NULL;
+	client->body_started = false;
+	client->close = false;
+
+	http_parser_init(&client->parser, HTTP_REQUEST);
+	client->parser.data = client;
+
+	server.fds[MAX_SERVICES + (client - server.clients)].fd = fd;
+
+	(void)k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
+
+	NET_DBG("Accepted client %d for %s", fd, service->host);
+
+	update_poll_fds();
+}
+
+/* Must be invoked with the server lock held */
+static void serve_client(struct http_client_ctx *client)
+{
+	size_t parsed;
+	ssize_t len;
+	int ret;
+
+	/* Only what is parsed is taken from the socket, the requests after
+	 * a response that could not be sent yet are read again later.
+	 */
+	len = zsock_recv(client->fd, server.recv_buf, sizeof(server.recv_buf),
+			 ZSOCK_MSG_DONTWAIT | ZSOCK_MSG_PEEK);
+	if (len < 0 && errno == EAGAIN) {
+		return;
+	}
+
+	if (len <= 0) {
+		/* Closed by the peer or error */
+		close_client(client);
+		return;
+	}
+
+	(void)k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
+
+	parsed = http_parser_execute(&client->parser, &parser_settings,
+				     server.recv_buf, len);
+
+	if (parsed > 0) {
+		(void)zsock_recv(client->fd, server.recv_buf, parsed,
+				 ZSOCK_MSG_DONTWAIT);
+	}
+
+	if (client->parser.http_errno == HPE_CB_message_complete ||
+	    client->parser.upgrade) {
+		/* Response sent, the connection is not kept alive */
+		close_client(client);
+		return;
+	}
+
+	if (client->parser.http_errno == HPE_PAUSED) {
+		client_wait_output(client, true);
+		return;
+	}
+
+	if (client->parser.http_errno != HPE_OK || parsed != len) {
+		NET_DBG("Parse error %s",
+			http_errno_name(client->parser.http_errno));
+
+		ret = send_error(client, HTTP_400_BAD_REQUEST);
+		client->close = true;
+		if (ret == -EAGAIN) {
+			client_wait_output(client, true);
+			return;
+		}
+
+		close_client(client);
+	}
+}
+
+/* Must be invoked with the server lock held */
+static void client_writable(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = client_send(client);
+	if (ret == -EAGAIN) {
+		return;
+	}
+
+	if (ret < 0 || client->close) {
+		close_client(client);
+		return;
+	}
+
+	(void)k_work_reschedule(&client->inactivity_timer, INACTIVITY_TIMEOUT);
+
+	/* Continue with the requests left in the socket */
+	http_parser_pause(&client->parser, 0);
+	client_wait_output(client, false);
+}
+
+static void http_server_cb(struct k_work *work)
+{
+	struct net_socket_service_event *pev =
+		CONTAINER_OF(work, struct net_socket_service_event, work);
+	int i;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	if (!server.running) {
+		goto out;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(server.fds); i++) {
+		if (server.fds[i].fd == pev->event.fd) {
+			break;
+		}
+	}
+
+	if (i == ARRAY_SIZE(server.fds)) {
+		/* Already closed */
+		goto out;
+	}
+
+	if (i < MAX_SERVICES) {
+		if (pev->event.revents & ZSOCK_POLLIN) {
+			accept_client(i);
+		}
+
+		goto out;
+	}
+
+	if (pev->event.revents & (ZSOCK_POLLERR | ZSOCK_POLLNVAL)) {
+		close_client(&server.clients[i - MAX_SERVICES]);
+		goto out;
+	}
+
+	if (pev->event.revents & ZSOCK_POLLOUT) {
+		client_writable(&server.clients[i - MAX_SERVICES]);
+	} else if (pev->event.revents & (ZSOCK_POLLIN | ZSOCK_POLLHUP)) {
+		serve_client(&server.clients[i - MAX_SERVICES]);
+	}
+
+out:
+	k_mutex_unlock(&server_lock);
+}
+
+static int service_listen(const struct http_service_desc *service)
+{
+	union {
+		struct sockaddr sa;
+		struct sockaddr_in sin;
+		struct sockaddr_in6 sin6;
+	} addr = { 0 };
+	socklen_t addrlen;
+	int fd, ret;
+	int optval = 1;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    zsock_inet_pton(AF_INET, service->host, &addr.sin.sin_addr) == 1) {
+		addr.sa.sa_family = AF_INET;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   zsock_inet_pton(AF_INET6, service->host,
+				   &addr.sin6.sin6_addr) == 1) {
+		addr.sa.sa_family = AF_INET6;
+	} else {
+		/* A host name, listen on all addresses */
+		addr.sa.sa_family = IS_ENABLED(CONFIG_NET_IPV4) ? AF_INET : AF_INET6;
+	}
+
+	if (addr.sa.sa_family == AF_INET) {
+		addr.sin.sin_port = htons(*service->port);
+		addrlen = sizeof(addr.sin);
+	} else {
+		addr.sin6.sin6_port = htons(*service->port);
+		addrlen = sizeof(addr.sin6);
+	}
+
+	fd = zsock_socket(addr.sa.sa_family, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	(void)zsock_setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval,
+			       sizeof(optval));
+
+	if (zsock_bind(fd, &addr.sa, addrlen) < 0 ||
+	    zsock_listen(fd, service->backlog) < 0) {
+		ret = -errno;
+		NET_ERR("Cannot listen %s:%u (%d)", service->host,
+			*service->port, ret);
+		(void)zsock_close(fd);
+		return ret;
+	}
+
+	if (*service->port == 0U) {
+		/* Tell the ephemeral port to the application */
+		addrlen = sizeof(addr);
+		(void)zsock_getsockname(fd, &addr.sa, &addrlen);
+
+		*service->port = ntohs(addr.sa.sa_family == AF_INET ?
+				       addr.sin.sin_port : addr.sin6.sin6_port);
+	}
+
+	NET_DBG("Listening %s:%u", service->host, *service->port);
+
+	return fd;
+}
+
+static void server_cleanup(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(server.clients); i++) {
+		if (server.clients[i].fd >= 0) {
+			close_client(&server.clients[i]);
+		}
+	}
+
+	for (i = 0; i < MAX_SERVICES; i++) {
+		if (server.fds[i].fd >= 0) {
+			(void)zsock_close(server.fds[i].fd);
+			server.fds[i].fd = -1;
+		}
+
+		server.services[i] = NULL;
+	}
+
+	(void)net_socket_service_unregister(&svc_http);
+
+	server.running = false;
+}
+
+int http_server_start(void)
+{
+	int i = 0, fd, ret = 0;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	if (server.running) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	for (fd = 0; fd < ARRAY_SIZE(server.fds); fd++) {
+		server.fds[fd].fd = -1;
+		server.fds[fd].events = ZSOCK_POLLIN;
+	}
+
+	for (fd = 0; fd < ARRAY_SIZE(server.clients); fd++) {
+		server.clients[fd].fd = -1;
+		k_work_init_delayable(&server.clients[fd].inactivity_timer,
+				      client_timeout);
+	}
+
+	server.running = true;
+
+	HTTP_SERVICE_FOREACH(service) {
+		if (i == MAX_SERVICES) {
+			NET_ERR("Too many HTTP services, max is %d",
+				MAX_SERVICES);
+			ret = -ENOMEM;
+			break;
+		}
+
+		fd = service_listen(service);
+		if (fd < 0) {
+			ret = fd;
+			break;
+		}
+
+		server.fds[i].fd = fd;
+		server.services[i++] = service;
+	}
+
+	if (ret < 0) {
+		server_cleanup();
+		goto out;
+	}
+
+	update_poll_fds();
+
+out:
+	k_mutex_unlock(&server_lock);
+
+	return ret;
+}
+
+int http_server_stop(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&server_lock, K_FOREVER);
+
+	if (!server.running) {
+		ret = -EALREADY;
+		goto out;
+	}
+
+	server_cleanup();
+
+out:
+	k_mutex_unlock(&server_lock);
+
+	return ret;
+}
+
+enum http_method http_server_client_method(const struct http_client_ctx *client)
+{
+	return client->parser.method;
+}
+
+const char *http_server_client_url(const struct http_client_ctx *client)
+{
+	return client->url;
+}
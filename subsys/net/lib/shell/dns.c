@@ -109,6 +109,18 @@ static void print_dns_info(const struct shell *sh,
 			   remaining);
 		}
 	}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct dns_resolve_cache_stats stats;
+
+	if (dns_resolve_cache_stats_get(&stats) == 0) {
+		PR("Cache entries %u/%u hits %u negative hits %u misses %u\n",
+		   stats.entries, stats.max_entries, stats.hits,
+		   stats.negative_hits, stats.misses);
+		PR("Cache inserts %u evictions %u\n", stats.inserts,
+		   stats.evictions);
+	}
+#endif
 }
 #endif
 
@@ -152,6 +164,23 @@ static int cmd_net_dns_cancel(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_net_dns_flush(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_resolve_cache_flush();
+
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("Set %s to enable %s support.\n", "CONFIG_DNS_RESOLVER_CACHE",
+		"DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns_query(const struct shell *sh, size_t argc, char *argv[])
 {
 
@@ -232,6 +261,8 @@ static int cmd_net_dns(const struct shell *sh, size_t argc, char *argv[])
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
+	SHELL_CMD(flush, NULL, "Remove all entries from the DNS cache.",
+		  cmd_net_dns_flush),
 	SHELL_CMD(query, NULL,
 		  "'net dns <hostname> [A or AAAA]' queries IPv4 address "
 		  "(default) or IPv6 address for a host name.",
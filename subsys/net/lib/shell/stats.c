@@ -420,6 +420,27 @@ static void print_tc_rx_stats(const struct shell *sh, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_rx_queue_stats(const struct shell *sh, struct net_if *iface)
+{
+#if defined(CONFIG_NET_RX_STEERING)
+	int i, j;
+
+	PR("RX queue statistics:\n");
+	PR("TC  Queue\tRecv pkts\tbytes\n");
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		for (j = 0; j < NET_TC_RX_QUEUE_COUNT; j++) {
+			PR("[%d] %d\t\t%d\t\t%d\n", i, j,
+			   GET_STAT(iface, rx_queue[i][j].pkts),
+			   GET_STAT(iface, rx_queue[i][j].bytes));
+		}
+	}
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif /* CONFIG_NET_RX_STEERING */
+}
+
 static void print_net_pm_stats(const struct shell *sh, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -544,6 +565,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
+	print_rx_queue_stats(sh, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
@@ -24,6 +24,9 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/iterable_sections.h>
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
 
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
@@ -65,6 +68,8 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 							     \
 		k_mutex_unlock(lock);                        \
 							     \
+		zsock_epoll_notify(sock);		     \
+							     \
 		ret;					     \
 	})
 
@@ -292,6 +297,10 @@ int z_impl_zsock_close(int sock)
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_SOCKETS_EPOLL)) {
+		zsock_epoll_fd_close(sock);
+	}
+
 	(void)k_mutex_lock(lock, K_FOREVER);
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
@@ -1031,6 +1040,304 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	zsock_epoll_notify(sock);
+
+	/* An error is only reported if nothing was sent */
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+/* Validate a message vector from user mode once for the whole batch. The
+ * message headers and I/O vectors are copied so that they cannot change
+ * while the batch is processed. The buffers they point to are only checked
+ * for access and used in place. The I/O vectors of all the messages are
+ * allocated as one block returned in @p iov_block, followed by the
+ * original number of vectors of each message in @p iovlens.
+ */
+static struct mmsghdr *mmsg_vec_copy(struct mmsghdr *msgvec, unsigned int vlen,
+				     bool is_write, struct iovec **iov_block,
+				     size_t **iovlens)
+{
+	struct mmsghdr *kvec;
+	struct iovec *iov;
+	size_t iov_cnt = 0;
+	size_t size;
+	unsigned int i;
+	size_t j;
+
+	*iov_block = NULL;
+
+	if (size_mul_overflow(vlen, sizeof(struct mmsghdr), &size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	kvec = k_usermode_alloc_from_copy(msgvec, size);
+	if (kvec == NULL) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		if (size_add_overflow(iov_cnt, kvec[i].msg_hdr.msg_iovlen, &iov_cnt)) {
+			errno = EINVAL;
+			goto fail;
+		}
+	}
+
+	if (size_mul_overflow(iov_cnt, sizeof(struct iovec), &size) ||
+	    size_add_overflow(size, vlen * sizeof(size_t), &size)) {
+		errno = EINVAL;
+		goto fail;
+	}
+
+	iov = k_malloc(MAX(size, 1));
+	if (iov == NULL) {
+		errno = ENOMEM;
+		goto fail;
+	}
+
+	*iov_block = iov;
+	*iovlens = (size_t *)&iov[iov_cnt];
+
+	for (i = 0; i < vlen; i++) {
+		struct msghdr *msg = &kvec[i].msg_hdr;
+
+		if (k_usermode_from_copy(iov, msg->msg_iov,
+					 msg->msg_iovlen * sizeof(struct iovec)) != 0) {
+			errno = EFAULT;
+			goto fail;
+		}
+
+		msg->msg_iov = iov;
+		iov += msg->msg_iovlen;
+		(*iovlens)[i] = msg->msg_iovlen;
+
+		for (j = 0; j < msg->msg_iovlen; j++) {
+			if (K_SYSCALL_MEMORY(msg->msg_iov[j].iov_base,
+					     msg->msg_iov[j].iov_len, is_write)) {
+				errno = EFAULT;
+				goto fail;
+			}
+		}
+
+		if ((msg->msg_namelen > 0 && msg->msg_name == NULL) ||
+		    (msg->msg_controllen > 0 && msg->msg_control == NULL)) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		if (K_SYSCALL_MEMORY(msg->msg_name, msg->msg_namelen, is_write) ||
+		    K_SYSCALL_MEMORY(msg->msg_control, msg->msg_controllen, is_write)) {
+			errno = EFAULT;
+			goto fail;
+		}
+	}
+
+	return kvec;
+
+fail:
+	k_free(*iov_block);
+	k_free(kvec);
+	*iov_block = NULL;
+
+	return NULL;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *kvec;
+	struct iovec *iov_block;
+	size_t *iovlens;
+	int ret;
+	int i;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	kvec = mmsg_vec_copy(msgvec, vlen, false, &iov_block, &iovlens);
+	if (kvec == NULL) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, kvec, vlen, flags);
+
+	for (i = 0; i < ret; i++) {
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &kvec[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
+	}
+
+	k_free(iov_block);
+	k_free(kvec);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_FILE_SYSTEM)
+static ssize_t sendfile_fill_cb(void *dst, size_t len, void *user_data)
+{
+	return fs_read(user_data, dst, len);
+}
+
+static ssize_t zsock_sendfile_ctx(struct net_context *ctx,
+				  struct fs_file_t *file, size_t count)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	size_t sent = 0;
+	int status;
+
+	if (sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+	}
+
+	end = sys_timepoint_calc(timeout);
+	buf_timeout = sys_timepoint_calc(K_TIMEOUT_EQ(timeout, K_NO_WAIT) ?
+					 K_NO_WAIT : MAX_WAIT_BUFS);
+
+	while (sent < count) {
+		status = net_tcp_queue_fill(ctx, count - sent,
+					    sendfile_fill_cb, file);
+		if (status == 0) {
+			/* End of file */
+			break;
+		}
+
+		if (status > 0) {
+			sent += status;
+
+			/* Progress was made, restart the buffer wait period */
+			retry_timeout = WAIT_BUFS_INITIAL_MS;
+			if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+			}
+
+			continue;
+		}
+
+		if (sent > 0 && (status == -EAGAIN || status == -ENOBUFS) &&
+		    K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		status = send_check_and_wait(ctx, status, buf_timeout,
+					     timeout, &retry_timeout);
+		if (status < 0) {
+			return sent > 0 ? sent : status;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+	}
+
+	return sent;
+}
+
+ssize_t zsock_sendfile(int sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	off_t saved_pos = 0;
+	ssize_t ret;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Data is read straight into TX buffers of a native TCP connection */
+	if (vtable != &sock_fd_op_vtable ||
+	    !IS_ENABLED(CONFIG_NET_NATIVE_TCP) ||
+	    net_context_get_type(ctx) != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (offset != NULL) {
+		saved_pos = fs_tell(file);
+		if (saved_pos < 0) {
+			errno = -saved_pos;
+			return -1;
+		}
+
+		ret = fs_seek(file, *offset, FS_SEEK_SET);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_sendfile_ctx(ctx, file, count);
+
+	k_mutex_unlock(lock);
+
+	zsock_epoll_notify(sock);
+
+	if (offset != NULL) {
+		if (ret > 0) {
+			*offset += ret;
+		}
+
+		/* The file position is left untouched when an offset is given */
+		(void)fs_seek(file, saved_pos, FS_SEEK_SET);
+	}
+
+	sock_obj_core_update_send_stats(sock, ret);
+
+	return ret;
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1351,6 +1658,42 @@ out:
 	return ret;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
+						    *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       struct msghdr *msg,
 				       void *buf,
@@ -1402,38 +1745,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1809,6 +2125,182 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Drop the already consumed headers so that the fragment chain of the
+ * packet starts at the first unread byte.
+ */
+static void zsock_pkt_trim_to_cursor(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	while (buf != NULL && buf != pkt->cursor.buf) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf != NULL) {
+		net_buf_pull(buf, pkt->cursor.pos - buf->data);
+
+		if (buf->len == 0U) {
+			buf = net_buf_frag_del(NULL, buf);
+		}
+	}
+
+	pkt->buffer = buf;
+	net_pkt_cursor_init(pkt);
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct zsock_zc_buf *zc, int flags,
+				 struct sockaddr *src_addr,
+				 socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	while (1) {
+		if (sock_type == SOCK_STREAM) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			}
+
+			if (sock_is_eof(ctx)) {
+				return 0;
+			}
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			if (sock_type == SOCK_STREAM &&
+			    (sock_is_eof(ctx) || sock_is_error(ctx))) {
+				continue;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		len = net_pkt_remaining_data(pkt);
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (len > 0 || sock_type == SOCK_DGRAM) {
+			break;
+		}
+
+		/* Empty stream packet carrying only the EOF marker */
+		net_pkt_unref(pkt);
+	}
+
+	if (sock_type == SOCK_DGRAM && src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	zsock_pkt_trim_to_cursor(pkt);
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	zc->frags = pkt->buffer;
+	zc->len = len;
+	zc->pkt = pkt;
+
+	return len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct zsock_zc_buf *zc, int flags,
+		      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (zc == NULL || (flags & ZSOCK_MSG_PEEK)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	zc->frags = NULL;
+	zc->len = 0;
+	zc->pkt = NULL;
+
+	ctx = get_sock_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only native sockets hold the data in network packets */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(ctx, zc, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	zsock_epoll_notify(sock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(struct zsock_zc_buf *zc)
+{
+	if (zc == NULL || zc->pkt == NULL) {
+		return;
+	}
+
+	net_pkt_unref(zc->pkt);
+
+	zc->frags = NULL;
+	zc->len = 0;
+	zc->pkt = NULL;
+}
+
 ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 			  int flags)
 {
@@ -2024,6 +2516,117 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		/* Do not wait for the rest of the messages */
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	zsock_epoll_notify(sock);
+
+	/* An error is only reported if nothing was received */
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *kvec;
+	struct iovec *iov_block;
+	struct iovec *iov;
+	size_t *iovlens;
+	size_t j;
+	int ret;
+	int i;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	kvec = mmsg_vec_copy(msgvec, vlen, true, &iov_block, &iovlens);
+	if (kvec == NULL) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, kvec, vlen, flags);
+
+	/* The data was received in place, only the lengths and flags are
+	 * copied back. The I/O vectors are copied back as a whole, clearing
+	 * the ones which were not populated.
+	 */
+	iov = iov_block;
+
+	for (i = 0; i < ret; i++) {
+		struct msghdr *msg = &kvec[i].msg_hdr;
+		struct msghdr *umsg = &msgvec[i].msg_hdr;
+		struct iovec *uiov;
+
+		/* The new iovlen cannot be bigger than the original one */
+		NET_ASSERT(msg->msg_iovlen <= iovlens[i]);
+
+		for (j = msg->msg_iovlen; j < iovlens[i]; j++) {
+			iov[j].iov_len = 0;
+		}
+
+		K_OOPS(k_usermode_from_copy(&uiov, &umsg->msg_iov, sizeof(uiov)));
+		K_OOPS(k_usermode_to_copy(uiov, iov, iovlens[i] * sizeof(struct iovec)));
+		iov += iovlens[i];
+
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &kvec[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
+		K_OOPS(k_usermode_to_copy(&umsg->msg_iovlen, &msg->msg_iovlen,
+					  sizeof(umsg->msg_iovlen)));
+		K_OOPS(k_usermode_to_copy(&umsg->msg_namelen, &msg->msg_namelen,
+					  sizeof(umsg->msg_namelen)));
+		K_OOPS(k_usermode_to_copy(&umsg->msg_controllen, &msg->msg_controllen,
+					  sizeof(umsg->msg_controllen)));
+		K_OOPS(k_usermode_to_copy(&umsg->msg_flags, &msg->msg_flags,
+					  sizeof(umsg->msg_flags)));
+	}
+
+	k_free(iov_block);
+	k_free(kvec);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2205,15 +2808,16 @@ static inline int time_left(uint32_t start, uint32_t timeout)
 	return timeout - elapsed;
 }
 
-int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+int zsock_poll_events(struct zsock_pollfd *fds, int nfds,
+		      struct k_poll_event *poll_events, int max_events,
+		      int nreserved, k_timeout_t timeout)
 {
 	bool retry;
 	int ret = 0;
 	int i;
 	struct zsock_pollfd *pfd;
-	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
 	struct k_poll_event *pev;
-	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
+	struct k_poll_event *pev_end = poll_events + max_events;
 	const struct fd_op_vtable *vtable;
 	struct k_mutex *lock;
 	k_timepoint_t end;
@@ -2223,7 +2827,7 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 
 	end = sys_timepoint_calc(timeout);
 
-	pev = poll_events;
+	pev = poll_events + nreserved;
 	for (pfd = fds, i = nfds; i--; pfd++) {
 		void *ctx;
 		int result;
@@ -2308,7 +2912,7 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 		retry = false;
 		ret = 0;
 
-		pev = poll_events;
+		pev = poll_events + nreserved;
 		for (pfd = fds, i = nfds; i--; pfd++) {
 			void *ctx;
 			int result;
@@ -2354,6 +2958,17 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 				break;
 			}
 
+			/* Let the caller handle its own events first */
+			for (i = 0; i < nreserved; i++) {
+				if (poll_events[i].state != K_POLL_STATE_NOT_READY) {
+					retry = false;
+				}
+			}
+
+			if (!retry) {
+				break;
+			}
+
 			timeout = sys_timepoint_timeout(end);
 
 			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -2365,6 +2980,14 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 	return ret;
 }
 
+int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
+{
+	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
+
+	return zsock_poll_events(fds, nfds, poll_events,
+				 ARRAY_SIZE(poll_events), 0, timeout);
+}
+
 int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int poll_timeout)
 {
 	k_timeout_t timeout;
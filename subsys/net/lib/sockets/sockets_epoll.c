@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "sockets_internal.h"
+
+/* Number of k_poll events a single socket can use (read and write) */
+#define EPOLL_EVENTS_PER_FD 2
+
+/* Events that are passed on to zsock_poll() style socket checks */
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLPRI | ZSOCK_EPOLLOUT)
+
+enum epoll_state {
+	/* Not watched, e.g. a one-shot entry that was reported */
+	EPOLL_IDLE,
+	/* Registered with the socket, waiting for it to become ready */
+	EPOLL_WAITING,
+	/* On the ready list of the instance */
+	EPOLL_READY,
+	/* Edge-triggered entry that was reported, registered again once
+	 * the application operates on the socket.
+	 */
+	EPOLL_PARKED,
+};
+
+struct epoll_instance;
+
+struct epoll_entry {
+	/* Registration with the socket, triggered when it becomes ready */
+	struct k_work_poll work;
+	struct k_poll_event poll_events[EPOLL_EVENTS_PER_FD];
+	/* Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+	/* Node in the list of entries watching the same descriptor */
+	sys_snode_t fd_node;
+	struct epoll_instance *ep;
+	int fd;
+	/* Events and flags registered by the user */
+	uint32_t events;
+	zsock_epoll_data_t data;
+	/* Changed under the ready list lock of the instance */
+	enum epoll_state state;
+};
+
+struct epoll_instance {
+	/* Entries whose socket may be ready, in reporting order */
+	sys_dlist_t ready;
+	struct k_spinlock ready_lock;
+	/* Raised when an entry is added to the ready list */
+	struct k_poll_signal changed;
+	/* Serializes waiters */
+	struct k_mutex wait_lock;
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+/* Entries of all instances, by the descriptor they watch */
+static sys_slist_t epoll_fds[CONFIG_POSIX_MAX_FDS];
+/* Protects the instances, the entries and the lists above */
+static K_MUTEX_DEFINE(epoll_lock);
+K_MEM_SLAB_DEFINE_STATIC(epoll_entry_slab, sizeof(struct epoll_entry),
+			 CONFIG_NET_SOCKETS_EPOLL_MAX_FDS, 4);
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct epoll_instance *epoll_alloc(void)
+{
+	struct epoll_instance *ep = NULL;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			ep->in_use = true;
+			sys_dlist_init(&ep->ready);
+			k_mutex_init(&ep->wait_lock);
+			k_poll_signal_init(&ep->changed);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	return ep;
+}
+
+static struct epoll_entry *epoll_find(struct epoll_instance *ep, int fd)
+{
+	struct epoll_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&epoll_fds[fd], entry, fd_node) {
+		if (entry->ep == ep) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void epoll_make_ready(struct epoll_entry *entry)
+{
+	struct epoll_instance *ep = entry->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->ready_lock);
+
+	if (entry->state == EPOLL_WAITING) {
+		entry->state = EPOLL_READY;
+		sys_dlist_append(&ep->ready, &entry->ready_node);
+	}
+
+	k_spin_unlock(&ep->ready_lock, key);
+
+	k_poll_signal_raise(&ep->changed, 0);
+}
+
+static void epoll_triggered(struct k_work *work)
+{
+	struct k_work_poll *pwork = CONTAINER_OF(work, struct k_work_poll, work);
+
+	epoll_make_ready(CONTAINER_OF(pwork, struct epoll_entry, work));
+}
+
+/* Register the entry with its socket, so that it is queued to the ready
+ * list once the socket becomes ready. Called with epoll_lock held, on an
+ * entry that is not registered.
+ */
+static int epoll_arm(struct epoll_entry *entry)
+{
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev = entry->poll_events;
+	struct k_poll_event *pev_end = pev + ARRAY_SIZE(entry->poll_events);
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = z_get_fd_obj_and_vtable(entry->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+				   &pfd, &pev, pev_end);
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		/* Ready right away, nothing to wait for */
+		entry->state = EPOLL_WAITING;
+		epoll_make_ready(entry);
+		return 0;
+	}
+
+	if (ret == -EXDEV || ret == -EOPNOTSUPP) {
+		/* Offloaded sockets and other descriptors cannot be
+		 * registered with the kernel.
+		 */
+		return -EPERM;
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (pev == entry->poll_events) {
+		/* None of the events can be waited for */
+		return 0;
+	}
+
+	entry->state = EPOLL_WAITING;
+
+	/* Queue it now if it is already ready, instead of when the work
+	 * queue gets to it, so that a wait without timeout sees it.
+	 */
+	if (k_poll(entry->poll_events, pev - entry->poll_events, K_NO_WAIT) == 0) {
+		epoll_make_ready(entry);
+		return 0;
+	}
+
+	return k_work_poll_submit(&entry->work, entry->poll_events,
+				  pev - entry->poll_events, K_FOREVER);
+}
+
+/* Undo epoll_arm(), whatever state the entry is in. Called with
+ * epoll_lock held.
+ */
+static void epoll_disarm(struct epoll_entry *entry)
+{
+	struct epoll_instance *ep = entry->ep;
+	struct k_work_sync sync;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->ready_lock);
+
+	if (entry->state == EPOLL_READY) {
+		sys_dlist_remove(&entry->ready_node);
+	}
+
+	entry->state = EPOLL_IDLE;
+
+	k_spin_unlock(&ep->ready_lock, key);
+
+	/* The handler may already be queued, make sure it is done with the
+	 * entry. It does nothing once the entry is idle.
+	 */
+	(void)k_work_poll_cancel(&entry->work);
+	(void)k_work_cancel_sync(&entry->work.work, &sync);
+}
+
+static void epoll_free(struct epoll_entry *entry)
+{
+	epoll_disarm(entry);
+	sys_slist_find_and_remove(&epoll_fds[entry->fd], &entry->fd_node);
+	k_mem_slab_free(&epoll_entry_slab, entry);
+}
+
+int z_impl_zsock_epoll_create(int size)
+{
+	struct epoll_instance *ep;
+	int fd;
+
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	/* Registrations only exist once an epoll instance has been created,
+	 * so installing the close hook here is early enough.
+	 */
+	z_fd_close_hook_register(zsock_epoll_fd_close);
+
+	ep = epoll_alloc();
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int size)
+{
+	return z_impl_zsock_epoll_create(size);
+}
+#include <syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct epoll_entry *entry;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	if (fd < 0 || fd >= ARRAY_SIZE(epoll_fds) ||
+	    z_get_fd_obj(fd, NULL, EBADF) == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	entry = epoll_find(ep, fd);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (entry != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		if (k_mem_slab_alloc(&epoll_entry_slab, (void **)&entry,
+				     K_NO_WAIT) < 0) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		k_work_poll_init(&entry->work, epoll_triggered);
+		sys_dnode_init(&entry->ready_node);
+		entry->ep = ep;
+		entry->fd = fd;
+		entry->events = event->events;
+		entry->data = event->data;
+		entry->state = EPOLL_IDLE;
+
+		ret = epoll_arm(entry);
+		if (ret < 0) {
+			epoll_disarm(entry);
+			k_mem_slab_free(&epoll_entry_slab, entry);
+			break;
+		}
+
+		sys_slist_append(&epoll_fds[fd], &entry->fd_node);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_disarm(entry);
+		entry->events = event->events;
+		entry->data = event->data;
+		ret = epoll_arm(entry);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_free(entry);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		K_OOPS(k_usermode_from_copy(&event_copy, event,
+					    sizeof(event_copy)));
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd,
+				      event != NULL ? &event_copy : NULL);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+void zsock_epoll_notify(int sock)
+{
+	struct epoll_entry *entry;
+
+	/* Cheap check first, this is called on every socket operation */
+	if (sock < 0 || sock >= ARRAY_SIZE(epoll_fds) ||
+	    sys_slist_is_empty(&epoll_fds[sock])) {
+		return;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	/* The application may have consumed the condition that was
+	 * reported, so edge-triggered entries can be registered again.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&epoll_fds[sock], entry, fd_node) {
+		if (entry->state == EPOLL_PARKED) {
+			entry->state = EPOLL_IDLE;
+			(void)epoll_arm(entry);
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+void zsock_epoll_fd_close(int fd)
+{
+	struct epoll_entry *entry, *next;
+
+	if (fd < 0 || fd >= ARRAY_SIZE(epoll_fds) ||
+	    sys_slist_is_empty(&epoll_fds[fd])) {
+		return;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&epoll_fds[fd], entry, next, fd_node) {
+		epoll_free(entry);
+	}
+
+	k_mutex_unlock(&epoll_lock);
+}
+
+/* Current events of the socket of an entry, as reported to the user */
+static uint32_t epoll_revents(struct epoll_entry *entry)
+{
+	struct k_poll_event poll_events[EPOLL_EVENTS_PER_FD];
+	struct zsock_pollfd pfd = {
+		.fd = entry->fd,
+		.events = entry->events & EPOLL_POLL_EVENTS,
+	};
+
+	if (zsock_poll_events(&pfd, 1, poll_events, ARRAY_SIZE(poll_events),
+			      0, K_NO_WAIT) < 0) {
+		return ZSOCK_EPOLLERR;
+	}
+
+	return pfd.revents & (entry->events | ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP);
+}
+
+/* Report the entries of the ready list that are still ready. Only the
+ * ready list is looked at, so the cost depends on the number of ready
+ * sockets and not on the size of the interest list. Called with
+ * epoll_lock held.
+ */
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	sys_dlist_t pending, again;
+	struct epoll_entry *entry;
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	uint32_t revents;
+	int ready = 0;
+
+	sys_dlist_init(&pending);
+	sys_dlist_init(&again);
+
+	/* Entries still keep coming in while the list is being processed */
+	key = k_spin_lock(&ep->ready_lock);
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+	k_spin_unlock(&ep->ready_lock, key);
+
+	while (ready < maxevents && (node = sys_dlist_get(&pending)) != NULL) {
+		entry = CONTAINER_OF(node, struct epoll_entry, ready_node);
+
+		revents = epoll_revents(entry);
+		if (revents == 0) {
+			/* Condition already consumed, wait for the next one */
+			entry->state = EPOLL_IDLE;
+			(void)epoll_arm(entry);
+			continue;
+		}
+
+		events[ready].events = revents;
+		events[ready].data = entry->data;
+		ready++;
+
+		if (entry->events & ZSOCK_EPOLLONESHOT) {
+			entry->state = EPOLL_IDLE;
+		} else if (entry->events & ZSOCK_EPOLLET) {
+			entry->state = EPOLL_PARKED;
+		} else {
+			/* Level-triggered, ready until found otherwise */
+			sys_dlist_append(&again, node);
+		}
+	}
+
+	/* Entries that were not looked at come first next time and the
+	 * reported ones last, so that busy sockets cannot starve others.
+	 */
+	key = k_spin_lock(&ep->ready_lock);
+	while ((node = sys_dlist_peek_tail(&pending)) != NULL) {
+		sys_dlist_remove(node);
+		sys_dlist_prepend(&ep->ready, node);
+	}
+	while ((node = sys_dlist_get(&again)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+	k_spin_unlock(&ep->ready_lock, key);
+
+	return ready;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct epoll_instance *ep;
+	struct k_poll_event event;
+	k_timepoint_t end;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&ep->wait_lock, K_FOREVER);
+
+	do {
+		/* Reset before looking at the list, so that an entry queued
+		 * meanwhile ends the wait below.
+		 */
+		k_poll_signal_reset(&ep->changed);
+
+		(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+		ret = epoll_collect(ep, events, maxevents);
+		k_mutex_unlock(&epoll_lock);
+
+		if (ret > 0) {
+			break;
+		}
+
+		k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->changed);
+	} while (k_poll(&event, 1, sys_timepoint_timeout(end)) == 0);
+
+	k_mutex_unlock(&ep->wait_lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	K_OOPS(maxevents > 0 &&
+	       K_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+					    sizeof(struct zsock_epoll_event)));
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	/* Nesting epoll instances or polling them is not supported */
+	return -EOPNOTSUPP;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_instance *ep = obj;
+	struct epoll_entry *entry, *next;
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (int fd = 0; fd < ARRAY_SIZE(epoll_fds); fd++) {
+		SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&epoll_fds[fd], entry, next,
+						  fd_node) {
+			if (entry->ep == ep) {
+				epoll_free(entry);
+			}
+		}
+	}
+
+	ep->in_use = false;
+
+	k_mutex_unlock(&epoll_lock);
+
+	return 0;
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
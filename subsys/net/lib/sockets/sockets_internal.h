@@ -18,8 +18,28 @@
 int zsock_close_ctx(struct net_context *ctx);
 int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout);
 
+/* Like zsock_poll_internal(), but with caller provided storage for the
+ * k_poll events. The first nreserved entries of poll_events are already
+ * initialized by the caller and are waited on along with the sockets.
+ */
+int zsock_poll_events(struct zsock_pollfd *fds, int nfds,
+		      struct k_poll_event *poll_events, int max_events,
+		      int nreserved, k_timeout_t timeout);
+
 int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout);
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Tell epoll that the application has operated on the socket, so that an
+ * edge-triggered condition it consumed can be reported again.
+ */
+void zsock_epoll_notify(int sock);
+#else
+static inline void zsock_epoll_notify(int sock)
+{
+	ARG_UNUSED(sock);
+}
+#endif
+
 static inline void sock_set_flag(struct net_context *ctx, uintptr_t mask,
 				 uintptr_t flag)
 {
@@ -7,45 +7,108 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 
+#include <zephyr/kernel.h>
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/spinlock.h>
 
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+/*
+ * Compiled rule lists
+ *
+ * A rule list is compiled into a program: for each rule one instruction per
+ * test, followed by an instruction returning the rule result. The program
+ * ends with an instruction returning NET_DROP. A test which is true moves to
+ * the next instruction, a test which is false jumps to the first following
+ * rule not using the same test.
+ */
+
+enum npf_op {
+	NPF_OP_RETURN,
+	NPF_OP_IFACE,
+	NPF_OP_ORIG_IFACE,
+	NPF_OP_SIZE,
+	NPF_OP_ETH_TYPE,
+	NPF_OP_CALL,
+};
+
+struct npf_insn {
+	uint8_t op;
+	bool negate;
+	uint16_t fail;
+	union {
+		enum net_verdict result;
+		struct net_if *iface;
+		const struct npf_test_size_bounds *bounds;
+		uint16_t eth_type;
+		struct npf_test *test;
+	};
+};
+
+struct npf_program {
+	atomic_t readers;
+	struct npf_insn insns[CONFIG_NET_PKT_FILTER_PROGRAM_SIZE];
+};
+
+/* Serializes the rule list updates */
+static K_MUTEX_DEFINE(update_lock);
+
+#define NPF_PROGRAMS_DEFINE(_name) \
+	static struct npf_program _name##_programs[2]
+#define NPF_PROGRAMS_INIT(_name) \
+	.programs = _name##_programs,
+#else
+#define NPF_PROGRAMS_DEFINE(_name)
+#define NPF_PROGRAMS_INIT(_name)
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
 /*
  * Our actual rule lists for supported test points
  */
 
+NPF_PROGRAMS_DEFINE(send_rules);
+NPF_PROGRAMS_DEFINE(recv_rules);
+
 struct npf_rule_list npf_send_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&send_rules.rule_head),
 	.lock = { },
+	NPF_PROGRAMS_INIT(send_rules)
 };
 
 struct npf_rule_list npf_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&recv_rules.rule_head),
 	.lock = { },
+	NPF_PROGRAMS_INIT(recv_rules)
 };
 
 #ifdef CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK
+NPF_PROGRAMS_DEFINE(local_in_recv_rules);
 struct npf_rule_list npf_local_in_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&local_in_recv_rules.rule_head),
 	.lock = { },
+	NPF_PROGRAMS_INIT(local_in_recv_rules)
 };
 #endif /* CONFIG_NET_PKT_FILTER_LOCAL_IN_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV4_HOOK
+NPF_PROGRAMS_DEFINE(ipv4_recv_rules);
 struct npf_rule_list npf_ipv4_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&ipv4_recv_rules.rule_head),
 	.lock = { },
+	NPF_PROGRAMS_INIT(ipv4_recv_rules)
 };
 #endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK */
 
 #ifdef CONFIG_NET_PKT_FILTER_IPV6_HOOK
+NPF_PROGRAMS_DEFINE(ipv6_recv_rules);
 struct npf_rule_list npf_ipv6_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&ipv6_recv_rules.rule_head),
 	.lock = { },
+	NPF_PROGRAMS_INIT(ipv6_recv_rules)
 };
 #endif /* CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
+#if defined(CONFIG_NET_PKT_FILTER_IPV4_HOOK) || defined(CONFIG_NET_PKT_FILTER_IPV6_HOOK)
 /*
  * Helper function
  */
@@ -68,6 +131,7 @@ static struct npf_rule_list *get_ip_rules(uint8_t pf)
 
 	return NULL;
 }
+#endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK || CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
 /*
  * Rule application
@@ -119,8 +183,86 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 	return NET_DROP;
 }
 
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+static enum net_verdict run(const struct npf_program *program, struct net_pkt *pkt)
+{
+	const struct npf_insn *insn = program->insns;
+	size_t pkt_size = SIZE_MAX;
+	bool result;
+
+	while (true) {
+		switch (insn->op) {
+		case NPF_OP_RETURN:
+			return insn->result;
+		case NPF_OP_IFACE:
+			result = insn->iface == net_pkt_iface(pkt);
+			break;
+		case NPF_OP_ORIG_IFACE:
+			result = insn->iface == net_pkt_orig_iface(pkt);
+			break;
+		case NPF_OP_SIZE:
+			/* Walking the buffers once is enough */
+			if (pkt_size == SIZE_MAX) {
+				pkt_size = net_pkt_get_len(pkt);
+			}
+
+			result = pkt_size >= insn->bounds->min &&
+				 pkt_size <= insn->bounds->max;
+			break;
+#ifdef CONFIG_NET_L2_ETHERNET
+		case NPF_OP_ETH_TYPE:
+			result = NET_ETH_HDR(pkt)->type == insn->eth_type;
+			break;
+#endif
+		default:
+			result = insn->test->fn(insn->test, pkt);
+			break;
+		}
+
+		if (result != insn->negate) {
+			insn++;
+		} else {
+			insn = &program->insns[insn->fail];
+		}
+	}
+}
+
+/* Get the current program, or NULL if the rule list isn't compiled */
+static struct npf_program *program_get(struct npf_rule_list *rules)
+{
+	struct npf_program *program;
+
+	while (true) {
+		program = atomic_ptr_get(&rules->program);
+		if (program == NULL) {
+			return NULL;
+		}
+
+		atomic_inc(&program->readers);
+
+		/* The program may have been replaced before being marked in use */
+		if (program == atomic_ptr_get(&rules->program)) {
+			return program;
+		}
+
+		atomic_dec(&program->readers);
+	}
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+	struct npf_program *program = program_get(rules);
+
+	if (program != NULL) {
+		enum net_verdict result = run(program, pkt);
+
+		atomic_dec(&program->readers);
+		return result;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	enum net_verdict result = evaluate(&rules->rule_head, pkt);
 
@@ -167,18 +309,164 @@ bool net_pkt_filter_ip_recv_ok(struct net_pkt *pkt)
 }
 #endif /* CONFIG_NET_PKT_FILTER_IPV4_HOOK || CONFIG_NET_PKT_FILTER_IPV6_HOOK */
 
+/*
+ * Rule compilation
+ */
+
+#ifdef CONFIG_NET_PKT_FILTER_COMPILED
+static bool rule_has_test(struct npf_rule *rule, struct npf_test *test)
+{
+	for (unsigned int i = 0; i < rule->nb_tests; i++) {
+		if (rule->tests[i] == test) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void compile_test(struct npf_insn *insn, struct npf_test *test)
+{
+	insn->negate = false;
+
+	if (test->fn == npf_iface_match || test->fn == npf_iface_unmatch) {
+		insn->op = NPF_OP_IFACE;
+		insn->negate = test->fn == npf_iface_unmatch;
+		insn->iface = CONTAINER_OF(test, struct npf_test_iface, test)->iface;
+	} else if (test->fn == npf_orig_iface_match || test->fn == npf_orig_iface_unmatch) {
+		insn->op = NPF_OP_ORIG_IFACE;
+		insn->negate = test->fn == npf_orig_iface_unmatch;
+		insn->iface = CONTAINER_OF(test, struct npf_test_iface, test)->iface;
+	} else if (test->fn == npf_size_inbounds) {
+		insn->op = NPF_OP_SIZE;
+		insn->bounds = CONTAINER_OF(test, struct npf_test_size_bounds, test);
+#ifdef CONFIG_NET_L2_ETHERNET
+	} else if (test->fn == npf_eth_type_match || test->fn == npf_eth_type_unmatch) {
+		insn->op = NPF_OP_ETH_TYPE;
+		insn->negate = test->fn == npf_eth_type_unmatch;
+		insn->eth_type = CONTAINER_OF(test, struct npf_test_eth_type, test)->type;
+#endif
+	} else {
+		insn->op = NPF_OP_CALL;
+		insn->test = test;
+	}
+}
+
+static int compile(sys_slist_t *rule_head, struct npf_program *program)
+{
+	struct npf_insn *insns = program->insns;
+	struct npf_rule *rule, *next;
+	size_t pc = 0;
+	size_t fail;
+
+	if (sys_slist_is_empty(rule_head)) {
+		insns[0].op = NPF_OP_RETURN;
+		insns[0].result = NET_OK;
+		return 0;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
+		if (pc + rule->nb_tests + 1 >= ARRAY_SIZE(program->insns)) {
+			return -ENOSPC;
+		}
+
+		for (unsigned int i = 0; i < rule->nb_tests; i++) {
+			/* Skip the following rules which would fail the same test */
+			fail = pc + rule->nb_tests + 1;
+			next = SYS_SLIST_PEEK_NEXT_CONTAINER(rule, node);
+
+			while (next != NULL && rule_has_test(next, rule->tests[i])) {
+				fail += next->nb_tests + 1;
+				next = SYS_SLIST_PEEK_NEXT_CONTAINER(next, node);
+			}
+
+			compile_test(&insns[pc + i], rule->tests[i]);
+			insns[pc + i].fail = fail;
+		}
+
+		pc += rule->nb_tests;
+		insns[pc].op = NPF_OP_RETURN;
+		insns[pc].result = rule->result;
+		pc++;
+	}
+
+	insns[pc].op = NPF_OP_RETURN;
+	insns[pc].result = NET_DROP;
+
+	return 0;
+}
+
+static void wait_for_readers(struct npf_program *program)
+{
+	while (atomic_get(&program->readers) != 0) {
+		k_sleep(K_TICKS(1));
+	}
+}
+
+/* Compile the rule list and switch to the new program, called with update_lock held */
+static void update(struct npf_rule_list *rules)
+{
+	struct npf_program *old = atomic_ptr_get(&rules->program);
+	struct npf_program *new = (old == &rules->programs[0]) ? &rules->programs[1] :
+								&rules->programs[0];
+	k_spinlock_key_t key;
+	int ret;
+
+	/* Readers may still hold the program replaced by the previous update */
+	wait_for_readers(new);
+
+	key = k_spin_lock(&rules->lock);
+	ret = compile(&rules->rule_head, new);
+	k_spin_unlock(&rules->lock, key);
+
+	if (ret < 0) {
+		NET_WARN("rule list %p too large to compile, "
+			 "increase CONFIG_NET_PKT_FILTER_PROGRAM_SIZE", rules);
+		new = NULL;
+	}
+
+	atomic_ptr_set(&rules->program, new);
+
+	/* The caller may release the rules which were removed */
+	if (old != NULL) {
+		wait_for_readers(old);
+	}
+}
+
+static void update_lock_take(void)
+{
+	__ASSERT(!k_is_in_isr(), "rules can't be updated from ISR");
+
+	(void)k_mutex_lock(&update_lock, K_FOREVER);
+}
+
+static void update_lock_give(struct npf_rule_list *rules)
+{
+	update(rules);
+
+	(void)k_mutex_unlock(&update_lock);
+}
+#else
+#define update_lock_take()
+#define update_lock_give(rules)
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
+
 /*
  * Rule management
  */
 
 void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
+	update_lock_take();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+
+	update_lock_give(rules);
 }
 
 void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
@@ -186,26 +474,37 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_ok.node, "");
 	__ASSERT(sys_slist_peek_tail(&rules->rule_head) != &npf_default_drop.node, "");
 
+	update_lock_take();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+
+	update_lock_give(rules);
 }
 
 bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
+	update_lock_take();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
 
 	k_spin_unlock(&rules->lock, key);
+
+	update_lock_give(rules);
+
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
 }
 
 bool npf_remove_all_rules(struct npf_rule_list *rules)
 {
+	update_lock_take();
+
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = !sys_slist_is_empty(&rules->rule_head);
 
@@ -215,6 +514,9 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 	}
 
 	k_spin_unlock(&rules->lock, key);
+
+	update_lock_give(rules);
+
 	return result;
 }
 
@@ -65,9 +65,9 @@ extern "C" {
 #define sys_port_trace_k_thread_sched_wakeup(thread)
 #define sys_port_trace_k_thread_sched_abort(thread)
 #define sys_port_trace_k_thread_sched_priority_set(thread, prio)
-#define sys_port_trace_k_thread_sched_ready(thread)
+#define sys_port_trace_k_thread_sched_ready(thread) sys_trace_k_thread_ready(thread)
 
-#define sys_port_trace_k_thread_sched_pend(thread)
+#define sys_port_trace_k_thread_sched_pend(thread) sys_trace_k_thread_pend(thread)
 
 #define sys_port_trace_k_thread_sched_resume(thread)
 
@@ -113,6 +113,33 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/**
+ * @brief Stop or restart storing events in the tracing buffer.
+ *
+ * Events are dropped while the buffer is frozen.
+ *
+ * @param freeze True to freeze the buffer, false to restart it.
+ */
+void tracing_buffer_freeze(bool freeze);
+
+/**
+ * @brief Tracing buffer is frozen or not.
+ *
+ * @return true if the buffer is frozen, or false if not.
+ */
+bool tracing_buffer_is_frozen(void);
+
+/**
+ * @brief Get usage statistics of the tracing buffer of a CPU.
+ *
+ * @param cpu CPU ID.
+ * @param used Location for the number of bytes used.
+ * @param overwritten Location for the number of overwritten events.
+ */
+void tracing_buffer_cpu_stats_get(unsigned int cpu, uint32_t *used, uint32_t *overwritten);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <tracing_buffer.h>
+
+/* Each CPU writes events only to its own ring, with local interrupts
+ * masked by the caller, so there is no lock shared between CPUs. A ring
+ * is read by the tracing thread or by a flight recorder dump, possibly
+ * from another CPU: head is written by the producer only and tail by the
+ * consumer only. In flight recorder mode the consumer runs only while
+ * the recorder is frozen and the producer moves tail to overwrite the
+ * oldest events.
+ *
+ * Each event is stored as a record header followed by the event data.
+ * Both may wrap around the end of the ring. With CTF, the reader sends the
+ * CPU ID of the record ahead of its data, as the first field of the event
+ * header.
+ *
+ * Freezing waits for the records being written on the other CPUs, which
+ * are counted in writers, so that a frozen ring can be read safely.
+ */
+
+struct trace_rec_hdr {
+	uint16_t len;
+	uint8_t cpu;
+	uint8_t reserved;
+	uint32_t cyc;
+};
+
+#define REC_HDR_SIZE sizeof(struct trace_rec_hdr)
+#define RING_SIZE (CONFIG_TRACING_BUFFER_SIZE + 1)
+#define REC_MAX_LEN MIN(RING_SIZE - 1 - REC_HDR_SIZE, UINT16_MAX)
+#define REC_CPU_ID IS_ENABLED(CONFIG_TRACING_CTF)
+
+struct trace_ring {
+	atomic_t head;
+	atomic_t tail;
+	/* Records being written, 0 or 1 as the local CPU writes one at a time. */
+	atomic_t writers;
+	/* Bytes claimed for the record being written and its timestamp. */
+	uint32_t pending;
+	uint32_t cyc;
+	/* Records overwritten in flight recorder mode. */
+	uint32_t overwritten;
+	uint8_t buf[RING_SIZE];
+};
+
+static struct trace_ring rings[CONFIG_MP_MAX_NUM_CPUS];
+static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
+static atomic_t frozen;
+
+/* Ring of the record being read and number of its bytes left. */
+static struct trace_ring *rd_ring;
+static uint32_t rd_left;
+/* CPU ID of the record being read, until it is sent. */
+static uint8_t rd_cpu;
+static bool rd_cpu_pending;
+
+static inline uint32_t ring_wrap(uint32_t idx)
+{
+	return (idx >= RING_SIZE) ? (idx - RING_SIZE) : idx;
+}
+
+static inline uint32_t ring_used(uint32_t head, uint32_t tail)
+{
+	return ring_wrap(head + RING_SIZE - tail);
+}
+
+static void ring_read(struct trace_ring *ring, uint32_t idx, void *data, uint32_t len)
+{
+	uint8_t *dst = data;
+
+	for (uint32_t i = 0; i < len; i++) {
+		dst[i] = ring->buf[ring_wrap(idx + i)];
+	}
+}
+
+static void ring_write(struct trace_ring *ring, uint32_t idx, const void *data, uint32_t len)
+{
+	const uint8_t *src = data;
+
+	for (uint32_t i = 0; i < len; i++) {
+		ring->buf[ring_wrap(idx + i)] = src[i];
+	}
+}
+
+static inline struct trace_ring *ring_local(void)
+{
+	return &rings[_current_cpu->id];
+}
+
+static uint32_t ring_free(struct trace_ring *ring)
+{
+	return RING_SIZE - 1 - ring_used(atomic_get(&ring->head), atomic_get(&ring->tail));
+}
+
+/* Drop the oldest records until @p need bytes are free. */
+static void ring_evict(struct trace_ring *ring, uint32_t need)
+{
+	uint32_t head = atomic_get(&ring->head);
+	uint32_t tail = atomic_get(&ring->tail);
+
+	while ((tail != head) && ((RING_SIZE - 1 - ring_used(head, tail)) < need)) {
+		struct trace_rec_hdr hdr;
+
+		ring_read(ring, tail, &hdr, REC_HDR_SIZE);
+		tail = ring_wrap(tail + REC_HDR_SIZE + hdr.len);
+		ring->overwritten++;
+	}
+
+	atomic_set(&ring->tail, tail);
+}
+
+uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
+{
+	*data = &tracing_cmd_buffer[0];
+
+	return sizeof(tracing_cmd_buffer);
+}
+
+uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
+{
+	struct trace_ring *ring = ring_local();
+	uint32_t free, used, wr;
+
+	/* Counted before checking frozen, tracing_buffer_put_finish() ends it. */
+	if (atomic_get(&ring->writers) == 0) {
+		atomic_inc(&ring->writers);
+	}
+
+	if (atomic_get(&frozen)) {
+		return 0;
+	}
+
+	if (ring->pending == 0U) {
+		ring->cyc = k_cycle_get_32();
+	}
+
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		ring_evict(ring, REC_HDR_SIZE + ring->pending + size);
+	}
+
+	free = ring_free(ring);
+	used = REC_HDR_SIZE + ring->pending;
+	if ((free <= used) || (ring->pending >= REC_MAX_LEN)) {
+		return 0;
+	}
+
+	wr = ring_wrap(atomic_get(&ring->head) + used);
+	size = MIN(size, free - used);
+	size = MIN(size, REC_MAX_LEN - ring->pending);
+	size = MIN(size, RING_SIZE - wr);
+
+	*data = &ring->buf[wr];
+	ring->pending += size;
+
+	return size;
+}
+
+int tracing_buffer_put_finish(uint32_t size)
+{
+	struct trace_ring *ring = ring_local();
+	struct trace_rec_hdr hdr;
+	uint32_t head;
+
+	if (size > ring->pending) {
+		ring->pending = 0U;
+		atomic_clear(&ring->writers);
+		return -EINVAL;
+	}
+
+	ring->pending = 0U;
+	if (size == 0U) {
+		atomic_clear(&ring->writers);
+		return 0;
+	}
+
+	hdr.len = size;
+	hdr.cpu = _current_cpu->id;
+	hdr.reserved = 0U;
+	hdr.cyc = ring->cyc;
+
+	head = atomic_get(&ring->head);
+	ring_write(ring, head, &hdr, REC_HDR_SIZE);
+	atomic_set(&ring->head, ring_wrap(head + REC_HDR_SIZE + size));
+	atomic_clear(&ring->writers);
+
+	return 0;
+}
+
+uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
+{
+	uint32_t total = 0U;
+	uint32_t claimed;
+	uint8_t *dst;
+
+	do {
+		claimed = tracing_buffer_put_claim(&dst, size - total);
+		memcpy(dst, data + total, claimed);
+		total += claimed;
+	} while ((total < size) && (claimed > 0U));
+
+	(void)tracing_buffer_put_finish(total);
+
+	return total;
+}
+
+/* Ring holding the record with the oldest timestamp. */
+static struct trace_ring *ring_oldest(void)
+{
+	struct trace_ring *oldest = NULL;
+	uint32_t oldest_cyc = 0U;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(rings); i++) {
+		struct trace_ring *ring = &rings[i];
+		uint32_t tail = atomic_get(&ring->tail);
+		struct trace_rec_hdr hdr;
+
+		if (tail == (uint32_t)atomic_get(&ring->head)) {
+			continue;
+		}
+
+		ring_read(ring, tail, &hdr, REC_HDR_SIZE);
+		if ((oldest == NULL) || ((int32_t)(hdr.cyc - oldest_cyc) < 0)) {
+			oldest = ring;
+			oldest_cyc = hdr.cyc;
+		}
+	}
+
+	return oldest;
+}
+
+uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
+{
+	uint32_t tail;
+
+	if (rd_left == 0U) {
+		struct trace_rec_hdr hdr;
+
+		rd_ring = ring_oldest();
+		if (rd_ring == NULL) {
+			return 0;
+		}
+
+		tail = atomic_get(&rd_ring->tail);
+		ring_read(rd_ring, tail, &hdr, REC_HDR_SIZE);
+		rd_left = hdr.len;
+		rd_cpu = hdr.cpu;
+		rd_cpu_pending = REC_CPU_ID;
+		atomic_set(&rd_ring->tail, ring_wrap(tail + REC_HDR_SIZE));
+	}
+
+	if (rd_cpu_pending) {
+		*data = &rd_cpu;
+		return MIN(size, sizeof(rd_cpu));
+	}
+
+	tail = atomic_get(&rd_ring->tail);
+	*data = &rd_ring->buf[tail];
+
+	return MIN(size, MIN(rd_left, RING_SIZE - tail));
+}
+
+int tracing_buffer_get_finish(uint32_t size)
+{
+	if (rd_cpu_pending) {
+		if (size > sizeof(rd_cpu)) {
+			return -EINVAL;
+		}
+
+		rd_cpu_pending = (size == 0U);
+		return 0;
+	}
+
+	if (size > rd_left) {
+		return -EINVAL;
+	}
+
+	if (size > 0U) {
+		atomic_set(&rd_ring->tail, ring_wrap(atomic_get(&rd_ring->tail) + size));
+		rd_left -= size;
+	}
+
+	return 0;
+}
+
+uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
+{
+	uint32_t total = 0U;
+	uint32_t claimed;
+	uint8_t *src;
+
+	do {
+		claimed = tracing_buffer_get_claim(&src, size - total);
+		memcpy(data + total, src, claimed);
+		(void)tracing_buffer_get_finish(claimed);
+		total += claimed;
+	} while ((total < size) && (claimed > 0U));
+
+	return total;
+}
+
+void tracing_buffer_init(void)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(rings); i++) {
+		atomic_set(&rings[i].head, 0);
+		atomic_set(&rings[i].tail, 0);
+		atomic_clear(&rings[i].writers);
+		rings[i].pending = 0U;
+		rings[i].overwritten = 0U;
+	}
+
+	rd_ring = NULL;
+	rd_left = 0U;
+	rd_cpu_pending = false;
+}
+
+bool tracing_buffer_is_empty(void)
+{
+	if (rd_left > 0U) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (atomic_get(&rings[i].head) != atomic_get(&rings[i].tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint32_t tracing_buffer_capacity_get(void)
+{
+	return REC_MAX_LEN;
+}
+
+uint32_t tracing_buffer_space_get(void)
+{
+	struct trace_ring *ring = ring_local();
+	uint32_t free, used;
+
+	if (atomic_get(&frozen)) {
+		return 0;
+	}
+
+	/* Flight recorder makes room by overwriting the oldest events. */
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		return REC_MAX_LEN - ring->pending;
+	}
+
+	free = ring_free(ring);
+	used = REC_HDR_SIZE + ring->pending;
+
+	return (free > used) ? MIN(free - used, REC_MAX_LEN - ring->pending) : 0;
+}
+
+void tracing_buffer_freeze(bool freeze)
+{
+	unsigned int key;
+	struct trace_ring *local;
+
+	atomic_set(&frozen, freeze ? 1 : 0);
+	if (!freeze) {
+		return;
+	}
+
+	/* A record of the local CPU cannot be in progress unless freezing
+	 * from a fatal error in the middle of it, which must not wait.
+	 */
+	key = arch_irq_lock();
+	local = ring_local();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(rings); i++) {
+		while ((&rings[i] != local) && (atomic_get(&rings[i].writers) != 0)) {
+			arch_spin_relax();
+		}
+	}
+
+	arch_irq_unlock(key);
+}
+
+bool tracing_buffer_is_frozen(void)
+{
+	return atomic_get(&frozen) != 0;
+}
+
+void tracing_buffer_cpu_stats_get(unsigned int cpu, uint32_t *used, uint32_t *overwritten)
+{
+	struct trace_ring *ring = &rings[cpu];
+
+	*used = ring_used(atomic_get(&ring->head), atomic_get(&ring->tail));
+	*overwritten = ring->overwritten;
+}
@@ -107,11 +107,14 @@ static int tracing_init(void)
 	k_timer_init(&tracing_thread_timer,
 		     tracing_thread_timer_expiry_fn, NULL);
 
-	k_thread_create(&tracing_thread, tracing_thread_stack,
-			K_THREAD_STACK_SIZEOF(tracing_thread_stack),
-			tracing_thread_func, NULL, NULL, NULL,
-			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
-	k_thread_name_set(&tracing_thread, TRACING_THREAD_NAME);
+	/* Flight recorder keeps events until it is dumped. */
+	if (!IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		k_thread_create(&tracing_thread, tracing_thread_stack,
+				K_THREAD_STACK_SIZEOF(tracing_thread_stack),
+				tracing_thread_func, NULL, NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_name_set(&tracing_thread, TRACING_THREAD_NAME);
+	}
 #endif
 
 	return 0;
@@ -122,7 +125,7 @@ SYS_INIT(tracing_init, APPLICATION, 0);
 #ifdef CONFIG_TRACING_ASYNC
 void tracing_trigger_output(bool before_put_is_empty)
 {
-	if (before_put_is_empty) {
+	if (before_put_is_empty && !IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
 		k_timer_start(&tracing_thread_timer,
 			      K_MSEC(CONFIG_TRACING_THREAD_WAIT_THRESHOLD),
 			      K_NO_WAIT);
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/tracing/flight_recorder.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+static atomic_t dumping;
+
+void tracing_flight_recorder_freeze(void)
+{
+	tracing_buffer_freeze(true);
+}
+
+void tracing_flight_recorder_resume(void)
+{
+	tracing_buffer_freeze(false);
+}
+
+bool tracing_flight_recorder_is_frozen(void)
+{
+	return tracing_buffer_is_frozen();
+}
+
+uint32_t tracing_flight_recorder_dump(void)
+{
+	uint32_t capacity = tracing_buffer_capacity_get();
+	uint32_t total = 0U;
+	bool was_frozen;
+
+	/* Only one reader of the buffer at a time. */
+	if (!atomic_cas(&dumping, 0, 1)) {
+		return 0;
+	}
+
+	was_frozen = tracing_buffer_is_frozen();
+	tracing_buffer_freeze(true);
+
+	while (!tracing_buffer_is_empty()) {
+		uint8_t *data;
+		uint32_t length;
+
+		length = tracing_buffer_get_claim(&data, capacity);
+		tracing_buffer_handle(data, length);
+		tracing_buffer_get_finish(length);
+		total += length;
+	}
+
+	if (!was_frozen) {
+		tracing_buffer_freeze(false);
+	}
+
+	atomic_set(&dumping, 0);
+
+	return total;
+}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER_SHELL
+static int cmd_freeze(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	tracing_flight_recorder_freeze();
+	shell_print(sh, "Flight recorder frozen");
+
+	return 0;
+}
+
+static int cmd_resume(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	tracing_flight_recorder_resume();
+	shell_print(sh, "Flight recorder resumed");
+
+	return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%u bytes sent to the backend", tracing_flight_recorder_dump());
+
+	return 0;
+}
+
+static int cmd_status(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Flight recorder %s",
+		    tracing_flight_recorder_is_frozen() ? "frozen" : "recording");
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		uint32_t used, overwritten;
+
+		tracing_buffer_cpu_stats_get(cpu, &used, &overwritten);
+		shell_print(sh, "\tCPU %u: %u of %u bytes used, %u events overwritten", cpu,
+			    used, CONFIG_TRACING_BUFFER_SIZE, overwritten);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_tracing,
+	SHELL_CMD(dump, NULL, "Send recorded events to the tracing backend", cmd_dump),
+	SHELL_CMD(freeze, NULL, "Stop recording events", cmd_freeze),
+	SHELL_CMD(resume, NULL, "Resume recording events", cmd_resume),
+	SHELL_CMD(status, NULL, "Flight recorder status", cmd_status),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(tracing, &sub_tracing, "Tracing flight recorder commands", NULL);
+#endif /* CONFIG_TRACING_FLIGHT_RECORDER_SHELL */
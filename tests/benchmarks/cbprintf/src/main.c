@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the integer and floating point conversions of the complete
+ * cbprintf formatter. Run the benchmark.cbprintf and
+ * benchmark.cbprintf.fast_conversion scenarios to compare the default
+ * conversions with CONFIG_CBPRINTF_FAST_CONVERSION.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/cbprintf.h>
+
+#define ITERATIONS 20000
+
+struct int_case {
+	const char *fmt;
+	unsigned long long value;
+	const char *expected;
+};
+
+struct fp_case {
+	const char *fmt;
+	double value;
+	const char *expected;
+};
+
+static const struct int_case int_cases[] = {
+	{ "%u", 7U, "7" },
+	{ "%u", 4000000000U, "4000000000" },
+	{ "%llu", 18446744073709551615ULL, "18446744073709551615" },
+	{ "%x", 0xdeadbeefU, "deadbeef" },
+	{ "%llo", 01234567012345670ULL, "1234567012345670" },
+};
+
+static const struct fp_case fp_cases[] = {
+	{ "%f", 3.14159265358979, "3.141593" },
+	{ "%.3f", 1234567.891, "1234567.891" },
+	{ "%e", 6.02214076e23, "6.022141e+23" },
+	{ "%e", 1.602176634e-19, "1.602177e-19" },
+	{ "%g", 0.000123456, "0.000123456" },
+	{ "%.10g", 1.7976931348623157e308, "1.797693135e+308" },
+};
+
+static char buf[64];
+
+static void report(const char *fmt, const char *out, timing_t *start, timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("%-6s %-24s %6llu ns/op\n", fmt, out,
+		 (unsigned long long)(ns / ITERATIONS));
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST(cbprintf_bench, test_integer)
+{
+	timing_t start, end;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(int_cases); i++) {
+		const struct int_case *c = &int_cases[i];
+		bool is_ll = (strstr(c->fmt, "ll") != NULL);
+
+		if (is_ll) {
+			snprintfcb(buf, sizeof(buf), c->fmt, c->value);
+		} else {
+			snprintfcb(buf, sizeof(buf), c->fmt, (unsigned int)c->value);
+		}
+		zassert_equal(strcmp(buf, c->expected), 0, "%s: got %s, expected %s",
+			      c->fmt, buf, c->expected);
+
+		start = timing_counter_get();
+
+		for (j = 0; j < ITERATIONS; j++) {
+			if (is_ll) {
+				snprintfcb(buf, sizeof(buf), c->fmt, c->value);
+			} else {
+				snprintfcb(buf, sizeof(buf), c->fmt, (unsigned int)c->value);
+			}
+		}
+
+		end = timing_counter_get();
+		report(c->fmt, c->expected, &start, &end);
+	}
+}
+
+ZTEST(cbprintf_bench, test_float)
+{
+	timing_t start, end;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(fp_cases); i++) {
+		const struct fp_case *c = &fp_cases[i];
+
+		snprintfcb(buf, sizeof(buf), c->fmt, c->value);
+		zassert_equal(strcmp(buf, c->expected), 0, "%s: got %s, expected %s",
+			      c->fmt, buf, c->expected);
+
+		start = timing_counter_get();
+
+		for (j = 0; j < ITERATIONS; j++) {
+			snprintfcb(buf, sizeof(buf), c->fmt, c->value);
+		}
+
+		end = timing_counter_get();
+		report(c->fmt, c->expected, &start, &end);
+	}
+}
+
+ZTEST_SUITE(cbprintf_bench, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Load the HTTP server over the loopback interface. The load generator
+ * fetches a static page and a dynamic page using a new connection for
+ * every request, persistent connections, and pipelined requests over
+ * several persistent connections.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+
+#define SERVER_ADDR "127.0.0.1"
+/* Leave room for a connection the server has not seen closed yet */
+#define CONNECTIONS (CONFIG_HTTP_SERVER_MAX_CLIENTS - 1)
+#define PIPELINE_DEPTH 4
+#define REQUESTS 200
+#define PAGE_SIZE 2048
+#define RECV_TIMEOUT_SEC 5
+
+static uint16_t bench_service_port;
+HTTP_SERVICE_DEFINE(bench_service, SERVER_ADDR, &bench_service_port,
+		    CONFIG_HTTP_SERVER_MAX_CLIENTS, CONNECTIONS, NULL);
+
+static const uint8_t page[PAGE_SIZE] = {
+	[0 ... PAGE_SIZE - 1] = 'x',
+};
+
+static struct http_resource_detail_static page_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.content_type = "text/html",
+	},
+	.static_data = page,
+	.static_data_len = sizeof(page),
+};
+
+HTTP_RESOURCE_DEFINE(page_resource, bench_service, "/page.html", &page_detail);
+
+static uint8_t dynamic_buf[128];
+
+static int dynamic_cb(struct http_client_ctx *client,
+		      enum http_data_status status, uint8_t *data, size_t len,
+		      void *user_data)
+{
+	bool *done = user_data;
+
+	ARG_UNUSED(client);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* One chunk of the whole buffer, then the last chunk */
+	*done = !*done;
+	if (!*done) {
+		return 0;
+	}
+
+	memset(data, 'y', len);
+
+	return len;
+}
+
+static bool dynamic_done;
+
+static struct http_resource_detail_dynamic dynamic_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+	},
+	.cb = dynamic_cb,
+	.data_buffer = dynamic_buf,
+	.data_buffer_len = sizeof(dynamic_buf),
+	.user_data = &dynamic_done,
+};
+
+HTTP_RESOURCE_DEFINE(dynamic_resource, bench_service, "/dynamic",
+		     &dynamic_detail);
+
+static const char page_request[] = "GET /page.html HTTP/1.1\r\n\r\n";
+static const char dynamic_request[] = "GET /dynamic HTTP/1.1\r\n\r\n";
+
+static size_t page_response_len;
+static size_t dynamic_response_len;
+static uint8_t recv_buf[PAGE_SIZE + 128];
+
+static void report(const char *name, uint32_t count, size_t bytes,
+		   timing_t *start, timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("%-36s: %5u req, %8llu ns/req, %6llu KiB/s\n", name, count,
+		 (unsigned long long)(ns / count),
+		 ns ? (unsigned long long)(bytes * NSEC_PER_SEC / ns / 1024) : 0);
+}
+
+static int client_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(bench_service_port),
+	};
+	struct timeval timeo = {
+		.tv_sec = RECV_TIMEOUT_SEC,
+	};
+	int sock;
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr), 1);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+				    sizeof(timeo)));
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot connect (%d)", errno);
+
+	return sock;
+}
+
+static void client_send(int sock, const char *req, size_t len)
+{
+	zassert_equal(zsock_send(sock, req, len, 0), len, "Cannot send (%d)",
+		      errno);
+}
+
+/* Receive the given number of bytes, verify the start of a response */
+static void client_recv(int sock, size_t len)
+{
+	size_t received = 0;
+	ssize_t ret;
+
+	while (received < len) {
+		ret = zsock_recv(sock, recv_buf,
+				 MIN(len - received, sizeof(recv_buf)), 0);
+		zassert_true(ret > 0, "Response truncated (%d)", errno);
+
+		if (received == 0) {
+			zassert_mem_equal(recv_buf, "HTTP/1.1 200 OK\r\n",
+					  MIN(ret, 17), "Invalid response");
+		}
+
+		received += ret;
+	}
+}
+
+/* Find the response length by receiving until the connection is closed */
+static size_t response_len(const char *request)
+{
+	size_t len = 0;
+	ssize_t ret;
+	int sock;
+
+	sock = client_connect();
+
+	client_send(sock, request, strlen(request) - 2);
+	client_send(sock, "Connection: close\r\n\r\n", 21);
+
+	while ((ret = zsock_recv(sock, recv_buf, sizeof(recv_buf), 0)) > 0) {
+		len += ret;
+	}
+
+	zassert_equal(ret, 0, "recv failed (%d)", errno);
+	zsock_close(sock);
+
+	/* Without the Connection: close header */
+	return len - (sizeof("Connection: close\r\n") - 1);
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	zassert_ok(http_server_start(), "Cannot start server");
+
+	page_response_len = response_len(page_request);
+	dynamic_response_len = response_len(dynamic_request);
+
+	zassert_true(page_response_len > PAGE_SIZE);
+	zassert_true(dynamic_response_len > sizeof(dynamic_buf));
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)http_server_stop();
+	timing_stop();
+}
+
+static void bench_connection_per_request(const char *name, const char *request,
+					 size_t resp_len, int count)
+{
+	timing_t start, end;
+	int i, sock;
+
+	start = timing_counter_get();
+
+	for (i = 0; i < count; i++) {
+		sock = client_connect();
+		client_send(sock, request, strlen(request));
+		client_recv(sock, resp_len);
+		zsock_close(sock);
+	}
+
+	end = timing_counter_get();
+	report(name, count, count * resp_len, &start, &end);
+}
+
+static void bench_keep_alive(const char *name, const char *request,
+			     size_t resp_len)
+{
+	timing_t start, end;
+	int i, sock;
+
+	sock = client_connect();
+
+	start = timing_counter_get();
+
+	for (i = 0; i < REQUESTS; i++) {
+		client_send(sock, request, strlen(request));
+		client_recv(sock, resp_len);
+	}
+
+	end = timing_counter_get();
+	report(name, REQUESTS, REQUESTS * resp_len, &start, &end);
+
+	zsock_close(sock);
+}
+
+static void bench_pipelined(const char *name, const char *request,
+			    size_t resp_len)
+{
+	static char batch[PIPELINE_DEPTH * sizeof(page_request)];
+	int socks[CONNECTIONS];
+	size_t batch_len = 0;
+	timing_t start, end;
+	int i, j, rounds;
+
+	for (i = 0; i < PIPELINE_DEPTH; i++) {
+		memcpy(batch + batch_len, request, strlen(request));
+		batch_len += strlen(request);
+	}
+
+	for (i = 0; i < CONNECTIONS; i++) {
+		socks[i] = client_connect();
+	}
+
+	rounds = REQUESTS / (CONNECTIONS * PIPELINE_DEPTH);
+
+	start = timing_counter_get();
+
+	for (i = 0; i < rounds; i++) {
+		/* Every connection has requests in flight at the same time */
+		for (j = 0; j < CONNECTIONS; j++) {
+			client_send(socks[j], batch, batch_len);
+		}
+
+		for (j = 0; j < CONNECTIONS; j++) {
+			client_recv(socks[j], PIPELINE_DEPTH * resp_len);
+		}
+	}
+
+	end = timing_counter_get();
+	report(name, rounds * CONNECTIONS * PIPELINE_DEPTH,
+	       rounds * CONNECTIONS * PIPELINE_DEPTH * resp_len, &start, &end);
+
+	for (i = 0; i < CONNECTIONS; i++) {
+		zsock_close(socks[i]);
+	}
+}
+
+ZTEST(http_server_bench, test_static)
+{
+	bench_connection_per_request("static, connection per request",
+				     page_request, page_response_len,
+				     REQUESTS / 10);
+	bench_keep_alive("static, keep-alive", page_request,
+			 page_response_len);
+	bench_pipelined("static, pipelined", page_request, page_response_len);
+}
+
+ZTEST(http_server_bench, test_dynamic)
+{
+	bench_connection_per_request("dynamic, connection per request",
+				     dynamic_request, dynamic_response_len,
+				     REQUESTS / 10);
+	bench_keep_alive("dynamic, keep-alive", dynamic_request,
+			 dynamic_response_len);
+	bench_pipelined("dynamic, pipelined", dynamic_request,
+			dynamic_response_len);
+}
+
+ZTEST_SUITE(http_server_bench, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the latency of a deferred log call while 1 to N CPUs are logging
+ * at the same time. Each CPU runs one logging thread, the messages are
+ * processed and discarded between the rounds. Compare the
+ * benchmark.logging.smp.shared_buffer and per_cpu_buffers scenarios.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(log_smp_bench, LOG_LEVEL_INF);
+
+#define CALLS 100
+#define STACK_SIZE 1024
+#define PRIORITY 5
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t ready;
+static K_EVENT_DEFINE(go);
+static uint32_t processed;
+static uint32_t dropped;
+
+static void process(struct log_backend const *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+	ARG_UNUSED(msg);
+
+	processed++;
+}
+
+static void drop(struct log_backend const *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	dropped += cnt;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+	.dropped = drop,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static void logger(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	timing_t start, end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all the CPUs at the same time */
+	atomic_inc(&ready);
+	(void)k_event_wait(&go, BIT(0), false, K_FOREVER);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < CALLS; i++) {
+		LOG_INF("cpu %d call %d", id, i);
+	}
+
+	end = timing_counter_get();
+	cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void bench_cpus(unsigned int cpus)
+{
+	uint64_t total = 0;
+	unsigned int i;
+
+	atomic_set(&ready, 0);
+	k_event_clear(&go, BIT(0));
+	processed = 0;
+	dropped = 0;
+
+	for (i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger, INT_TO_POINTER(i),
+				NULL, NULL, PRIORITY, 0, K_FOREVER);
+#if defined(CONFIG_SCHED_CPU_MASK)
+		zassert_ok(k_thread_cpu_pin(&threads[i], i));
+#endif
+		k_thread_start(&threads[i]);
+	}
+
+	while (atomic_get(&ready) < cpus) {
+		k_msleep(1);
+	}
+
+	/* Let the last thread reach the wait */
+	k_msleep(1);
+	k_event_post(&go, BIT(0));
+
+	for (i = 0; i < cpus; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+		total += cycles[i];
+	}
+
+	while (log_process()) {
+	}
+
+	TC_PRINT("%u CPU(s): %6llu ns/call, %u processed, %u dropped\n", cpus,
+		 (unsigned long long)(timing_cycles_to_ns(total) / (cpus * CALLS)),
+		 processed, dropped);
+
+	zassert_equal(processed + dropped, cpus * CALLS, "Messages lost");
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	while (log_process()) {
+	}
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST(log_smp_bench, test_log_latency)
+{
+	for (unsigned int cpus = 1; cpus <= arch_num_cpus(); cpus++) {
+		bench_cpus(cpus);
+	}
+}
+
+ZTEST_SUITE(log_smp_bench, NULL, setup, NULL, NULL, teardown);
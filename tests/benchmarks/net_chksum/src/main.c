@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the Internet checksum over frames from 64 bytes to 9 KiB, and the
+ * incremental update used when only a few header fields change. Compare the
+ * results on 32-bit (qemu_x86) and 64-bit (qemu_x86_64) targets.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+
+#define MAX_LEN 9000
+#define BYTES_PER_SIZE (256 * 1024)
+#define UPDATES 20000
+
+static const size_t sizes[] = { 64, 512, 1500, 4096, 9000 };
+
+static uint8_t data[MAX_LEN + 8] __aligned(8);
+
+/* Reference implementation, one 16-bit word at a time */
+static uint16_t chksum_ref(const uint8_t *buf, size_t len)
+{
+	uint32_t sum = 0U;
+
+	while (len > 1) {
+		sum += (buf[0] << 8) | buf[1];
+		buf += 2;
+		len -= 2;
+	}
+
+	if (len) {
+		sum += buf[0] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+static void report(const char *name, size_t len, uint32_t count,
+		   timing_t *start, timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("%-24s %5zu B: %8llu ns/op, %6llu MB/s\n", name, len,
+		 (unsigned long long)(ns / count),
+		 (unsigned long long)(ns ? (uint64_t)len * count * 1000U / ns : 0));
+}
+
+static void *setup(void)
+{
+	uint32_t state = 0x2545f491;
+	int i;
+
+	for (i = 0; i < sizeof(data); i++) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		data[i] = state;
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+static void bench_chksum(const char *name, int offset)
+{
+	timing_t start, end;
+	volatile uint16_t sum;
+	uint32_t count;
+	int i, j;
+
+	for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+		zassert_equal(calc_chksum(0, data + offset, sizes[i]),
+			      chksum_ref(data + offset, sizes[i]),
+			      "Wrong checksum for %zu bytes", sizes[i]);
+
+		count = BYTES_PER_SIZE / sizes[i];
+
+		start = timing_counter_get();
+
+		for (j = 0; j < count; j++) {
+			sum = calc_chksum(0, data + offset, sizes[i]);
+		}
+
+		end = timing_counter_get();
+		report(name, sizes[i], count, &start, &end);
+	}
+
+	ARG_UNUSED(sum);
+}
+
+ZTEST(net_chksum_bench, test_chksum_aligned)
+{
+	bench_chksum("checksum", 0);
+}
+
+ZTEST(net_chksum_bench, test_chksum_unaligned)
+{
+	bench_chksum("checksum, odd offset", 1);
+}
+
+ZTEST(net_chksum_bench, test_chksum_update)
+{
+	struct in6_addr old_addr, new_addr;
+	uint16_t chksum, full;
+	timing_t start, end;
+	int i;
+
+	memcpy(&old_addr, data, sizeof(old_addr));
+	memcpy(&new_addr, data + 64, sizeof(new_addr));
+
+	/* Verify against a full recalculation before measuring, the
+	 * checksum field is in network byte order.
+	 */
+	chksum = htons(~calc_chksum(0, data, 1500));
+	memcpy(data, &new_addr, sizeof(new_addr));
+	full = htons(~calc_chksum(0, data, 1500));
+	memcpy(data, &old_addr, sizeof(old_addr));
+
+	zassert_equal(net_chksum_update(chksum, &old_addr, &new_addr,
+					sizeof(old_addr)), full,
+		      "Wrong incremental checksum");
+
+	start = timing_counter_get();
+
+	for (i = 0; i < UPDATES; i++) {
+		chksum = net_chksum_update_16(chksum, i, i + 1);
+	}
+
+	end = timing_counter_get();
+	report("16-bit update", sizeof(uint16_t), UPDATES, &start, &end);
+
+	start = timing_counter_get();
+
+	for (i = 0; i < UPDATES; i++) {
+		chksum = net_chksum_update(chksum, &old_addr, &new_addr,
+					   sizeof(old_addr));
+	}
+
+	end = timing_counter_get();
+	report("IPv6 address update", sizeof(old_addr), UPDATES, &start, &end);
+}
+
+ZTEST_SUITE(net_chksum_bench, NULL, setup, NULL, NULL, teardown);
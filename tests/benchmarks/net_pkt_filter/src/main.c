@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the receive filter check done for every received packet with a
+ * large rule list, similar to an access list: the rules drop the packets
+ * of a given Ethernet type within a size range, and are grouped by type.
+ * Run the benchmark.net.pkt_filter.linear scenario to compare against the
+ * rule by rule evaluation.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_pkt_filter.h>
+
+#define RULES 128
+#define TYPES 4
+#define RULES_PER_TYPE (RULES / TYPES)
+#define MIN_SIZE 200
+#define SIZE_STEP 8
+#define LOOKUPS 10000
+#define UPDATES 100
+
+static NPF_ETH_TYPE_MATCH(type_ip, NET_ETH_PTYPE_IP);
+static NPF_ETH_TYPE_MATCH(type_ipv6, NET_ETH_PTYPE_IPV6);
+static NPF_ETH_TYPE_MATCH(type_arp, NET_ETH_PTYPE_ARP);
+static NPF_ETH_TYPE_MATCH(type_vlan, NET_ETH_PTYPE_VLAN);
+
+static struct npf_test_eth_type *const types[TYPES] = {
+	&type_ip, &type_ipv6, &type_arp, &type_vlan,
+};
+
+static const uint16_t ptypes[TYPES] = {
+	NET_ETH_PTYPE_IP, NET_ETH_PTYPE_IPV6, NET_ETH_PTYPE_ARP, NET_ETH_PTYPE_VLAN,
+};
+
+/* The type condition of every rule is set by setup() */
+#define BENCH_RULE(i, _)						\
+	static NPF_SIZE_BOUNDS(bench_size_##i, MIN_SIZE + (i) * SIZE_STEP, \
+			       MIN_SIZE + (i) * SIZE_STEP + SIZE_STEP / 2); \
+	static NPF_RULE(bench_rule_##i, NET_DROP, type_ip, bench_size_##i)
+
+#define BENCH_RULE_PTR(i, _) &bench_rule_##i
+
+LISTIFY(RULES, BENCH_RULE, (;));
+
+static struct npf_rule *const rules[RULES] = {
+	LISTIFY(RULES, BENCH_RULE_PTR, (,))
+};
+
+static struct net_pkt *build_pkt(uint16_t type, size_t size)
+{
+	struct net_eth_hdr eth_hdr = { 0 };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(NULL, size, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	eth_hdr.type = htons(type);
+
+	zassert_ok(net_pkt_write(pkt, &eth_hdr, sizeof(eth_hdr)));
+	zassert_ok(net_pkt_memset(pkt, 0, size - sizeof(eth_hdr)));
+
+	return pkt;
+}
+
+static void report(const char *name, uint32_t count, timing_t *start,
+		   timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("%-36s: %6u ops, %8llu ns/op\n", name, count,
+		 (unsigned long long)(ns / count));
+}
+
+static void bench_recv(const char *name, uint16_t type, size_t size, bool expected)
+{
+	struct net_pkt *pkt = build_pkt(type, size);
+	timing_t start, end;
+	int i;
+
+	zassert_equal(net_pkt_filter_recv_ok(pkt), expected, "Unexpected verdict for %s",
+		      name);
+
+	start = timing_counter_get();
+
+	for (i = 0; i < LOOKUPS; i++) {
+		(void)net_pkt_filter_recv_ok(pkt);
+	}
+
+	end = timing_counter_get();
+	report(name, LOOKUPS, &start, &end);
+
+	net_pkt_unref(pkt);
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < RULES; i++) {
+		rules[i]->tests[0] = &types[i / RULES_PER_TYPE]->test;
+	}
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST(net_pkt_filter_bench, test_recv)
+{
+	timing_t start, end;
+	int i;
+
+	start = timing_counter_get();
+
+	for (i = 0; i < RULES; i++) {
+		npf_append_recv_rule(rules[i]);
+	}
+
+	npf_append_recv_rule(&npf_default_ok);
+
+	end = timing_counter_get();
+	report("rule append", RULES + 1, &start, &end);
+
+	bench_recv("IPv4, accepted", ptypes[0], 100, true);
+	bench_recv("ARP, accepted", ptypes[2], MIN_SIZE + SIZE_STEP - 1, true);
+	bench_recv("IPv6, dropped by rule 40", ptypes[1],
+		   MIN_SIZE + 40 * SIZE_STEP + 1, false);
+	bench_recv("VLAN, dropped by last rule", ptypes[3],
+		   MIN_SIZE + (RULES - 1) * SIZE_STEP, false);
+	bench_recv("unknown type, accepted", 0x88b5, 100, true);
+
+	start = timing_counter_get();
+
+	for (i = 0; i < UPDATES; i++) {
+		zassert_true(npf_remove_recv_rule(rules[RULES / 2]));
+		npf_insert_recv_rule(rules[RULES / 2]);
+	}
+
+	end = timing_counter_get();
+	report("rule remove and insert", UPDATES * 2, &start, &end);
+
+	zassert_true(npf_remove_all_recv_rules());
+}
+
+ZTEST_SUITE(net_pkt_filter_bench, NULL, setup, NULL, NULL, teardown);
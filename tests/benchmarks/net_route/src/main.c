@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the forwarding decision, i.e. the route lookup and next hop
+ * resolution done for every forwarded packet, with a large routing table.
+ * Run the benchmark.net.route.linear scenario to compare against the
+ * linear route table.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/dummy.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+#define NEXTHOPS 16
+/* Neighbor reference count is 8 bits, so spread the routes */
+#define IPV6_ROUTES MIN(CONFIG_NET_MAX_ROUTES, NEXTHOPS * 128)
+#define DESTINATIONS 1024
+#define LOOKUPS 20000
+#define HOT_DESTINATIONS 4
+
+static uint8_t mac_addr[6] = {
+	0x00, 0x00, 0x5E, 0x00, 0x53, 0x01
+};
+static uint8_t nexthop_mac[NEXTHOPS][6];
+
+static struct in6_addr nexthops[NEXTHOPS];
+static struct in6_addr dst6[DESTINATIONS];
+static int expected6[DESTINATIONS];
+
+static struct net_if *iface;
+static uint32_t rand_state = 0x12345678;
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic xorshift so that every run uses the same table */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void bench_iface_init(struct net_if *net_iface)
+{
+	net_if_set_link_addr(net_iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static void route6_prefix(int idx, struct in6_addr *addr)
+{
+	/* 2001:db8:<idx>:<idx * 7>::/64, all prefixes are disjoint */
+	(void)memset(addr, 0, sizeof(*addr));
+	addr->s6_addr[0] = 0x20;
+	addr->s6_addr[1] = 0x01;
+	addr->s6_addr[2] = 0x0d;
+	addr->s6_addr[3] = 0xb8;
+	UNALIGNED_PUT(htons(idx), &addr->s6_addr16[2]);
+	UNALIGNED_PUT(htons(idx * 7), &addr->s6_addr16[3]);
+}
+
+static void report(const char *name, uint32_t count, timing_t *start,
+		   timing_t *end)
+{
+	uint64_t ns = timing_cycles_to_ns(timing_cycles_get(start, end));
+
+	TC_PRINT("%-36s: %6u ops, %8llu ns/op\n", name, count,
+		 (unsigned long long)(ns / count));
+}
+
+static void *setup(void)
+{
+	timing_init();
+	timing_start();
+
+	iface = net_if_get_default();
+	zassert_not_null(iface, "No interface");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST(net_route_bench, test_ipv6_forwarding)
+{
+	struct net_route_entry *route;
+	struct in6_addr *nexthop;
+	struct in6_addr prefix;
+	timing_t start, end;
+	int i;
+
+	for (i = 0; i < NEXTHOPS; i++) {
+		struct net_linkaddr lladdr = {
+			.addr = nexthop_mac[i],
+			.len = sizeof(nexthop_mac[i]),
+			.type = NET_LINK_ETHERNET,
+		};
+
+		nexthop_mac[i][0] = 0x02;
+		nexthop_mac[i][5] = i + 1;
+
+		net_ipv6_addr_create(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0,
+				     i + 1);
+		zassert_not_null(net_ipv6_nbr_add(iface, &nexthops[i], &lladdr,
+						  false,
+						  NET_IPV6_NBR_STATE_REACHABLE),
+				 "Cannot add neighbor %d", i);
+	}
+
+	start = timing_counter_get();
+
+	for (i = 0; i < IPV6_ROUTES; i++) {
+		route6_prefix(i, &prefix);
+
+		route = net_route_add(iface, &prefix, 64, &nexthops[i % NEXTHOPS],
+				      NET_IPV6_ND_INFINITE_LIFETIME,
+				      NET_ROUTE_PREFERENCE_MEDIUM);
+		zassert_not_null(route, "Cannot add route %d", i);
+	}
+
+	end = timing_counter_get();
+	report("IPv6 route add", IPV6_ROUTES, &start, &end);
+
+	for (i = 0; i < DESTINATIONS; i++) {
+		if ((next_rand() % 8) == 0) {
+			/* Some destinations have no route */
+			net_ipv6_addr_create(&dst6[i], 0x2001, 0xdb9, 0, 0, 0,
+					     0, 0, i);
+			expected6[i] = -1;
+			continue;
+		}
+
+		expected6[i] = next_rand() % IPV6_ROUTES;
+		route6_prefix(expected6[i], &dst6[i]);
+		UNALIGNED_PUT(next_rand(), &dst6[i].s6_addr32[2]);
+		UNALIGNED_PUT(next_rand(), &dst6[i].s6_addr32[3]);
+	}
+
+	/* Verify the results before measuring */
+	for (i = 0; i < DESTINATIONS; i++) {
+		bool found = net_route_get_info(iface, &dst6[i], &route,
+						&nexthop);
+
+		if (expected6[i] < 0) {
+			zassert_false(found, "Unexpected route for %d", i);
+			continue;
+		}
+
+		zassert_true(found, "No route for %d", i);
+		zassert_not_null(route, "No route entry for %d", i);
+		zassert_true(net_ipv6_addr_cmp(nexthop,
+					       &nexthops[expected6[i] % NEXTHOPS]),
+			     "Wrong next hop for %d", i);
+	}
+
+	start = timing_counter_get();
+
+	for (i = 0; i < LOOKUPS; i++) {
+		(void)net_route_get_info(iface, &dst6[i % DESTINATIONS],
+					 &route, &nexthop);
+	}
+
+	end = timing_counter_get();
+	report("IPv6 forwarding lookup", LOOKUPS, &start, &end);
+
+	start = timing_counter_get();
+
+	for (i = 0; i < LOOKUPS; i++) {
+		(void)net_route_get_info(iface, &dst6[i % HOT_DESTINATIONS],
+					 &route, &nexthop);
+	}
+
+	end = timing_counter_get();
+	report("IPv6 forwarding lookup, few flows", LOOKUPS, &start, &end);
+}
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+#define IPV4_ROUTES CONFIG_NET_MAX_IPV4_ROUTES
+
+static struct in_addr dst4[DESTINATIONS];
+static struct in_addr gw4[DESTINATIONS];
+
+static void route4_gw(int idx, struct in_addr *gw)
+{
+	gw->s_addr = htonl(0xc0a80001 + (idx % NEXTHOPS));
+}
+
+ZTEST(net_route_bench, test_ipv4_forwarding)
+{
+	struct in_addr prefix, gw, nexthop;
+	timing_t start, end;
+	int i;
+
+	/* 10.0.0.0/8 covers the destinations without a more specific route */
+	prefix.s_addr = htonl(0x0a000000);
+	gw.s_addr = htonl(0xc0a800fe);
+	zassert_not_null(net_route_ipv4_add(iface, &prefix, 8, &gw), "");
+
+	start = timing_counter_get();
+
+	for (i = 0; i < IPV4_ROUTES - 1; i++) {
+		/* 10.<i / 256>.<i % 256>.0/24 */
+		prefix.s_addr = htonl(0x0a000000 | (i << 8));
+		route4_gw(i, &gw);
+
+		zassert_not_null(net_route_ipv4_add(iface, &prefix, 24, &gw),
+				 "Cannot add route %d", i);
+	}
+
+	end = timing_counter_get();
+	report("IPv4 route add", IPV4_ROUTES - 1, &start, &end);
+
+	for (i = 0; i < DESTINATIONS; i++) {
+		uint32_t idx = next_rand() % IPV4_ROUTES;
+
+		if (idx == IPV4_ROUTES - 1) {
+			/* Only covered by the /8 route */
+			dst4[i].s_addr = htonl(0x0aff0001);
+			gw4[i].s_addr = htonl(0xc0a800fe);
+			continue;
+		}
+
+		dst4[i].s_addr = htonl(0x0a000000 | (idx << 8) |
+				       (next_rand() & 0xff));
+		route4_gw(idx, &gw4[i]);
+	}
+
+	for (i = 0; i < DESTINATIONS; i++) {
+		zassert_ok(net_route_ipv4_get_nexthop(iface, &dst4[i],
+						      &nexthop),
+			   "No route for %d", i);
+		zassert_true(net_ipv4_addr_cmp(&nexthop, &gw4[i]),
+			     "Wrong next hop for %d", i);
+	}
+
+	start = timing_counter_get();
+
+	for (i = 0; i < LOOKUPS; i++) {
+		(void)net_route_ipv4_get_nexthop(iface, &dst4[i % DESTINATIONS],
+						 &nexthop);
+	}
+
+	end = timing_counter_get();
+	report("IPv4 forwarding lookup", LOOKUPS, &start, &end);
+}
+#else
+ZTEST(net_route_bench, test_ipv4_forwarding)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+ZTEST_SUITE(net_route_bench, NULL, setup, NULL, NULL, teardown);
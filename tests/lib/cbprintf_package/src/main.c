@@ -825,6 +825,85 @@ ZTEST(cbprintf_package, test_cbprintf_must_runtime_package)
 	zassert_equal(rv, 0);
 }
 
+#ifdef CONFIG_CBPRINTF_PACKAGE_ARG_DESC
+/* Package created with the argument descriptor must be the same as the one
+ * created by parsing the format string.
+ */
+#define TEST_PACKAGING_DESC(flags, fmt, ...) do { \
+	CBPRINTF_ARG_DESC_DEFINE(arg_desc, fmt, __VA_ARGS__); \
+	snprintfcb(compare_buf, sizeof(compare_buf), fmt, __VA_ARGS__); \
+	printk("-----------------------------------------\n"); \
+	printk("%s\n", compare_buf); \
+	struct out_buffer desc_buf = { \
+		.buf = runtime_buf, .idx = 0, .size = sizeof(runtime_buf) \
+	}; \
+	int len = cbprintf_package(NULL, ALIGN_OFFSET, flags, fmt, __VA_ARGS__); \
+	int rc = cbprintf_package_desc(NULL, ALIGN_OFFSET, flags, arg_desc, \
+				       fmt, __VA_ARGS__); \
+	zassert_true(len > 0, "cbprintf_package() returned %d", len); \
+	zassert_equal(rc, len, "cbprintf_package_desc() returned %d", rc); \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) \
+		rt_package[len + ALIGN_OFFSET]; \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) \
+		desc_package[len + ALIGN_OFFSET]; \
+	memset(rt_package, 0, len + ALIGN_OFFSET); \
+	memset(desc_package, 0, len + ALIGN_OFFSET); \
+	rc = cbprintf_package(&rt_package[ALIGN_OFFSET], len, flags, fmt, __VA_ARGS__); \
+	zassert_equal(rc, len); \
+	rc = cbprintf_package_desc(&desc_package[ALIGN_OFFSET], len, flags, arg_desc, \
+				   fmt, __VA_ARGS__); \
+	zassert_equal(rc, len); \
+	dump("desc", &desc_package[ALIGN_OFFSET], len); \
+	zassert_equal(memcmp(rt_package, desc_package, len + ALIGN_OFFSET), 0, \
+		      "Packages differ"); \
+	unpack("desc", &desc_buf, &desc_package[ALIGN_OFFSET], len); \
+} while (0)
+
+enum test_enum {
+	TEST_ENUM_A = 5,
+};
+
+ZTEST(cbprintf_package, test_cbprintf_package_desc)
+{
+	volatile signed char sc = -11;
+	bool b = true;
+	enum test_enum e = TEST_ENUM_A;
+	short s = -300;
+	long li = -1111111111;
+	long long lli = 0x1122334455667788;
+	unsigned long long ull = 0xaabbaabbaabb;
+	void *vp = &s;
+	static const char *str = "test";
+	char rw_str[] = "rw";
+
+	TEST_PACKAGING_DESC(0, "test %d %hd %hhd %d %d", 100, s, sc, b, e);
+	TEST_PACKAGING_DESC(0, "test %lx %llx %x %llu", li, lli, 0xe4e3e2e1, ull);
+	TEST_PACKAGING_DESC(0, "test %p %c", vp, 'c');
+	TEST_PACKAGING_DESC(0, "test %s %d %s", str, 10, rw_str);
+	TEST_PACKAGING_DESC(CBPRINTF_PACKAGE_ADD_RW_STR_POS | CBPRINTF_PACKAGE_ADD_RO_STR_POS,
+			    "test %s %d %s", str, 10, rw_str);
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_FP_SUPPORT)) {
+		float f = -1.234f;
+		double d = 1.2333;
+
+		TEST_PACKAGING_DESC(0, "test %x %f %f %x", 0xb1b2b3b4, (double)f, d, 0xe4e3e2e1);
+	}
+
+#if Z_C_GENERIC && !defined(__cplusplus)
+	CBPRINTF_ARG_DESC_DEFINE(arg_desc, "%d %d %s %p %lld", b, e, str, vp, lli);
+
+	zassert_equal(ARRAY_SIZE(arg_desc), 6);
+	zassert_equal(arg_desc[0], CBPRINTF_PACKAGE_ARG_TYPE_INT);
+	zassert_equal(arg_desc[1], CBPRINTF_PACKAGE_ARG_TYPE_UNSIGNED_INT);
+	zassert_equal(arg_desc[2], CBPRINTF_PACKAGE_ARG_TYPE_PTR_CHAR);
+	zassert_equal(arg_desc[3], CBPRINTF_PACKAGE_ARG_TYPE_PTR_VOID);
+	zassert_equal(arg_desc[4], CBPRINTF_PACKAGE_ARG_TYPE_LONG_LONG);
+	zassert_equal(arg_desc[5], CBPRINTF_PACKAGE_ARG_TYPE_END);
+#endif
+}
+#endif /* CONFIG_CBPRINTF_PACKAGE_ARG_DESC */
+
 struct test_cbprintf_covert_ctx {
 	uint8_t buf[256];
 	size_t offset;
@@ -893,6 +893,55 @@ ZTEST(log_buffer, test_overwrite_while_claimed2)
 	overwrite_while_claimed2(false);
 }
 
+void free_out_of_order(bool pow2)
+{
+	struct test_data_var *p[3];
+	struct mpsc_pbuf_buffer buffer;
+	uint32_t size, now;
+
+	init(&buffer, 16 - !pow2, false);
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		p[i] = (struct test_data_var *)mpsc_pbuf_alloc(&buffer, 4, K_NO_WAIT);
+		zassert_true(p[i]);
+		p[i]->hdr.len = 4;
+		p[i]->hdr.data = i;
+		mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)p[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		zassert_equal_ptr(mpsc_pbuf_claim(&buffer), p[i]);
+	}
+
+	/* Space of a packet freed before an older one is not released. */
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[1]);
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(now, 12 * sizeof(int));
+	zassert_is_null(mpsc_pbuf_alloc(&buffer, 8, K_NO_WAIT));
+	zassert_equal(p[2]->hdr.data, 2);
+
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[0]);
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(now, 4 * sizeof(int));
+	zassert_equal(p[2]->hdr.data, 2);
+
+	mpsc_pbuf_free(&buffer, (union mpsc_pbuf_generic *)p[2]);
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(now, 0);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+}
+
+ZTEST(log_buffer, test_free_out_of_order)
+{
+	/* Only packets of a buffer without interrupt locking can be freed in
+	 * any order.
+	 */
+	Z_TEST_SKIP_IFNDEF(CONFIG_MPSC_PBUF_LOCKLESS);
+
+	free_out_of_order(true);
+	free_out_of_order(false);
+}
+
 static uintptr_t current_rd_idx;
 
 static void validate_packet(struct test_data_var *packet)
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/capture.h>
+
+#define UDP_PORT 4242
+#define PKT_LEN 100
+#define BURST 20
+#define FILTER_CAPLEN 48
+
+#define PCAPNG_SHB 0x0a0d0d0aU
+#define PCAPNG_IDB 0x00000001U
+#define PCAPNG_ISB 0x00000005U
+#define PCAPNG_EPB 0x00000006U
+
+static uint8_t stream[4096];
+static size_t stream_len;
+
+static struct net_if *test_iface;
+static uint8_t dummy_data;
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[6] = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+	test_iface = iface;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(capture_ring_test, "capture_ring_test", NULL, NULL, &dummy_data, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static int ram_write(const void *data, size_t len, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (stream_len + len > sizeof(stream)) {
+		return -ENOSPC;
+	}
+
+	memcpy(stream + stream_len, data, len);
+	stream_len += len;
+
+	return 0;
+}
+
+/* Build an IPv4 packet carrying a UDP datagram, or another protocol */
+static struct net_pkt *build(struct net_pkt *pkt, uint8_t proto, uint16_t port, size_t len)
+{
+	uint8_t data[PKT_LEN * 2] = {
+		0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x40, proto, 0x00, 0x00, 192, 0, 2, 2, 192, 0, 2, 1,
+	};
+
+	zassert_not_null(pkt, "Cannot allocate packet");
+	zassert_true(len <= sizeof(data));
+
+	sys_put_be16(len, &data[2]);
+	sys_put_be16(UDP_PORT + 1, &data[20]);
+	sys_put_be16(port, &data[22]);
+	sys_put_be16(len - 20, &data[24]);
+
+	zassert_ok(net_pkt_write(pkt, data, len));
+
+	return pkt;
+}
+
+static void inject(uint8_t proto, uint16_t port, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(test_iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_ok(net_recv_data(test_iface, build(pkt, proto, port, len)));
+}
+
+static void transmit(uint8_t proto, uint16_t port, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(test_iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_equal(net_if_send_data(test_iface, build(pkt, proto, port, len)), NET_OK);
+}
+
+struct stream_info {
+	uint32_t linktype;
+	uint32_t packets;
+	uint32_t caplen;
+	uint32_t orig_len;
+	uint32_t inbound;
+	uint32_t outbound;
+	uint64_t ifrecv;
+	uint64_t filteraccept;
+	uint64_t osdrop;
+	bool isb;
+};
+
+static uint64_t get_opt_u64(const uint8_t *opt)
+{
+	uint64_t value;
+
+	memcpy(&value, opt + 4, sizeof(value));
+
+	return value;
+}
+
+static void parse_stream(struct stream_info *info)
+{
+	size_t offset = 0;
+
+	memset(info, 0, sizeof(*info));
+
+	zassert_true(stream_len >= 28, "No section header");
+	zassert_equal(sys_get_le32(stream), PCAPNG_SHB);
+	zassert_equal(sys_get_le32(stream + 8), 0x1a2b3c4d);
+
+	while (offset < stream_len) {
+		uint32_t type = sys_get_le32(stream + offset);
+		uint32_t len = sys_get_le32(stream + offset + 4);
+		const uint8_t *body = stream + offset + 8;
+		size_t opt;
+
+		zassert_true(len >= 12 && len % 4 == 0 && offset + len <= stream_len,
+			     "Invalid block length %u at %zu", len, offset);
+		zassert_equal(sys_get_le32(stream + offset + len - 4), len,
+			      "Trailing length mismatch at %zu", offset);
+
+		switch (type) {
+		case PCAPNG_IDB:
+			info->linktype = sys_get_le16(body);
+			break;
+		case PCAPNG_EPB:
+			zassert_equal(sys_get_le32(body), 0, "Unexpected interface");
+			info->caplen = sys_get_le32(body + 12);
+			info->orig_len = sys_get_le32(body + 16);
+			info->packets++;
+
+			/* Options follow the padded packet data */
+			for (opt = 20 + ROUND_UP(info->caplen, 4); opt < len - 12;
+			     opt += 4 + ROUND_UP(sys_get_le16(body + opt + 2), 4)) {
+				if (sys_get_le16(body + opt) == 2) {
+					info->inbound += (sys_get_le32(body + opt + 4) & 3) == 1;
+					info->outbound += (sys_get_le32(body + opt + 4) & 3) == 2;
+				}
+			}
+			break;
+		case PCAPNG_ISB:
+			/* Options follow the interface id and the timestamp */
+			for (opt = 12; opt < len - 12; opt += 4 + sys_get_le16(body + opt + 2)) {
+				switch (sys_get_le16(body + opt)) {
+				case 4:
+					info->ifrecv = get_opt_u64(body + opt);
+					break;
+				case 6:
+					info->filteraccept = get_opt_u64(body + opt);
+					break;
+				case 7:
+					info->osdrop = get_opt_u64(body + opt);
+					break;
+				}
+			}
+
+			info->isb = true;
+			break;
+		}
+
+		offset += len;
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	stream_len = 0;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)net_capture_ring_stop();
+	zassert_ok(net_capture_ring_set_filter(NULL, 0));
+}
+
+ZTEST(net_capture_ring, test_filter_validation)
+{
+	const struct net_capture_filter_insn no_ret[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_LD | NET_CAPTURE_BPF_W | NET_CAPTURE_BPF_LEN,
+				     0),
+	};
+	const struct net_capture_filter_insn bad_jump[] = {
+		NET_CAPTURE_BPF_JUMP(NET_CAPTURE_BPF_JMP | NET_CAPTURE_BPF_JEQ | NET_CAPTURE_BPF_K,
+				     0, 0, 1),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, 0),
+	};
+	const struct net_capture_filter_insn bad_mem[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_ST, 16),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, 0),
+	};
+	const struct net_capture_filter_insn bad_offset[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_LD | NET_CAPTURE_BPF_W | NET_CAPTURE_BPF_ABS,
+				     UINT32_MAX - 1),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_A, 0),
+	};
+	const struct net_capture_filter_insn div_zero[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_ALU | NET_CAPTURE_BPF_DIV | NET_CAPTURE_BPF_K,
+				     0),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_A, 0),
+	};
+	const struct net_capture_filter_insn bad_code[] = {
+		NET_CAPTURE_BPF_STMT(0xf000, 0),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, 0),
+	};
+	const struct net_capture_filter_insn accept[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, UINT32_MAX),
+	};
+	struct net_capture_filter_insn too_long[CONFIG_NET_CAPTURE_RING_FILTER_LEN + 1];
+
+	for (int i = 0; i < ARRAY_SIZE(too_long); i++) {
+		too_long[i] = accept[0];
+	}
+
+	zassert_equal(net_capture_ring_set_filter(accept, 0), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(no_ret, ARRAY_SIZE(no_ret)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(bad_jump, ARRAY_SIZE(bad_jump)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(bad_mem, ARRAY_SIZE(bad_mem)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(bad_offset, ARRAY_SIZE(bad_offset)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(div_zero, ARRAY_SIZE(div_zero)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(bad_code, ARRAY_SIZE(bad_code)), -EINVAL);
+	zassert_equal(net_capture_ring_set_filter(too_long, ARRAY_SIZE(too_long)), -ENOMEM);
+	zassert_ok(net_capture_ring_set_filter(accept, ARRAY_SIZE(accept)));
+
+	zassert_ok(net_capture_ring_start(test_iface, 0, ram_write, NULL));
+	zassert_equal(net_capture_ring_start(test_iface, 0, ram_write, NULL), -EALREADY);
+	zassert_equal(net_capture_ring_set_filter(NULL, 0), -EBUSY);
+	zassert_ok(net_capture_ring_stop());
+	zassert_equal(net_capture_ring_stop(), -EALREADY);
+}
+
+ZTEST(net_capture_ring, test_udp_filter)
+{
+	/* Store the first bytes of the UDP datagrams sent to UDP_PORT */
+	const struct net_capture_filter_insn udp_port[] = {
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_LD | NET_CAPTURE_BPF_B | NET_CAPTURE_BPF_ABS,
+				     9),
+		NET_CAPTURE_BPF_JUMP(NET_CAPTURE_BPF_JMP | NET_CAPTURE_BPF_JEQ | NET_CAPTURE_BPF_K,
+				     IPPROTO_UDP, 0, 3),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_LDX | NET_CAPTURE_BPF_B | NET_CAPTURE_BPF_MSH,
+				     0),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_LD | NET_CAPTURE_BPF_H | NET_CAPTURE_BPF_IND,
+				     2),
+		NET_CAPTURE_BPF_JUMP(NET_CAPTURE_BPF_JMP | NET_CAPTURE_BPF_JEQ | NET_CAPTURE_BPF_K,
+				     UDP_PORT, 1, 0),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, 0),
+		NET_CAPTURE_BPF_STMT(NET_CAPTURE_BPF_RET | NET_CAPTURE_BPF_K, FILTER_CAPLEN),
+	};
+	struct net_capture_ring_stats stats;
+	struct stream_info info;
+
+	zassert_ok(net_capture_ring_set_filter(udp_port, ARRAY_SIZE(udp_port)));
+	zassert_ok(net_capture_ring_start(test_iface, 64, ram_write, NULL));
+
+	inject(IPPROTO_UDP, UDP_PORT, PKT_LEN * 2);
+	inject(IPPROTO_UDP, UDP_PORT + 1, PKT_LEN);
+	inject(IPPROTO_ICMP, UDP_PORT, PKT_LEN);
+
+	/* Let the RX thread see the packets */
+	k_msleep(100);
+
+	zassert_ok(net_capture_ring_stop());
+
+	net_capture_ring_get_stats(&stats);
+	zassert_equal(stats.received, 3);
+	zassert_equal(stats.filtered, 2);
+	zassert_equal(stats.captured, 1);
+	zassert_equal(stats.truncated, 1);
+	zassert_equal(stats.written, 1);
+	zassert_equal(stats.write_errors, 0);
+
+	parse_stream(&info);
+	zassert_equal(info.linktype, 101, "Unexpected link type");
+	zassert_equal(info.packets, 1);
+	zassert_equal(info.caplen, FILTER_CAPLEN);
+	zassert_equal(info.orig_len, PKT_LEN * 2);
+	zassert_equal(info.inbound, 1);
+	zassert_true(info.isb, "No statistics");
+	zassert_equal(info.ifrecv, 3);
+	zassert_equal(info.filteraccept, 1);
+	zassert_equal(info.osdrop, 0);
+}
+
+ZTEST(net_capture_ring, test_drops)
+{
+	struct net_capture_ring_stats stats;
+	struct stream_info info;
+
+	zassert_ok(net_capture_ring_start(test_iface, 0, ram_write, NULL));
+
+	/* The ring is not drained before the capture is stopped */
+	for (int i = 0; i < BURST; i++) {
+		inject(IPPROTO_UDP, UDP_PORT, PKT_LEN);
+		k_msleep(5);
+	}
+
+	zassert_ok(net_capture_ring_stop());
+
+	net_capture_ring_get_stats(&stats);
+	zassert_equal(stats.received, BURST);
+	zassert_true(stats.dropped > 0, "The ring did not overflow");
+	zassert_equal(stats.captured + stats.dropped, BURST);
+	zassert_equal(stats.written, stats.captured);
+	zassert_equal(stats.truncated, 0);
+
+	parse_stream(&info);
+	zassert_equal(info.packets, stats.captured);
+	zassert_equal(info.caplen, PKT_LEN);
+	zassert_equal(info.ifrecv, BURST);
+	zassert_equal(info.filteraccept, BURST);
+	zassert_equal(info.osdrop, stats.dropped);
+}
+
+ZTEST(net_capture_ring, test_direction)
+{
+	struct net_capture_ring_stats stats;
+	struct stream_info info;
+
+	zassert_ok(net_capture_ring_start(test_iface, 0, ram_write, NULL));
+
+	inject(IPPROTO_UDP, UDP_PORT, PKT_LEN);
+	transmit(IPPROTO_UDP, UDP_PORT, PKT_LEN);
+	transmit(IPPROTO_UDP, UDP_PORT, PKT_LEN);
+
+	/* Let the RX and TX threads see the packets */
+	k_msleep(100);
+
+	zassert_ok(net_capture_ring_stop());
+
+	net_capture_ring_get_stats(&stats);
+	zassert_equal(stats.captured, 3);
+
+	parse_stream(&info);
+	zassert_equal(info.packets, 3);
+	zassert_equal(info.inbound, 1);
+	zassert_equal(info.outbound, 2);
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, NULL, before, after, NULL);
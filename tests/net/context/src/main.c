@@ -63,6 +63,7 @@ static bool recv_cb_called;
 static bool recv_cb_reconfig_called;
 static bool recv_cb_timeout_called;
 static bool test_sending;
+static struct net_pkt *last_sent_pkt;
 
 static struct k_sem wait_data;
 
@@ -962,6 +963,89 @@ ZTEST(net_context, test_net_ctx_recv_v4_timeout_forever)
 	net_ctx_put();
 }
 
+ZTEST(net_context, test_net_ctx_pkt_cache)
+{
+#if defined(CONFIG_NET_CONTEXT_PKT_CACHE)
+	static const uint8_t large_data[3 * CONFIG_NET_BUF_DATA_SIZE];
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PEER_PORT),
+		.sin_addr = { { { 192, 0, 2, 2 } } },
+	};
+	struct sockaddr_in bind_addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(MY_PORT + 10),
+		.sin_addr = { { { 192, 0, 2, 1 } } },
+	};
+	struct k_mem_slab *rx, *tx;
+	struct net_buf_pool *rx_data, *tx_data;
+	struct net_context *ctx;
+	struct net_pkt *first;
+	uint32_t free_pkts;
+	int ret, i;
+
+	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
+	free_pkts = k_mem_slab_num_free_get(tx);
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_val_t free_bufs = atomic_get(&tx_data->avail_count);
+#endif
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &ctx);
+	zassert_equal(ret, 0, "Context get failed");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&bind_addr,
+			       sizeof(bind_addr));
+	zassert_equal(ret, 0, "Context bind failed");
+
+	test_sending = false;
+
+	ret = net_context_sendto(ctx, test_data, strlen(test_data),
+				 (struct sockaddr *)&addr, sizeof(addr),
+				 NULL, K_NO_WAIT, NULL);
+	zassert_true(ret > 0, "Send failed (%d)", ret);
+	k_sleep(K_MSEC(10));
+
+	first = last_sent_pkt;
+
+	/* The sent packet and its buffer are kept by the context */
+	zassert_equal(k_mem_slab_num_free_get(tx), free_pkts - 1,
+		      "Sent packet not cached");
+
+	for (i = 0; i < 8; i++) {
+		ret = net_context_sendto(ctx, test_data, strlen(test_data),
+					 (struct sockaddr *)&addr, sizeof(addr),
+					 NULL, K_NO_WAIT, NULL);
+		zassert_true(ret > 0, "Send failed (%d)", ret);
+		k_sleep(K_MSEC(10));
+
+		zassert_equal_ptr(last_sent_pkt, first, "Cached packet not used");
+		zassert_equal(k_mem_slab_num_free_get(tx), free_pkts - 1,
+			      "Packet slab used");
+	}
+
+	/* A larger packet keeps the cached buffers and adds the missing ones */
+	ret = net_context_sendto(ctx, large_data, sizeof(large_data),
+				 (struct sockaddr *)&addr, sizeof(addr),
+				 NULL, K_NO_WAIT, NULL);
+	zassert_true(ret > 0, "Send failed (%d)", ret);
+	k_sleep(K_MSEC(10));
+
+	zassert_equal_ptr(last_sent_pkt, first, "Cached packet not used");
+
+	ret = net_context_put(ctx);
+	zassert_equal(ret, 0, "Context put failed");
+
+	zassert_equal(k_mem_slab_num_free_get(tx), free_pkts,
+		      "Cached packet not freed");
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	zassert_equal(atomic_get(&tx_data->avail_count), free_bufs,
+		      "Cached buffer not freed");
+#endif
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_CONTEXT_PKT_CACHE */
+}
+
 struct net_context_test {
 	uint8_t mac_addr[sizeof(struct net_eth_addr)];
 	struct net_linkaddr ll_addr;
@@ -1006,6 +1090,8 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		return -ENODATA;
 	}
 
+	last_sent_pkt = pkt;
+
 	if (test_sending) {
 		/* We are now about to send data to outside but in this
 		 * test we just check what would be sent. In real life
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "ipv4.h"
+#include "connection.h"
+#include "net_private.h"
+
+#define SEG_LEN 100
+#define SEQ 1000
+#define LOCAL_PORT 4243
+#define REMOTE_PORT 4242
+
+/* Same values as the TCP flags in tcp_private.h */
+#define TCP_PSH BIT(3)
+#define TCP_ACK BIT(4)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handle;
+
+static int recv_cnt;
+static size_t recv_len[4];
+static uint32_t recv_seq[4];
+
+static uint8_t test_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void test_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, test_mac, sizeof(test_mac), NET_LINK_ETHERNET);
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT(net_gro_test, "net_gro_test", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static enum net_verdict tcp_received(struct net_conn *conn, struct net_pkt *pkt,
+				     union net_ip_header *ip_hdr,
+				     union net_proto_header *proto_hdr,
+				     void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(user_data);
+
+	if (recv_cnt < ARRAY_SIZE(recv_len)) {
+		recv_len[recv_cnt] = net_pkt_get_len(pkt) - NET_IPV4H_LEN - NET_TCPH_LEN;
+		recv_seq[recv_cnt] = sys_get_be32(proto_hdr->tcp->seq);
+	}
+
+	recv_cnt++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+/* Build a received TCP data segment with a valid checksum, or a corrupted
+ * payload if @p corrupt is set. The checksum is computed when the packet
+ * is finalized, which marks it as checksum done like a sent packet.
+ */
+static struct net_pkt *segment(uint32_t seq, bool corrupt)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	uint8_t data[SEG_LEN];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_TCPH_LEN + SEG_LEN, AF_INET,
+					   IPPROTO_TCP, K_SECONDS(1));
+	zassert_not_null(pkt, "Out of packets");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr));
+
+	tcp_hdr.src_port = htons(REMOTE_PORT);
+	tcp_hdr.dst_port = htons(LOCAL_PORT);
+	sys_put_be32(seq, tcp_hdr.seq);
+	sys_put_be32(1, tcp_hdr.ack);
+	tcp_hdr.offset = (NET_TCPH_LEN / 4U) << 4;
+	tcp_hdr.flags = TCP_ACK | TCP_PSH;
+	sys_put_be16(8192, tcp_hdr.wnd);
+	zassert_ok(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)));
+
+	memset(data, seq & 0xff, sizeof(data));
+	zassert_ok(net_pkt_write(pkt, data, sizeof(data)));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_TCP));
+	zassert_true(net_pkt_is_chksum_done(pkt));
+
+	if (corrupt) {
+		/* Last payload byte */
+		uint8_t *last = net_buf_frag_last(pkt->buffer)->data +
+				net_buf_frag_last(pkt->buffer)->len - 1;
+
+		*last ^= 0xff;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Queue the segments and process them as one RX burst. */
+static void rx_burst(struct net_pkt **pkts, int cnt)
+{
+	struct k_fifo fifo;
+
+	k_fifo_init(&fifo);
+
+	for (int i = 1; i < cnt; i++) {
+		k_fifo_put(&fifo, pkts[i]);
+	}
+
+	net_process_rx_burst(&fifo, pkts[0]);
+
+	zassert_true(k_fifo_is_empty(&fifo));
+}
+
+ZTEST(net_gro, test_coalesce)
+{
+	struct net_pkt *pkts[3];
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = segment(SEQ + i * SEG_LEN, false);
+	}
+
+	rx_burst(pkts, ARRAY_SIZE(pkts));
+
+	zassert_equal(recv_cnt, 1, "Segments not coalesced (%d packets)", recv_cnt);
+	zassert_equal(recv_len[0], 3 * SEG_LEN);
+	zassert_equal(recv_seq[0], SEQ);
+}
+
+ZTEST(net_gro, test_out_of_order)
+{
+	struct net_pkt *pkts[3];
+
+	pkts[0] = segment(SEQ, false);
+	pkts[1] = segment(SEQ + 2 * SEG_LEN, false);
+	pkts[2] = segment(SEQ + 3 * SEG_LEN, false);
+
+	rx_burst(pkts, ARRAY_SIZE(pkts));
+
+	zassert_equal(recv_cnt, 2);
+	zassert_equal(recv_len[0], SEG_LEN);
+	zassert_equal(recv_seq[1], SEQ + 2 * SEG_LEN);
+	zassert_equal(recv_len[1], 2 * SEG_LEN);
+}
+
+/* A segment with a bad checksum must be dropped even though the packet is
+ * marked as checksum done, as a looped back or cloned packet would be.
+ */
+ZTEST(net_gro, test_bad_checksum)
+{
+	struct net_pkt *pkts[3];
+
+	pkts[0] = segment(SEQ, false);
+	pkts[1] = segment(SEQ + SEG_LEN, true);
+	pkts[2] = segment(SEQ + 2 * SEG_LEN, false);
+
+	rx_burst(pkts, ARRAY_SIZE(pkts));
+
+	zassert_equal(recv_cnt, 2, "Got %d packets", recv_cnt);
+	zassert_equal(recv_seq[0], SEQ);
+	zassert_equal(recv_len[0], SEG_LEN);
+	zassert_equal(recv_seq[1], SEQ + 2 * SEG_LEN);
+	zassert_equal(recv_len[1], SEG_LEN);
+
+	/* Single segment outside of a burst */
+	recv_cnt = 0;
+	net_process_rx_packet(segment(SEQ, true));
+	zassert_equal(recv_cnt, 0, "Corrupted segment was accepted");
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+		.sin_port = htons(LOCAL_PORT),
+	};
+	int ret;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_gro_test));
+	zassert_not_null(iface);
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0));
+
+	ret = net_conn_register(IPPROTO_TCP, AF_INET, NULL, (struct sockaddr *)&local,
+				REMOTE_PORT, LOCAL_PORT, NULL, tcp_received, NULL, &handle);
+	zassert_ok(ret, "Cannot register connection (%d)", ret);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	recv_cnt = 0;
+	memset(recv_len, 0, sizeof(recv_len));
+	memset(recv_seq, 0, sizeof(recv_seq));
+}
+
+ZTEST_SUITE(net_gro, NULL, setup, before, NULL, NULL);
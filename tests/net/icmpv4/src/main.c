@@ -220,6 +220,11 @@ static int verify_echo_reply(struct net_pkt *pkt)
 		zassert_true(false, "echo_reply invalid opts len");
 	}
 
+	/* The checksum is updated from the request, it must be valid */
+	if (net_calc_chksum_icmpv4(pkt) != 0U) {
+		zassert_true(false, "echo_reply invalid checksum");
+	}
+
 	return 0;
 }
 
@@ -873,6 +873,117 @@ ZTEST(net_ipv4_fragment, test_do_not_fragment)
 	zassert_equal(pkt_recv_size, pkt_recv_expected_size, "Packet size mismatch");
 }
 
+/* UDP datagram without checksum, reassembled from fragments built by recv_fragment() */
+#define REASS_SRC_PORT 4243
+#define REASS_DST_PORT 4244
+#define REASS_DATAGRAM_LEN 88
+
+static uint8_t reass_datagram[REASS_DATAGRAM_LEN];
+static struct k_sem wait_reassembled;
+
+static enum net_verdict reassembled_received(struct net_conn *conn, struct net_pkt *pkt,
+					     union net_ip_header *ip_hdr,
+					     union net_proto_header *proto_hdr, void *user_data)
+{
+	uint8_t verify_buf[REASS_DATAGRAM_LEN];
+
+	zassert_equal(net_pkt_get_len(pkt), NET_IPV4H_LEN + sizeof(reass_datagram),
+		      "Reassembled packet length mismatch");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_skip(pkt, NET_IPV4H_LEN);
+	zassert_ok(net_pkt_read(pkt, verify_buf, sizeof(verify_buf)));
+	zassert_mem_equal(verify_buf, reass_datagram, sizeof(reass_datagram),
+			  "Reassembled data mismatch");
+
+	net_pkt_unref(pkt);
+
+	k_sem_give(&wait_reassembled);
+
+	return NET_OK;
+}
+
+static void recv_fragment(uint16_t id, uint16_t offset, uint16_t len, bool more)
+{
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, NET_IPV4H_LEN + len, AF_INET, IPPROTO_UDP,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Packet creation failure");
+
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	zassert_ok(net_pkt_write(pkt, ipv4_udp_frag, NET_IPV4H_LEN));
+	zassert_ok(net_pkt_write(pkt, reass_datagram + offset, len));
+
+	hdr = NET_IPV4_HDR(pkt);
+	hdr->len = htons(NET_IPV4H_LEN + len);
+	sys_put_be16(id, hdr->id);
+	sys_put_be16(offset / 8 | (more ? NET_IPV4_MORE_FRAG_MASK : 0), hdr->offset);
+	hdr->chksum = 0;
+	hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_iface(pkt, iface1);
+	zassert_ok(net_recv_data(iface1, pkt), "Cannot receive data");
+
+	k_sleep(K_MSEC(10));
+}
+
+static uint8_t pending_reassemblies(void)
+{
+	uint8_t packets = 0;
+
+	net_ipv4_frag_foreach(reassembly_foreach_cb, &packets);
+
+	return packets;
+}
+
+/* Test reassembling interleaved packets whose fragments arrive out of order */
+ZTEST(net_ipv4_fragment, test_reassembly_out_of_order)
+{
+	struct net_conn_handle *handle;
+
+	k_sem_init(&wait_reassembled, 0, UINT_MAX);
+
+	sys_put_be16(REASS_SRC_PORT, &reass_datagram[0]);
+	sys_put_be16(REASS_DST_PORT, &reass_datagram[2]);
+	sys_put_be16(REASS_DATAGRAM_LEN, &reass_datagram[4]);
+	generate_dummy_data(reass_datagram + NET_UDPH_LEN, REASS_DATAGRAM_LEN - NET_UDPH_LEN);
+
+	zassert_ok(net_udp_register(AF_INET, NULL, NULL, 0, REASS_DST_PORT, NULL,
+				    reassembled_received, NULL, &handle));
+
+	recv_fragment(0x100, 64, 24, false);
+	recv_fragment(0x101, 32, 32, true);
+	recv_fragment(0x100, 32, 32, true);
+	zassert_equal(pending_reassemblies(), 2, "Expected two pending packets");
+
+	recv_fragment(0x101, 0, 32, true);
+	recv_fragment(0x100, 0, 32, true);
+	zassert_equal(pending_reassemblies(), 1, "Expected one pending packet");
+	zassert_ok(k_sem_take(&wait_reassembled, WAIT_TIME), "First packet not reassembled");
+
+	recv_fragment(0x101, 64, 24, false);
+	zassert_equal(pending_reassemblies(), 0, "Expected no pending packet");
+	zassert_ok(k_sem_take(&wait_reassembled, WAIT_TIME), "Second packet not reassembled");
+
+	/* An overlapping fragment drops the whole packet */
+	recv_fragment(0x102, 0, 32, true);
+	recv_fragment(0x102, 24, 32, true);
+	zassert_equal(pending_reassemblies(), 0, "Expected overlapping packet to be dropped");
+
+	/* So does a duplicated last fragment */
+	recv_fragment(0x103, 64, 24, false);
+	recv_fragment(0x103, 64, 24, false);
+	zassert_equal(pending_reassemblies(), 0, "Expected duplicated packet to be dropped");
+
+	zassert_equal(k_sem_count_get(&wait_reassembled), 0, "Unexpected packet");
+
+	zassert_ok(net_udp_unregister(handle));
+}
+
 static void test_pre(void *ptr)
 {
 	k_sem_reset(&wait_data);
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVER_ADDR "127.0.0.1"
+#define SERVER_PORT 5683
+#define RECV_TIMEOUT_MS 1000
+#define OBSERVERS 3
+#define MAX_OPTIONS 8
+
+static const uint16_t core_service_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(core_service, SERVER_ADDR, &core_service_port, 0);
+
+/* Reply with the response code stored as user data */
+static int code_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	return POINTER_TO_INT(resource->user_data);
+}
+
+static int observe_get(struct coap_resource *resource, struct coap_packet *request,
+		       struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(addr_len);
+
+	if (coap_resource_parse_observe(resource, request, addr) != 0) {
+		return COAP_RESPONSE_CODE_BAD_REQUEST;
+	}
+
+	return COAP_RESPONSE_CODE_CONTENT;
+}
+
+/* Resources are matched in section order, i.e. sorted by name */
+static const char * const temp_path[] = { "sensors", "temp", NULL };
+COAP_RESOURCE_DEFINE(resource_0_temp, core_service, {
+	.path = temp_path,
+	.get = code_get,
+	.user_data = INT_TO_POINTER(COAP_RESPONSE_CODE_CONTENT),
+});
+
+static const char * const any_sensor_path[] = { "sensors", "+", NULL };
+COAP_RESOURCE_DEFINE(resource_1_any_sensor, core_service, {
+	.path = any_sensor_path,
+	.get = code_get,
+	.user_data = INT_TO_POINTER(COAP_RESPONSE_CODE_VALID),
+});
+
+/* Shadowed by the resource defined first with the same path */
+COAP_RESOURCE_DEFINE(resource_2_shadowed, core_service, {
+	.path = temp_path,
+	.get = code_get,
+	.user_data = INT_TO_POINTER(COAP_RESPONSE_CODE_CREATED),
+});
+
+static const char * const config_path[] = { "config", "#", NULL };
+COAP_RESOURCE_DEFINE(resource_3_config, core_service, {
+	.path = config_path,
+	.get = code_get,
+	.user_data = INT_TO_POINTER(COAP_RESPONSE_CODE_CHANGED),
+});
+
+static const char * const sensors_path[] = { "sensors", NULL };
+COAP_RESOURCE_DEFINE(resource_4_sensors, core_service, {
+	.path = sensors_path,
+	.get = code_get,
+	.user_data = INT_TO_POINTER(COAP_RESPONSE_CODE_DELETED),
+});
+
+static const char * const observe_path[] = { "observe", NULL };
+COAP_RESOURCE_DEFINE(resource_5_observe, core_service, {
+	.path = observe_path,
+	.get = observe_get,
+});
+
+static int client_socket(void)
+{
+	struct timeval timeo = {
+		.tv_usec = RECV_TIMEOUT_MS * USEC_PER_MSEC,
+	};
+	int sock;
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+				    sizeof(timeo)));
+
+	return sock;
+}
+
+static void client_send(int sock, struct coap_packet *cpkt)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr), 1);
+	zassert_equal(zsock_sendto(sock, cpkt->data, cpkt->offset, 0,
+				   (struct sockaddr *)&addr, sizeof(addr)),
+		      cpkt->offset, "Cannot send (%d)", errno);
+}
+
+static void client_recv(int sock, struct coap_packet *cpkt, uint8_t *buf, size_t len)
+{
+	static struct coap_option options[MAX_OPTIONS];
+	ssize_t ret;
+
+	ret = zsock_recv(sock, buf, len, 0);
+	zassert_true(ret > 0, "No message received (%d)", errno);
+
+	zassert_ok(coap_packet_parse(cpkt, buf, ret, options, ARRAY_SIZE(options)));
+}
+
+static uint8_t request_code(int sock, uint8_t method, const char *path)
+{
+	uint8_t buf[64];
+	struct coap_packet cpkt;
+	uint16_t id = coap_next_id();
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, COAP_TYPE_CON,
+				    0, NULL, method, id));
+	if (path != NULL) {
+		zassert_ok(coap_packet_set_path(&cpkt, path));
+	}
+
+	client_send(sock, &cpkt);
+	client_recv(sock, &cpkt, buf, sizeof(buf));
+
+	zassert_equal(coap_header_get_type(&cpkt), COAP_TYPE_ACK);
+	zassert_equal(coap_header_get_id(&cpkt), id);
+
+	return coap_header_get_code(&cpkt);
+}
+
+static void *coap_server_setup(void)
+{
+	zassert_ok(coap_service_start(&core_service), "Cannot start service");
+
+	return NULL;
+}
+
+static void coap_server_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(coap_service_stop(&core_service));
+}
+
+ZTEST(coap_server_core, test_dispatch)
+{
+	int sock = client_socket();
+
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "sensors/temp"),
+		      COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "sensors/humidity"),
+		      COAP_RESPONSE_CODE_VALID);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "sensors"),
+		      COAP_RESPONSE_CODE_DELETED);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "config/a/b"),
+		      COAP_RESPONSE_CODE_CHANGED);
+
+	/* A multi-level wildcard matches one segment at least */
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "config"),
+		      COAP_RESPONSE_CODE_NOT_FOUND);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "sensors/temp/raw"),
+		      COAP_RESPONSE_CODE_NOT_FOUND);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, "unknown"),
+		      COAP_RESPONSE_CODE_NOT_FOUND);
+	zassert_equal(request_code(sock, COAP_METHOD_GET, NULL),
+		      COAP_RESPONSE_CODE_NOT_FOUND);
+
+	zassert_equal(request_code(sock, COAP_METHOD_PUT, "sensors/temp"),
+		      COAP_RESPONSE_CODE_NOT_ALLOWED);
+
+	zsock_close(sock);
+}
+
+static void expect_notification(int sock, const uint8_t *token, uint8_t tkl, uint8_t type,
+				uint16_t *id)
+{
+	uint8_t buf[64];
+	uint8_t recv_token[COAP_TOKEN_MAX_LEN];
+	struct coap_packet cpkt;
+	const uint8_t *payload;
+	uint16_t payload_len;
+
+	client_recv(sock, &cpkt, buf, sizeof(buf));
+
+	zassert_equal(coap_header_get_type(&cpkt), type);
+	zassert_equal(coap_header_get_code(&cpkt), COAP_RESPONSE_CODE_CONTENT);
+	zassert_equal(coap_header_get_token(&cpkt, recv_token), tkl);
+	zassert_mem_equal(recv_token, token, tkl);
+	zassert_equal(coap_get_option_int(&cpkt, COAP_OPTION_OBSERVE), 5);
+
+	payload = coap_packet_get_payload(&cpkt, &payload_len);
+	zassert_equal(payload_len, 4);
+	zassert_mem_equal(payload, "23.5", 4);
+
+	*id = coap_header_get_id(&cpkt);
+}
+
+static int send_notification(uint8_t type)
+{
+	static const uint8_t ignored_token[] = { 0xde, 0xad };
+	uint8_t buf[64];
+	struct coap_packet cpkt;
+
+	zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1, type,
+				    sizeof(ignored_token), ignored_token,
+				    COAP_RESPONSE_CODE_CONTENT, 0));
+	zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, 5));
+	zassert_ok(coap_packet_append_payload_marker(&cpkt));
+	zassert_ok(coap_packet_append_payload(&cpkt, "23.5", 4));
+
+	return coap_resource_send_notification(&resource_5_observe, &cpkt, NULL);
+}
+
+ZTEST(coap_server_core, test_notification)
+{
+	static const uint8_t tokens[OBSERVERS][COAP_TOKEN_MAX_LEN] = {
+		{ 0x01 },
+		{ 0x02, 0x03, 0x04, 0x05 },
+		{ 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d },
+	};
+	static const uint8_t tkls[OBSERVERS] = { 1, 4, 8 };
+	uint16_t ids[OBSERVERS];
+	int socks[OBSERVERS];
+	struct coap_packet cpkt;
+	uint8_t buf[64];
+	char c;
+	int i;
+
+	zassert_equal(send_notification(COAP_TYPE_NON_CON), 0, "Unexpected observer");
+
+	for (i = 0; i < OBSERVERS; i++) {
+		socks[i] = client_socket();
+
+		zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1,
+					    COAP_TYPE_CON, tkls[i], tokens[i], COAP_METHOD_GET,
+					    coap_next_id()));
+		zassert_ok(coap_append_option_int(&cpkt, COAP_OPTION_OBSERVE, 0));
+		zassert_ok(coap_packet_set_path(&cpkt, "observe"));
+
+		client_send(socks[i], &cpkt);
+		client_recv(socks[i], &cpkt, buf, sizeof(buf));
+		zassert_equal(coap_header_get_code(&cpkt), COAP_RESPONSE_CODE_CONTENT);
+	}
+
+	zassert_equal(send_notification(COAP_TYPE_NON_CON), OBSERVERS);
+
+	for (i = 0; i < OBSERVERS; i++) {
+		expect_notification(socks[i], tokens[i], tkls[i], COAP_TYPE_NON_CON, &ids[i]);
+	}
+
+	zassert_not_equal(ids[0], ids[1]);
+	zassert_not_equal(ids[1], ids[2]);
+
+	/* Confirmable notifications are pending until acknowledged or reset */
+	zassert_equal(send_notification(COAP_TYPE_CON), OBSERVERS);
+
+	for (i = 0; i < OBSERVERS; i++) {
+		expect_notification(socks[i], tokens[i], tkls[i], COAP_TYPE_CON, &ids[i]);
+
+		zassert_ok(coap_packet_init(&cpkt, buf, sizeof(buf), COAP_VERSION_1,
+					    i == 0 ? COAP_TYPE_RESET : COAP_TYPE_ACK, 0, NULL,
+					    COAP_CODE_EMPTY, ids[i]));
+		client_send(socks[i], &cpkt);
+	}
+
+	/* Let the server process the replies, the reset removes the observer */
+	k_msleep(100);
+
+	zassert_equal(send_notification(COAP_TYPE_NON_CON), OBSERVERS - 1);
+
+	for (i = 1; i < OBSERVERS; i++) {
+		expect_notification(socks[i], tokens[i], tkls[i], COAP_TYPE_NON_CON, &ids[i]);
+	}
+
+	zassert_equal(zsock_recv(socks[0], &c, 1, ZSOCK_MSG_DONTWAIT), -1);
+	zassert_equal(errno, EAGAIN);
+
+	/* Without a pending message left, the notification is non-confirmable */
+	zassert_equal(send_notification(COAP_TYPE_CON), OBSERVERS - 1);
+	zassert_equal(send_notification(COAP_TYPE_CON), OBSERVERS - 1);
+
+	for (i = 1; i < OBSERVERS; i++) {
+		expect_notification(socks[i], tokens[i], tkls[i], COAP_TYPE_CON, &ids[i]);
+	}
+
+	expect_notification(socks[1], tokens[1], tkls[1], COAP_TYPE_CON, &ids[1]);
+	expect_notification(socks[2], tokens[2], tkls[2], COAP_TYPE_NON_CON, &ids[2]);
+
+	for (i = 0; i < OBSERVERS; i++) {
+		zsock_close(socks[i]);
+	}
+}
+
+ZTEST_SUITE(coap_server_core, NULL, coap_server_setup, NULL, NULL, coap_server_teardown);
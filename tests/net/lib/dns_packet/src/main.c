@@ -1242,6 +1242,124 @@ ZTEST(dns_packet, test_dns_flags_len)
 		      "DNS message length check failed (%d)", ret);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static uint8_t resp_nodata_ipv4[] = {
+	/* DNS msg header (12 bytes), NOERROR without answers */
+	0xb0, 0x42, 0x81, 0x80, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+};
+
+static int cache_cb_addresses;
+static int cache_cb_status;
+
+static void cache_resolve_cb(enum dns_resolve_status status,
+			     struct dns_addrinfo *info,
+			     void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == DNS_EAI_INPROGRESS) {
+		zassert_not_null(info, "No address info");
+		zassert_equal(info->ai_family, AF_INET, "Invalid family");
+		zassert_equal(net_sin(&info->ai_addr)->sin_addr.s_addr,
+			      htonl(0x8cd3a908), "Invalid address");
+		cache_cb_addresses++;
+		return;
+	}
+
+	cache_cb_status = status;
+}
+
+static int validate_for_cache(uint8_t *buf, size_t len)
+{
+	static const uint8_t query[] = {
+		/* Labels */
+		0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+		0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+		0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+		/* Query type */
+		0x00, 0x01
+	};
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id;
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+
+	dns_msg.msg = buf;
+	dns_msg.msg_size = len;
+
+	dns_id = dns_unpack_header_id(dns_msg.msg);
+
+	setup_dns_context(&dns_ctx, 0, dns_id, query, sizeof(query),
+			  DNS_QUERY_TYPE_A);
+
+	/* The hash is calculated from the labels, the cache uses the name */
+	dns_ctx.queries[0].query = DNAME1;
+
+	return dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+				NULL, &query_hash);
+}
+
+ZTEST(dns_packet, test_dns_cache)
+{
+	struct dns_resolve_cache_stats stats;
+	uint16_t dns_id = 1;
+	int ret;
+
+	dns_resolve_cache_flush();
+
+	ret = validate_for_cache(resp_valid_response_ipv4_6,
+				 sizeof(resp_valid_response_ipv4_6));
+	zassert_equal(ret, DNS_EAI_ALLDONE, "DNS message failed (%d)", ret);
+
+	zassert_ok(dns_resolve_cache_stats_get(&stats), "");
+	zassert_equal(stats.entries, 1, "Answer not cached");
+
+	/* Names are case insensitive */
+	ret = dns_resolve_name(&dns_ctx, "WWW.ZephyrProject.org",
+			       DNS_QUERY_TYPE_A, &dns_id, cache_resolve_cb,
+			       NULL, 1000);
+	zassert_ok(ret, "Cannot resolve from cache (%d)", ret);
+	zassert_equal(dns_id, 0, "Query was sent");
+	zassert_equal(cache_cb_addresses, 1, "No cached address");
+	zassert_equal(cache_cb_status, DNS_EAI_ALLDONE, "Invalid status");
+
+	zassert_ok(dns_resolve_cache_stats_get(&stats), "");
+	zassert_equal(stats.hits, 1, "No cache hit");
+
+	/* A NOERROR answer without addresses is cached as negative */
+	ret = validate_for_cache(resp_nodata_ipv4, sizeof(resp_nodata_ipv4));
+	zassert_equal(ret, DNS_EAI_NODATA, "Invalid status (%d)", ret);
+
+	cache_cb_addresses = 0;
+
+	ret = dns_resolve_name(&dns_ctx, DNAME1, DNS_QUERY_TYPE_A, &dns_id,
+			       cache_resolve_cb, NULL, 1000);
+	zassert_ok(ret, "Cannot resolve from cache (%d)", ret);
+	zassert_equal(cache_cb_addresses, 0, "Unexpected address");
+	zassert_equal(cache_cb_status, DNS_EAI_NODATA, "Invalid status");
+
+	zassert_ok(dns_resolve_cache_stats_get(&stats), "");
+	zassert_equal(stats.negative_hits, 1, "No negative cache hit");
+
+	dns_resolve_cache_flush();
+
+	zassert_ok(dns_resolve_cache_stats_get(&stats), "");
+	zassert_equal(stats.entries, 0, "Cache not flushed");
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 ZTEST_SUITE(dns_packet, NULL, NULL, NULL, NULL, NULL);
 /* TODO:
  *	1) add malformed DNS data (mostly done)
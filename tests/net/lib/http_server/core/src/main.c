@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+
+#define SERVER_ADDR "127.0.0.1"
+#define RECV_TIMEOUT_MS 2000
+
+static uint16_t test_http_service_port;
+HTTP_SERVICE_DEFINE(test_http_service, SERVER_ADDR, &test_http_service_port,
+		    2, 2, NULL);
+
+static const char index_html[] = "<html><body>Hello</body></html>";
+
+static struct http_resource_detail_static index_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.content_type = "text/html",
+	},
+	.static_data = index_html,
+	.static_data_len = sizeof(index_html) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(index_resource, test_http_service, "/index.html",
+		     &index_detail);
+
+/* Larger than what the TCP connection buffers */
+#define LARGE_LEN 6000
+static uint8_t large_data[LARGE_LEN];
+
+static struct http_resource_detail_static large_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.type = HTTP_RESOURCE_TYPE_STATIC,
+		.content_type = "application/octet-stream",
+	},
+	.static_data = large_data,
+	.static_data_len = sizeof(large_data),
+};
+
+HTTP_RESOURCE_DEFINE(large_resource, test_http_service, "/large.bin",
+		     &large_detail);
+
+static const char * const dynamic_parts[] = { "Hello, ", "world!" };
+static uint8_t dynamic_buf[32];
+static size_t dynamic_part;
+static size_t body_len;
+
+static int dynamic_cb(struct http_client_ctx *client,
+		      enum http_data_status status, uint8_t *data, size_t len,
+		      void *user_data)
+{
+	size_t part_len;
+
+	ARG_UNUSED(user_data);
+
+	if (status == HTTP_SERVER_DATA_MORE) {
+		body_len += len;
+		return 0;
+	}
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		return 0;
+	}
+
+	if (http_server_client_method(client) == HTTP_POST) {
+		/* Respond once with the received length */
+		if (body_len == SIZE_MAX) {
+			return 0;
+		}
+
+		part_len = snprintf((char *)data, len, "received %zu",
+				    body_len);
+		body_len = SIZE_MAX;
+
+		return part_len;
+	}
+
+	if (dynamic_part == ARRAY_SIZE(dynamic_parts)) {
+		dynamic_part = 0;
+		return 0;
+	}
+
+	part_len = strlen(dynamic_parts[dynamic_part]);
+	memcpy(data, dynamic_parts[dynamic_part++], part_len);
+
+	return part_len;
+}
+
+static struct http_resource_detail_dynamic dynamic_detail = {
+	.common = {
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET) | BIT(HTTP_POST),
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.content_type = "text/plain",
+	},
+	.cb = dynamic_cb,
+	.data_buffer = dynamic_buf,
+	.data_buffer_len = sizeof(dynamic_buf),
+};
+
+HTTP_RESOURCE_DEFINE(dynamic_resource, test_http_service, "/dynamic",
+		     &dynamic_detail);
+
+#define INDEX_RESPONSE_HEADER						\
+	"HTTP/1.1 200 OK\r\n"						\
+	"Content-Length: 31\r\n"					\
+	"Content-Type: text/html\r\n"
+
+#define INDEX_RESPONSE INDEX_RESPONSE_HEADER "\r\n" \
+	"<html><body>Hello</body></html>"
+
+#define DYNAMIC_RESPONSE						\
+	"HTTP/1.1 200 OK\r\n"						\
+	"Transfer-Encoding: chunked\r\n"				\
+	"Content-Type: text/plain\r\n"					\
+	"\r\n"								\
+	"7\r\nHello, \r\n"						\
+	"6\r\nworld!\r\n"						\
+	"0\r\n\r\n"
+
+static int client_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(test_http_service_port),
+	};
+	struct timeval timeo = {
+		.tv_sec = RECV_TIMEOUT_MS / MSEC_PER_SEC,
+	};
+	int sock;
+
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr), 1);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "Cannot create socket (%d)", errno);
+
+	zassert_ok(zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+				    sizeof(timeo)));
+	zassert_ok(zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)),
+		   "Cannot connect (%d)", errno);
+
+	return sock;
+}
+
+static void client_send(int sock, const char *req)
+{
+	size_t len = strlen(req);
+
+	zassert_equal(zsock_send(sock, req, len, 0), len, "Cannot send (%d)",
+		      errno);
+}
+
+/* Receive exactly the expected response and compare it */
+static void client_expect(int sock, const char *expected)
+{
+	static char buf[512];
+	size_t len = strlen(expected);
+	size_t received = 0;
+	ssize_t ret;
+
+	zassert_true(len < sizeof(buf));
+
+	while (received < len) {
+		ret = zsock_recv(sock, buf + received, len - received, 0);
+		zassert_true(ret > 0, "Response truncated after %zu bytes (%d)",
+			     received, errno);
+		received += ret;
+	}
+
+	buf[received] = '\0';
+
+	zassert_mem_equal(buf, expected, len, "Unexpected response:\n%s", buf);
+}
+
+static void client_expect_close(int sock)
+{
+	char c;
+
+	zassert_equal(zsock_recv(sock, &c, 1, 0), 0,
+		      "Connection not closed");
+}
+
+static void *http_server_setup(void)
+{
+	for (int i = 0; i < sizeof(large_data); i++) {
+		large_data[i] = i % 251;
+	}
+
+	zassert_ok(http_server_start(), "Cannot start server");
+	zassert_not_equal(test_http_service_port, 0, "No ephemeral port");
+
+	return NULL;
+}
+
+static void http_server_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(http_server_stop());
+}
+
+ZTEST(http_server_core, test_static_get)
+{
+	int sock = client_connect();
+
+	client_send(sock, "GET /index.html HTTP/1.1\r\nHost: localhost\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE);
+
+	/* The connection is kept alive */
+	client_send(sock, "GET /index.html?lang=en HTTP/1.1\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE);
+
+	client_send(sock, "HEAD /index.html HTTP/1.1\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE_HEADER "\r\n");
+
+	zsock_close(sock);
+}
+
+ZTEST(http_server_core, test_pipelining)
+{
+	int sock = client_connect();
+
+	/* Responses are sent in the order of the requests */
+	client_send(sock,
+		    "GET /index.html HTTP/1.1\r\n\r\n"
+		    "GET /dynamic HTTP/1.1\r\n\r\n"
+		    "GET /index.html HTTP/1.1\r\nConnection: close\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE);
+	client_expect(sock, DYNAMIC_RESPONSE);
+	client_expect(sock, INDEX_RESPONSE_HEADER "Connection: close\r\n\r\n"
+			    "<html><body>Hello</body></html>");
+	client_expect_close(sock);
+
+	zsock_close(sock);
+}
+
+ZTEST(http_server_core, test_dynamic)
+{
+	int sock = client_connect();
+
+	client_send(sock, "GET /dynamic HTTP/1.1\r\n\r\n");
+	client_expect(sock, DYNAMIC_RESPONSE);
+
+	body_len = 0;
+
+	client_send(sock, "POST /dynamic HTTP/1.1\r\n"
+			  "Content-Length: 10\r\n\r\n"
+			  "0123456789");
+	client_expect(sock, "HTTP/1.1 200 OK\r\n"
+			    "Transfer-Encoding: chunked\r\n"
+			    "Content-Type: text/plain\r\n"
+			    "\r\n"
+			    "b\r\nreceived 10\r\n"
+			    "0\r\n\r\n");
+
+	zsock_close(sock);
+}
+
+ZTEST(http_server_core, test_http_1_0)
+{
+	int sock = client_connect();
+
+	/* Not chunked, the connection is closed at the end */
+	client_send(sock, "GET /dynamic HTTP/1.0\r\n\r\n");
+	client_expect(sock, "HTTP/1.1 200 OK\r\n"
+			    "Content-Type: text/plain\r\n"
+			    "Connection: close\r\n"
+			    "\r\n"
+			    "Hello, world!");
+	client_expect_close(sock);
+
+	zsock_close(sock);
+
+	sock = client_connect();
+
+	client_send(sock, "GET /index.html HTTP/1.0\r\n"
+			  "Connection: keep-alive\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE_HEADER
+			    "Connection: keep-alive\r\n\r\n"
+			    "<html><body>Hello</body></html>");
+
+	zsock_close(sock);
+}
+
+ZTEST(http_server_core, test_errors)
+{
+	int sock = client_connect();
+
+	client_send(sock, "GET /missing.html HTTP/1.1\r\n\r\n");
+	client_expect(sock, "HTTP/1.1 404 Not Found\r\n"
+			    "Content-Length: 0\r\n\r\n");
+
+	client_send(sock, "POST /index.html HTTP/1.1\r\n"
+			  "Content-Length: 2\r\n\r\nab");
+	client_expect(sock, "HTTP/1.1 405 Method Not Allowed\r\n"
+			    "Content-Length: 0\r\n\r\n");
+
+	client_send(sock, "GET /" "0123456789012345678901234567890123456789"
+			  "0123456789012345678901234567890123456789"
+			  " HTTP/1.1\r\n\r\n");
+	client_expect(sock, "HTTP/1.1 414 URI Too Long\r\n"
+			    "Content-Length: 0\r\n\r\n");
+
+	client_send(sock, "NOT HTTP\r\n\r\n");
+	client_expect(sock, "HTTP/1.1 400 Bad Request\r\n"
+			    "Content-Length: 0\r\n\r\n");
+	client_expect_close(sock);
+
+	zsock_close(sock);
+}
+
+ZTEST(http_server_core, test_inactivity_timeout)
+{
+	int sock = client_connect();
+
+	client_send(sock, "GET /index.html HTTP/1.1\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE);
+
+	/* The server closes the idle connection */
+	client_expect_close(sock);
+
+	zsock_close(sock);
+}
+
+/* A client that does not read its response must not block the others */
+ZTEST(http_server_core, test_slow_reader)
+{
+	static uint8_t buf[LARGE_LEN];
+	int slow = client_connect();
+	int sock = client_connect();
+	size_t received = 0;
+	ssize_t ret;
+
+	client_send(slow, "GET /large.bin HTTP/1.1\r\n\r\n"
+			  "GET /index.html HTTP/1.1\r\n\r\n");
+	k_msleep(100);
+
+	client_send(sock, "GET /index.html HTTP/1.1\r\n\r\n");
+	client_expect(sock, INDEX_RESPONSE);
+	zsock_close(sock);
+
+	client_expect(slow, "HTTP/1.1 200 OK\r\n"
+			    "Content-Length: 6000\r\n"
+			    "Content-Type: application/octet-stream\r\n\r\n");
+
+	while (received < sizeof(buf)) {
+		ret = zsock_recv(slow, buf + received, sizeof(buf) - received, 0);
+		zassert_true(ret > 0, "Response truncated after %zu bytes (%d)",
+			     received, errno);
+		received += ret;
+	}
+
+	zassert_mem_equal(buf, large_data, sizeof(buf));
+
+	/* The pipelined request is answered after the large response */
+	client_expect(slow, INDEX_RESPONSE);
+
+	zsock_close(slow);
+}
+
+/* Connections above the concurrent limit wait in the listen queue */
+ZTEST(http_server_core, test_no_free_slot)
+{
+	struct timeval timeo = {
+		.tv_usec = 300 * USEC_PER_MSEC,
+	};
+	int socks[2];
+	int waiting;
+	char c;
+
+	for (int i = 0; i < ARRAY_SIZE(socks); i++) {
+		socks[i] = client_connect();
+		client_send(socks[i], "GET /index.html HTTP/1.1\r\n\r\n");
+		client_expect(socks[i], INDEX_RESPONSE);
+	}
+
+	waiting = client_connect();
+	client_send(waiting, "GET /index.html HTTP/1.1\r\n\r\n");
+
+	zassert_ok(zsock_setsockopt(waiting, SOL_SOCKET, SO_RCVTIMEO, &timeo,
+				    sizeof(timeo)));
+	zassert_equal(zsock_recv(waiting, &c, 1, 0), -1,
+		      "Served above the concurrent limit");
+	zassert_equal(errno, EAGAIN);
+
+	zsock_close(socks[0]);
+
+	/* Accepted once a client slot is free */
+	client_expect(waiting, INDEX_RESPONSE);
+
+	zsock_close(waiting);
+	zsock_close(socks[1]);
+}
+
+ZTEST_SUITE(http_server_core, NULL, http_server_setup, NULL, NULL,
+	    http_server_teardown);
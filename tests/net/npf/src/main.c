@@ -240,6 +240,51 @@ ZTEST(net_pkt_filter_test_suite, test_npf_example2)
 	zassert_false(npf_remove_all_recv_rules(), "");
 }
 
+/*
+ * Rules sharing the same conditions. A rule list is compiled so that the
+ * rules using a condition which is false for a packet are skipped.
+ */
+
+static NPF_RULE(drop_big_ip, NET_DROP, ip_packet, minsize_201);
+static NPF_RULE(accept_ip, NET_OK, ip_packet);
+static NPF_RULE(accept_big, NET_OK, minsize_201);
+
+ZTEST(net_pkt_filter_test_suite, test_npf_shared_tests)
+{
+	struct net_pkt *pkt;
+
+	npf_append_recv_rule(&drop_big_ip);
+	npf_append_recv_rule(&accept_ip);
+	npf_append_recv_rule(&accept_big);
+	npf_append_recv_rule(&npf_default_drop);
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_IP, 300, NULL);
+	zassert_false(net_pkt_filter_recv_ok(pkt), "");
+	net_pkt_unref(pkt);
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_IP, 100, NULL);
+	zassert_true(net_pkt_filter_recv_ok(pkt), "");
+	net_pkt_unref(pkt);
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_ARP, 100, NULL);
+	zassert_false(net_pkt_filter_recv_ok(pkt), "");
+	net_pkt_unref(pkt);
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_ARP, 300, NULL);
+	zassert_true(net_pkt_filter_recv_ok(pkt), "");
+	net_pkt_unref(pkt);
+
+	/* The result depends on the rule order */
+	zassert_true(npf_remove_recv_rule(&accept_big), "");
+	npf_insert_recv_rule(&accept_big);
+
+	pkt = build_test_pkt(NET_ETH_PTYPE_IP, 300, NULL);
+	zassert_true(net_pkt_filter_recv_ok(pkt), "");
+	net_pkt_unref(pkt);
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+}
+
 /*
  * Ethernet MAC address filtering
  */
@@ -59,6 +59,14 @@ static struct in6_addr peer_addr_alt = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
 static struct in6_addr dest_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
 					 0, 0, 0, 0, 0xd, 0xe, 0x5, 0x7 } } };
 
+/* Prefix that contains dest_addr, used with prefix length 112 */
+static struct in6_addr dest_prefix = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0xd, 0xe, 0, 0 } } };
+
+/* Another address within dest_prefix */
+static struct in6_addr dest_prefix_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+						0, 0, 0, 0, 0xd, 0xe, 0x1, 0x1 } } };
+
 /* Extra address is assigned to ll_addr */
 static struct in6_addr ll_addr = { { { 0xfe, 0x80, 0x43, 0xb8, 0, 0, 0, 0,
 				       0, 0, 0, 0xf2, 0xaa, 0x29, 0x02,
@@ -544,6 +552,43 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_match(void)
+{
+	struct net_route_entry *host_route, *prefix_route, *entry;
+
+	host_route = net_route_add(my_iface,
+				   &dest_addr, 128,
+				   &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(host_route, "Host route add failed");
+
+	prefix_route = net_route_add(my_iface,
+				     &dest_prefix, 112,
+				     &peer_addr_alt,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_route, "Prefix route add failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_route, "Longest prefix not found");
+
+	entry = net_route_lookup(NULL, &dest_prefix_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not found");
+
+	entry = net_route_lookup(peer_iface, &dest_addr);
+	zassert_is_null(entry, "Route found for wrong interface");
+
+	net_route_del(host_route);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_route, "Prefix route not used");
+
+	net_route_del(prefix_route);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Deleted route found");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +611,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_match();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_CORE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+#include "connection.h"
+#include "net_private.h"
+
+#define FLOWS 8
+#define PKTS_PER_FLOW 6
+#define LOCAL_PORT 4242
+#define REMOTE_PORT 5000
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *iface;
+static struct net_conn_handle *handles[FLOWS];
+
+/* Written only by the RX thread serving the flow */
+static struct flow_state {
+	k_tid_t thread;
+	int next_seq;
+	bool reordered;
+	bool moved;
+} flows[FLOWS];
+
+static K_SEM_DEFINE(recv_sem, 0, FLOWS * PKTS_PER_FLOW);
+
+static uint8_t test_mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void test_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, test_mac, sizeof(test_mac), NET_LINK_ETHERNET);
+}
+
+static int test_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api test_if_api = {
+	.iface_api.init = test_iface_init,
+	.send = test_send,
+};
+
+NET_DEVICE_INIT(net_rx_steering_test, "net_rx_steering_test", NULL, NULL, NULL,
+		NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &test_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 1500);
+
+static enum net_verdict udp_received(struct net_conn *conn, struct net_pkt *pkt,
+				     union net_ip_header *ip_hdr,
+				     union net_proto_header *proto_hdr,
+				     void *user_data)
+{
+	struct flow_state *flow = &flows[POINTER_TO_INT(user_data)];
+	uint8_t seq;
+
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+
+	zassert_ok(net_pkt_read_u8(pkt, &seq));
+
+	if (flow->thread == NULL) {
+		flow->thread = k_current_get();
+	} else if (flow->thread != k_current_get()) {
+		flow->moved = true;
+	}
+
+	if (seq != flow->next_seq) {
+		flow->reordered = true;
+	}
+
+	flow->next_seq = seq + 1;
+
+	/* Give the other RX threads a chance to run in between */
+	k_yield();
+
+	net_pkt_unref(pkt);
+	k_sem_give(&recv_sem);
+
+	return NET_OK;
+}
+
+static struct net_pkt *datagram(int flow, uint8_t seq)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_UDPH_LEN + sizeof(seq), AF_INET,
+					   IPPROTO_UDP, K_SECONDS(1));
+	zassert_not_null(pkt, "Out of packets");
+
+	zassert_ok(net_ipv4_create(pkt, &peer_addr, &my_addr));
+	zassert_ok(net_udp_create(pkt, htons(REMOTE_PORT + flow), htons(LOCAL_PORT)));
+	zassert_ok(net_pkt_write_u8(pkt, seq));
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_ipv4_finalize(pkt, IPPROTO_UDP));
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+/* Flows sent interleaved must each be processed in order by a single RX
+ * queue, and the flows must not all end up in the same queue.
+ */
+ZTEST(net_rx_steering, test_flows)
+{
+	k_tid_t threads[FLOWS];
+	int nthreads = 0;
+	int i, j;
+
+	for (i = 0; i < PKTS_PER_FLOW; i++) {
+		for (j = 0; j < FLOWS; j++) {
+			zassert_ok(net_recv_data(iface, datagram(j, i)));
+		}
+	}
+
+	for (i = 0; i < FLOWS * PKTS_PER_FLOW; i++) {
+		zassert_ok(k_sem_take(&recv_sem, K_SECONDS(1)),
+			   "Only %d packets received", i);
+	}
+
+	for (i = 0; i < FLOWS; i++) {
+		zassert_equal(flows[i].next_seq, PKTS_PER_FLOW, "Flow %d lost packets", i);
+		zassert_false(flows[i].reordered, "Flow %d reordered", i);
+		zassert_false(flows[i].moved, "Flow %d changed queue", i);
+
+		for (j = 0; j < nthreads; j++) {
+			if (threads[j] == flows[i].thread) {
+				break;
+			}
+		}
+
+		if (j == nthreads) {
+			threads[nthreads++] = flows[i].thread;
+		}
+	}
+
+	zassert_true(nthreads > 1, "All flows processed by one queue");
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+		.sin_port = htons(LOCAL_PORT),
+	};
+	int ret;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_rx_steering_test));
+	zassert_not_null(iface);
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0));
+
+	for (int i = 0; i < FLOWS; i++) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+					(struct sockaddr *)&local, REMOTE_PORT + i,
+					LOCAL_PORT, NULL, udp_received, INT_TO_POINTER(i),
+					&handles[i]);
+		zassert_ok(ret, "Cannot register connection (%d)", ret);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_rx_steering, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define TEST_STR_SMALL "test"
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define SERVER_PORT2 4243
+#define CLIENT_PORT 9898
+
+#define WAIT_MS 50
+
+static int c_sock, s_sock, s_sock2;
+static struct sockaddr_in6 s_addr, s_addr2;
+
+static void send_to(struct sockaddr_in6 *addr)
+{
+	ssize_t len;
+
+	len = sendto(c_sock, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), 0,
+		     (struct sockaddr *)addr, sizeof(*addr));
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "sendto failed");
+}
+
+static void drain(int sock)
+{
+	char buf[16];
+
+	while (recv(sock, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+	}
+
+	zassert_equal(errno, EAGAIN, "unexpected recv error");
+}
+
+static int epoll_add(int epfd, int sock, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = sock,
+	};
+
+	return epoll_ctl(epfd, EPOLL_CTL_ADD, sock, &ev);
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in6 c_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT2, &s_sock2, &s_addr2);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = bind(s_sock2, (struct sockaddr *)&s_addr2, sizeof(s_addr2));
+	zassert_equal(res, 0, "bind failed");
+
+	res = bind(c_sock, (struct sockaddr *)&c_addr, sizeof(c_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain(s_sock);
+	drain(s_sock2);
+}
+
+ZTEST(net_socket_epoll, test_ctl_errors)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+	int epfd;
+
+	zassert_equal(epoll_create(0), -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &ev), -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev), "");
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev), -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &ev), -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	zassert_equal(epoll_ctl(s_sock, EPOLL_CTL_ADD, s_sock2, &ev), -1, "");
+	zassert_equal(errno, EBADF, "");
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL), "");
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL), -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	zassert_ok(close(epfd), "");
+}
+
+ZTEST(net_socket_epoll, test_level_triggered)
+{
+	struct epoll_event ev[2];
+	int epfd;
+	int res;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	zassert_ok(epoll_add(epfd, s_sock, EPOLLIN), "");
+	zassert_ok(epoll_add(epfd, s_sock2, EPOLLIN), "");
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "unexpected event");
+
+	send_to(&s_addr2);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].events, EPOLLIN, "");
+	zassert_equal(ev[0].data.fd, s_sock2, "");
+
+	/* Still ready, so reported again */
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 1, "level not reported again");
+
+	drain(s_sock2);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0);
+	zassert_equal(res, 0, "unexpected event");
+
+	zassert_ok(close(epfd), "");
+}
+
+ZTEST(net_socket_epoll, test_edge_triggered)
+{
+	struct epoll_event ev[2];
+	int epfd;
+	int res;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	zassert_ok(epoll_add(epfd, s_sock, EPOLLIN | EPOLLET), "");
+
+	send_to(&s_addr);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+	zassert_equal(ev[0].data.fd, s_sock, "");
+
+	/* Not reported again until the condition is cleared */
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "edge reported twice");
+
+	drain(s_sock);
+	send_to(&s_addr);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "new edge not reported");
+
+	drain(s_sock);
+	zassert_ok(close(epfd), "");
+}
+
+ZTEST(net_socket_epoll, test_oneshot)
+{
+	struct epoll_event ev[2];
+	struct epoll_event mod = {
+		.events = EPOLLIN | EPOLLONESHOT,
+		.data.u32 = 42,
+	};
+	int epfd;
+	int res;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	zassert_ok(epoll_add(epfd, s_sock, EPOLLIN | EPOLLONESHOT), "");
+
+	send_to(&s_addr);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "no event");
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "one-shot reported twice");
+
+	/* Re-arm with new user data */
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &mod), "");
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "not re-armed");
+	zassert_equal(ev[0].data.u32, 42, "wrong user data");
+
+	drain(s_sock);
+	zassert_ok(close(epfd), "");
+}
+
+ZTEST(net_socket_epoll, test_maxevents_round_robin)
+{
+	struct epoll_event ev[1];
+	int epfd;
+	int first;
+	int res;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	zassert_ok(epoll_add(epfd, s_sock, EPOLLIN), "");
+	zassert_ok(epoll_add(epfd, s_sock2, EPOLLIN), "");
+
+	send_to(&s_addr);
+	send_to(&s_addr2);
+	k_msleep(WAIT_MS);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "");
+	first = ev[0].data.fd;
+
+	/* Both are still ready, the other one must come next */
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 1, "");
+	zassert_not_equal(ev[0].data.fd, first, "socket starved");
+
+	zassert_ok(close(epfd), "");
+}
+
+/* Each instance keeps its own edge-triggered state for a socket */
+ZTEST(net_socket_epoll, test_edge_triggered_two_instances)
+{
+	struct epoll_event ev[2];
+	char buf[16];
+	int epfd[2];
+	int res;
+
+	for (int i = 0; i < ARRAY_SIZE(epfd); i++) {
+		epfd[i] = epoll_create(1);
+		zassert_true(epfd[i] >= 0, "epoll_create failed (%d)", errno);
+		zassert_ok(epoll_add(epfd[i], s_sock, EPOLLIN | EPOLLET), "");
+	}
+
+	send_to(&s_addr);
+	send_to(&s_addr);
+	k_msleep(WAIT_MS);
+
+	for (int i = 0; i < ARRAY_SIZE(epfd); i++) {
+		res = epoll_wait(epfd[i], ev, ARRAY_SIZE(ev), 0);
+		zassert_equal(res, 1, "no event on instance %d", i);
+	}
+
+	/* Read one of the two datagrams, both instances see the new edge */
+	zassert_true(recv(s_sock, buf, sizeof(buf), 0) > 0, "recv failed");
+
+	for (int i = 0; i < ARRAY_SIZE(epfd); i++) {
+		res = epoll_wait(epfd[i], ev, ARRAY_SIZE(ev), 0);
+		zassert_equal(res, 1, "edge lost on instance %d", i);
+
+		res = epoll_wait(epfd[i], ev, ARRAY_SIZE(ev), 0);
+		zassert_equal(res, 0, "edge reported twice on instance %d", i);
+	}
+
+	drain(s_sock);
+
+	for (int i = 0; i < ARRAY_SIZE(epfd); i++) {
+		zassert_ok(close(epfd[i]), "");
+	}
+}
+
+/* A closed socket leaves the interest list, so a new socket reusing its
+ * descriptor number is not watched.
+ */
+ZTEST(net_socket_epoll, test_close_removes)
+{
+	struct sockaddr_in6 addr;
+	struct epoll_event ev[1];
+	int epfd;
+	int sock;
+	int sock2;
+	int res;
+
+	epfd = epoll_create(1);
+	zassert_true(epfd >= 0, "epoll_create failed (%d)", errno);
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT + 10, &sock, &addr);
+	zassert_ok(bind(sock, (struct sockaddr *)&addr, sizeof(addr)), "");
+	zassert_ok(epoll_add(epfd, sock, EPOLLIN), "");
+	zassert_ok(close(sock), "");
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT + 11, &sock2, &addr);
+	zassert_equal(sock2, sock, "descriptor not reused");
+	zassert_ok(bind(sock2, (struct sockaddr *)&addr, sizeof(addr)), "");
+
+	send_to(&addr);
+
+	res = epoll_wait(epfd, ev, ARRAY_SIZE(ev), WAIT_MS);
+	zassert_equal(res, 0, "closed socket still watched");
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, sock2, NULL), -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	zassert_ok(close(sock2), "");
+	zassert_ok(close(epfd), "");
+}
+
+static int wakeup_epfd;
+
+static void add_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_ok(epoll_add(wakeup_epfd, s_sock, EPOLLIN), "");
+}
+
+static K_WORK_DELAYABLE_DEFINE(add_work, add_work_handler);
+
+ZTEST(net_socket_epoll, test_ctl_wakes_waiter)
+{
+	struct epoll_event ev[1];
+	int res;
+
+	wakeup_epfd = epoll_create(1);
+	zassert_true(wakeup_epfd >= 0, "epoll_create failed (%d)", errno);
+
+	/* Data is pending before the socket is even registered */
+	send_to(&s_addr);
+	k_msleep(WAIT_MS);
+
+	k_work_schedule(&add_work, K_MSEC(WAIT_MS));
+
+	res = epoll_wait(wakeup_epfd, ev, ARRAY_SIZE(ev), 10 * WAIT_MS);
+	zassert_equal(res, 1, "waiter not woken up by epoll_ctl");
+	zassert_equal(ev[0].data.fd, s_sock, "");
+
+	zassert_ok(close(wakeup_epfd), "");
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, setup, before, NULL, NULL);
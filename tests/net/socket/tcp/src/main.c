@@ -11,6 +11,10 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <fcntl.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
+#if defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#endif
 
 #include "../../socket_helpers.h"
 
@@ -266,6 +270,224 @@ ZTEST_USER(net_socket_tcp, test_v4_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+ZTEST(net_socket_tcp, test_v4_recv_zerocopy)
+{
+	/* Test if zsock_recv_zc() works on a ipv4 stream socket. */
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct zsock_zc_buf zc;
+	struct net_buf *frag;
+	size_t offset = 0;
+	ssize_t ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_LONG, strlen(TEST_STR_LONG), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	while (offset < strlen(TEST_STR_LONG)) {
+		ret = zsock_recv_zc(new_sock, &zc, 0, NULL, NULL);
+		zassert_true(ret > 0, "zsock_recv_zc failed (%d)", errno);
+
+		for (frag = zc.frags; frag != NULL; frag = frag->frags) {
+			zassert_true(offset + frag->len <= strlen(TEST_STR_LONG),
+				     "too much data");
+			zassert_mem_equal(frag->data, TEST_STR_LONG + offset,
+					  frag->len, "wrong data");
+			offset += frag->len;
+		}
+
+		zsock_recv_zc_release(&zc);
+	}
+
+	test_close(c_sock);
+
+	/* EOF is reported as 0 */
+	ret = zsock_recv_zc(new_sock, &zc, 0, NULL, NULL);
+	zassert_equal(ret, 0, "EOF not detected");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#if defined(CONFIG_FILE_SYSTEM)
+/* Read-only file system serving a single file with a byte pattern */
+#define SENDFILE_FS_TYPE FS_TYPE_EXTERNAL_BASE
+#define SENDFILE_LEN 20000
+
+static off_t sendfile_pos;
+
+static uint8_t sendfile_pattern(off_t pos)
+{
+	return (uint8_t)(pos % 251);
+}
+
+static int sendfile_fs_open(struct fs_file_t *filp, const char *fs_path,
+			    fs_mode_t flags)
+{
+	ARG_UNUSED(fs_path);
+	ARG_UNUSED(flags);
+
+	sendfile_pos = 0;
+	filp->filep = &sendfile_pos;
+
+	return 0;
+}
+
+static ssize_t sendfile_fs_read(struct fs_file_t *filp, void *dest,
+				size_t nbytes)
+{
+	uint8_t *ptr = dest;
+	size_t i;
+
+	nbytes = MIN(nbytes, SENDFILE_LEN - sendfile_pos);
+
+	for (i = 0; i < nbytes; i++) {
+		ptr[i] = sendfile_pattern(sendfile_pos++);
+	}
+
+	return nbytes;
+}
+
+static int sendfile_fs_lseek(struct fs_file_t *filp, off_t off, int whence)
+{
+	if (whence != FS_SEEK_SET || off < 0 || off > SENDFILE_LEN) {
+		return -EINVAL;
+	}
+
+	sendfile_pos = off;
+
+	return 0;
+}
+
+static off_t sendfile_fs_tell(struct fs_file_t *filp)
+{
+	return sendfile_pos;
+}
+
+static int sendfile_fs_close(struct fs_file_t *filp)
+{
+	return 0;
+}
+
+static int sendfile_fs_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int sendfile_fs_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static const struct fs_file_system_t sendfile_fs = {
+	.open = sendfile_fs_open,
+	.read = sendfile_fs_read,
+	.lseek = sendfile_fs_lseek,
+	.tell = sendfile_fs_tell,
+	.close = sendfile_fs_close,
+	.mount = sendfile_fs_mount,
+	.unmount = sendfile_fs_unmount,
+};
+
+static struct fs_mount_t sendfile_mnt = {
+	.type = SENDFILE_FS_TYPE,
+	.mnt_point = "/sendfile",
+};
+#endif /* CONFIG_FILE_SYSTEM */
+
+ZTEST(net_socket_tcp, test_v4_sendfile)
+{
+	/* Test if zsock_sendfile() streams a file over a ipv4 stream socket. */
+	Z_TEST_SKIP_IFNDEF(CONFIG_FILE_SYSTEM);
+#if defined(CONFIG_FILE_SYSTEM)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct fs_file_t file;
+	uint8_t buf[256];
+	off_t offset = 0;
+	size_t received = 0;
+	ssize_t ret;
+	int i;
+
+	zassert_ok(fs_register(SENDFILE_FS_TYPE, &sendfile_fs), "");
+	zassert_ok(fs_mount(&sendfile_mnt), "");
+
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, "/sendfile/image.bin", FS_O_READ), "");
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* The file is larger than the send window, so use a non-blocking
+	 * sender and drain the receiver in between.
+	 */
+	zassert_ok(zsock_fcntl(c_sock, F_SETFL, O_NONBLOCK), "");
+
+	while (received < SENDFILE_LEN) {
+		if (offset < SENDFILE_LEN) {
+			ret = zsock_sendfile(c_sock, &file, &offset,
+					     SENDFILE_LEN - offset);
+			zassert_true(ret > 0 || (ret < 0 && errno == EAGAIN),
+				     "zsock_sendfile failed (%d)", errno);
+		}
+
+		ret = zsock_recv(new_sock, buf, sizeof(buf), 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+
+		for (i = 0; i < ret; i++) {
+			zassert_equal(buf[i], sendfile_pattern(received + i),
+				      "wrong data at %zu", received + i);
+		}
+
+		received += ret;
+	}
+
+	zassert_equal(offset, SENDFILE_LEN, "wrong offset");
+
+	/* With an offset given, the file position is not changed */
+	zassert_equal(fs_tell(&file), 0, "file position changed");
+
+	/* End of file */
+	ret = zsock_sendfile(c_sock, &file, &offset, sizeof(buf));
+	zassert_equal(ret, 0, "EOF not reported");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	zassert_ok(fs_close(&file), "");
+	zassert_ok(fs_unmount(&sendfile_mnt), "");
+	zassert_ok(fs_unregister(SENDFILE_FS_TYPE, &sendfile_fs), "");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#endif
+}
+
 ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 {
 	/* Test if send() and recv() work on a ipv6 stream socket. */
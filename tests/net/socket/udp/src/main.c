@@ -2408,6 +2408,159 @@ ZTEST_USER(net_socket_udp, test_35_recvmsg_msg_controllen_update)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#define MMSG_COUNT 4
+
+ZTEST_USER(net_socket_udp, test_36_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgvec[MMSG_COUNT];
+	struct iovec io_vector[MMSG_COUNT];
+	char bufs[MMSG_COUNT][sizeof(TEST_STR_SMALL) + 1];
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(msgvec, 0, sizeof(msgvec));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		snprintk(bufs[i], sizeof(bufs[i]), "%s%d", TEST_STR_SMALL, i);
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = strlen(bufs[i]);
+
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(bufs[i]),
+			      "invalid msg_len %u", msgvec[i].msg_len);
+	}
+
+	/* Give the loopback interface time to deliver all the datagrams */
+	k_msleep(100);
+
+	memset(msgvec, 0, sizeof(msgvec));
+	memset(bufs, 0, sizeof(bufs));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = sizeof(bufs[i]);
+
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Ask for more messages than there are queued, the call must not
+	 * block after the first one.
+	 */
+	rv = recvmmsg(server_sock, msgvec, MMSG_COUNT, MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d, errno %d)", rv, errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		char expected[sizeof(bufs[i])];
+
+		snprintk(expected, sizeof(expected), "%s%d", TEST_STR_SMALL, i);
+
+		zassert_equal(msgvec[i].msg_len, strlen(expected),
+			      "invalid msg_len %u", msgvec[i].msg_len);
+		zassert_mem_equal(bufs[i], expected, strlen(expected),
+				  "wrong data (%s)", bufs[i]);
+	}
+
+	rv = recvmmsg(server_sock, msgvec, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_37_v4_recv_zerocopy)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	struct zsock_zc_buf zc;
+	struct net_buf *frag;
+	size_t offset = 0;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(client_sock,
+		  (struct sockaddr *)&client_addr,
+		  sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	rv = zsock_recv_zc(server_sock, &zc, 0, (struct sockaddr *)&addr,
+			   &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "zsock_recv_zc failed (%d)", errno);
+	zassert_equal(zc.len, STRLEN(TEST_STR2), "invalid length");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "invalid addrlen");
+	zassert_equal(addr.sin_port, client_addr.sin_port, "invalid port");
+
+	/* The payload spans multiple fragments, check it in place */
+	for (frag = zc.frags; frag != NULL; frag = frag->frags) {
+		zassert_true(offset + frag->len <= STRLEN(TEST_STR2),
+			     "too much data");
+		zassert_mem_equal(frag->data, TEST_STR2 + offset, frag->len,
+				  "wrong data");
+		offset += frag->len;
+	}
+
+	zassert_equal(offset, STRLEN(TEST_STR2), "data missing");
+
+	zsock_recv_zc_release(&zc);
+	zassert_is_null(zc.frags, "buffers not released");
+
+	rv = zsock_recv_zc(server_sock, &zc, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "zsock_recv_zc should have failed");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_recv_zc(server_sock, &zc, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_equal(rv, -1, "zsock_recv_zc should have failed");
+	zassert_equal(errno, EINVAL, "invalid errno (%d)", errno);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
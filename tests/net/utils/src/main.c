@@ -912,8 +912,8 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 
 	/* Work across all possible combination so offset and length */
-	for (int offset = 0; offset < 7; offset++) {
-		for (int length = 1; length < 32; length++) {
+	for (int offset = 0; offset < 8; offset++) {
+		for (int length = 1; length < 80; length++) {
 			sum_got = calc_chksum_ref(offset ^ 0x8e72, testdata + offset, length);
 			sum_exp = calc_chksum(offset ^ 0x8e72, testdata + offset, length);
 
@@ -923,4 +923,47 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+static uint16_t chksum_field(const uint8_t *data, size_t len)
+{
+	return ~htons(calc_chksum(0, data, len));
+}
+
+ZTEST(test_utils_fn, test_ip_checksum_incremental)
+{
+	uint8_t old_data[16];
+	uint16_t chksum, old_val, new_val;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 31 + 7);
+	}
+
+	/* Change single words, like a TTL decrement or a type change */
+	for (int offset = 0; offset < 64; offset += 2) {
+		chksum = chksum_field(testdata, CHECKSUM_TEST_LENGTH);
+
+		old_val = UNALIGNED_GET((uint16_t *)&testdata[offset]);
+		new_val = old_val - offset - 1;
+		UNALIGNED_PUT(new_val, (uint16_t *)&testdata[offset]);
+
+		zassert_equal(net_chksum_update_16(chksum, old_val, new_val),
+			      chksum_field(testdata, CHECKSUM_TEST_LENGTH),
+			      "Incremental update mismatch at %d", offset);
+	}
+
+	/* Rewrite an address, like NAT does */
+	for (int offset = 0; offset < 64; offset += 2) {
+		chksum = chksum_field(testdata, CHECKSUM_TEST_LENGTH);
+
+		memcpy(old_data, &testdata[offset], sizeof(old_data));
+		for (int i = 0; i < sizeof(old_data); i++) {
+			testdata[offset + i] ^= (uint8_t)(i + offset);
+		}
+
+		zassert_equal(net_chksum_update(chksum, old_data, &testdata[offset],
+						sizeof(old_data)),
+			      chksum_field(testdata, CHECKSUM_TEST_LENGTH),
+			      "Incremental block update mismatch at %d", offset);
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
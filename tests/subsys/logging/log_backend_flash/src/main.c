@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_flash.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define LOG_PARTITION_ID DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_log_partition))
+#define SECTOR_SIZE 4096
+#define SECTOR_HDR_SIZE sizeof(struct log_backend_flash_sector_hdr)
+#define RECORD_HDR_SIZE sizeof(struct log_backend_flash_record_hdr)
+
+struct scan_result {
+	uint32_t sectors;
+	uint32_t newest;
+	uint32_t newest_seq;
+	/* Records of the newest sector */
+	uint32_t good;
+	uint32_t bad;
+	size_t tail;
+};
+
+static const struct flash_area *fa;
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+static void scan(struct scan_result *res)
+{
+	struct log_backend_flash_sector_hdr hdr;
+	struct log_backend_flash_record_hdr rec;
+	uint8_t data[CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE];
+	size_t off;
+
+	memset(res, 0, sizeof(*res));
+
+	for (uint32_t i = 0; i < fa->fa_size / SECTOR_SIZE; i++) {
+		zassert_ok(flash_area_read(fa, i * SECTOR_SIZE, &hdr, sizeof(hdr)));
+		if (hdr.magic != LOG_BACKEND_FLASH_MAGIC) {
+			continue;
+		}
+
+		zassert_equal(hdr.crc, crc32_ieee((uint8_t *)&hdr, offsetof(struct log_backend_flash_sector_hdr, crc)));
+		if ((res->sectors == 0) || ((int32_t)(hdr.seq - res->newest_seq) > 0)) {
+			res->newest = i;
+			res->newest_seq = hdr.seq;
+		}
+		res->sectors++;
+	}
+
+	if (res->sectors == 0) {
+		return;
+	}
+
+	off = SECTOR_HDR_SIZE;
+	while (off + RECORD_HDR_SIZE <= SECTOR_SIZE) {
+		zassert_ok(flash_area_read(fa, res->newest * SECTOR_SIZE + off, &rec,
+					   sizeof(rec)));
+		if ((rec.len ^ rec.len_inv) != UINT16_MAX) {
+			break;
+		}
+
+		zassert_true(rec.len <= sizeof(data));
+		zassert_ok(flash_area_read(fa, res->newest * SECTOR_SIZE + off + RECORD_HDR_SIZE,
+					   data, rec.len));
+		if (rec.crc == crc32_ieee(data, rec.len)) {
+			zassert_equal(data[0], MSG_NORMAL);
+			res->good++;
+		} else {
+			res->bad++;
+		}
+
+		off += RECORD_HDR_SIZE + rec.len;
+	}
+
+	res->tail = off;
+}
+
+static void remount(void)
+{
+	const struct log_backend *backend = log_backend_get_by_name("log_backend_flash");
+
+	zassert_not_null(backend);
+	log_backend_init(backend);
+}
+
+ZTEST(log_backend_flash, test_records)
+{
+	struct scan_result res;
+
+	for (int i = 0; i < 10; i++) {
+		LOG_INF("message %d", i);
+	}
+	flush();
+
+	scan(&res);
+	zassert_equal(res.sectors, 1);
+	zassert_equal(res.newest, 0);
+	zassert_equal(res.newest_seq, 0);
+	zassert_equal(res.good, 10);
+	zassert_equal(res.bad, 0);
+}
+
+ZTEST(log_backend_flash, test_wrap)
+{
+	uint32_t sector_cnt = fa->fa_size / SECTOR_SIZE;
+	struct scan_result res;
+	uint32_t prev_seq = 0;
+	int wraps = 0;
+
+	/* Log until the ring wrapped twice */
+	for (int i = 0; wraps < 2; i++) {
+		LOG_INF("message %d with some payload to fill the sectors faster", i);
+		flush();
+
+		scan(&res);
+		zassert_true(res.good > 0);
+		if ((res.newest_seq != prev_seq) && (res.newest == 0)) {
+			wraps++;
+		}
+		prev_seq = res.newest_seq;
+	}
+
+	zassert_equal(res.sectors, sector_cnt);
+	zassert_equal(res.newest_seq, 2 * sector_cnt);
+	zassert_equal(res.bad, 0);
+}
+
+ZTEST(log_backend_flash, test_remount)
+{
+	struct scan_result res;
+
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("message %d", i);
+	}
+	flush();
+
+	remount();
+	LOG_INF("after remount");
+	flush();
+
+	scan(&res);
+	zassert_equal(res.sectors, 1);
+	zassert_equal(res.good, 6);
+}
+
+ZTEST(log_backend_flash, test_torn_record)
+{
+	struct log_backend_flash_record_hdr rec = {
+		.len = 16,
+		.len_inv = (uint16_t)~16,
+		.crc = 0,
+	};
+	uint8_t garbage[16] = {0};
+	struct scan_result res;
+
+	LOG_INF("before");
+	flush();
+	scan(&res);
+
+	/* Record with a valid header but a torn payload is skipped */
+	zassert_ok(flash_area_write(fa, res.tail, &rec, sizeof(rec)));
+	zassert_ok(flash_area_write(fa, res.tail + sizeof(rec), garbage, 8));
+
+	remount();
+	LOG_INF("after");
+	flush();
+
+	scan(&res);
+	zassert_equal(res.sectors, 1);
+	zassert_equal(res.good, 2);
+	zassert_equal(res.bad, 1);
+}
+
+ZTEST(log_backend_flash, test_torn_header)
+{
+	struct scan_result res;
+	uint8_t garbage[4] = {0};
+
+	LOG_INF("before");
+	flush();
+	scan(&res);
+
+	/* Programmed bytes behind the tail mean that the header of the last
+	 * record was not written, the sector is not safe to append to.
+	 */
+	zassert_ok(flash_area_write(fa, res.tail + RECORD_HDR_SIZE, garbage, sizeof(garbage)));
+
+	remount();
+	LOG_INF("after");
+	flush();
+
+	scan(&res);
+	zassert_equal(res.sectors, 2);
+	zassert_equal(res.newest, 1);
+	zassert_equal(res.newest_seq, 1);
+	zassert_equal(res.good, 1);
+}
+
+static void *setup(void)
+{
+	zassert_ok(flash_area_open(LOG_PARTITION_ID, &fa));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	flush();
+	zassert_ok(log_backend_flash_erase());
+}
+
+ZTEST_SUITE(log_backend_flash, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_event.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define MAX_LEN 128
+
+static uint8_t rec[MAX_LEN];
+static size_t rec_len;
+static size_t rec_plen;
+static int rec_cnt;
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *data = log_msg_get_data(&msg->log, &len);
+
+	ARG_UNUSED(backend);
+
+	(void)log_msg_get_package(&msg->log, &rec_plen);
+	rec_len = MIN(len, sizeof(rec));
+	memcpy(rec, data, rec_len);
+	rec_cnt++;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(test_backend, backend_api, true);
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+/* Return the schema of the captured record and check its content. */
+static const struct log_event_schema *schema_check(const char *name, const char *fields,
+						   const char *types)
+{
+	const struct log_event_schema *schema;
+
+	flush();
+	zassert_equal(rec_cnt, 1, "Got %d messages", rec_cnt);
+	zassert_equal(rec_plen, 0, "Event must not have a package");
+	zassert_true(rec_len >= sizeof(schema));
+
+	memcpy(&schema, rec, sizeof(schema));
+	zassert_equal(strcmp(schema->name, name), 0, "Got \"%s\"", schema->name);
+	zassert_equal(strcmp(schema->fields, fields), 0, "Got \"%s\"", schema->fields);
+	zassert_equal(strcmp(schema->types, types), 0, "Got \"%s\"", schema->types);
+
+	return schema;
+}
+
+ZTEST(log_event, test_fields)
+{
+	uint8_t u8 = 200;
+	int16_t i16 = -2;
+	uint32_t u32 = 0xdeadbeef;
+	int64_t i64 = -4;
+	float f = 1.5f;
+	double d = 2.5;
+	const char *s = "hi";
+	bool b = true;
+	const uint8_t *p = &rec[sizeof(void *)];
+
+	LOG_EVENT(sample, (a, u8), (b, i16), (c, u32), (d, i64), (e, f), (f, d), (g, s), (h, b));
+
+	schema_check("sample", "a,b,c,d,e,f,g,h", "BhIqfds?");
+	zassert_equal(rec_len, sizeof(void *) + 1 + 2 + 4 + 8 + 4 + 8 + 3 + 1);
+
+	zassert_equal(*p, u8);
+	p += 1;
+	zassert_equal(memcmp(p, &i16, sizeof(i16)), 0);
+	p += sizeof(i16);
+	zassert_equal(memcmp(p, &u32, sizeof(u32)), 0);
+	p += sizeof(u32);
+	zassert_equal(memcmp(p, &i64, sizeof(i64)), 0);
+	p += sizeof(i64);
+	zassert_equal(memcmp(p, &f, sizeof(f)), 0);
+	p += sizeof(f);
+	zassert_equal(memcmp(p, &d, sizeof(d)), 0);
+	p += sizeof(d);
+	zassert_equal(p[0], 2);
+	zassert_equal(memcmp(&p[1], "hi", 2), 0);
+	p += 3;
+	zassert_equal(*p, 1);
+}
+
+ZTEST(log_event, test_pointer)
+{
+	int x;
+	void *v;
+
+	LOG_EVENT(ptr, (p, (void *)&x), (c, (const void *)&x));
+
+	schema_check("ptr", "p,c", "PP");
+	zassert_equal(rec_len, 3 * sizeof(void *));
+
+	memcpy(&v, &rec[sizeof(void *)], sizeof(v));
+	zassert_equal_ptr(v, &x);
+	memcpy(&v, &rec[2 * sizeof(void *)], sizeof(v));
+	zassert_equal_ptr(v, &x);
+}
+
+ZTEST(log_event, test_no_fields)
+{
+	LOG_EVENT(boot);
+
+	schema_check("boot", "", "");
+	zassert_equal(rec_len, sizeof(void *));
+}
+
+ZTEST(log_event, test_string_truncated)
+{
+	char buf[] = "0123456789";
+
+	LOG_EVENT(str, (s, buf), (n, (const char *)NULL));
+
+	schema_check("str", "s,n", "ss");
+	zassert_equal(rec_len, sizeof(void *) + 1 + CONFIG_LOG_EVENT_STR_MAX_LEN + 1);
+	zassert_equal(rec[sizeof(void *)], CONFIG_LOG_EVENT_STR_MAX_LEN);
+	zassert_equal(memcmp(&rec[sizeof(void *) + 1], buf, CONFIG_LOG_EVENT_STR_MAX_LEN), 0);
+	zassert_equal(rec[rec_len - 1], 0);
+}
+
+ZTEST(log_event, test_same_site)
+{
+	const struct log_event_schema *schema[2];
+
+	for (int i = 0; i < 2; i++) {
+		LOG_EVENT(loop, (i, i));
+		schema[i] = schema_check("loop", "i", "i");
+		rec_cnt = 0;
+	}
+
+	zassert_equal(schema[0], schema[1], "Call site must have a single schema");
+}
+
+ZTEST(log_event, test_filtered)
+{
+	uint32_t source_id = log_dynamic_source_id(__log_current_dynamic_data);
+
+	log_filter_set(&test_backend, Z_LOG_LOCAL_DOMAIN_ID, source_id, LOG_LEVEL_WRN);
+	LOG_EVENT(filtered, (x, 1));
+	flush();
+	log_filter_set(&test_backend, Z_LOG_LOCAL_DOMAIN_ID, source_id, LOG_LEVEL_INF);
+
+	zassert_equal(rec_cnt, 0, "Event must be filtered out");
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	flush();
+	rec_cnt = 0;
+	rec_len = 0;
+}
+
+ZTEST_SUITE(log_event, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define MSG_CNT 50
+#define WRAP_CNT 400
+#define WRAP_BATCH 20
+
+struct backend_ctx {
+	k_timeout_t delay;
+	atomic_t processed;
+	atomic_t dropped;
+	atomic_t hold;
+	k_tid_t tid;
+	size_t bytes;
+	long next_seq;
+	int gaps;
+	int corrupted;
+};
+
+static K_SEM_DEFINE(gate, 0, 1);
+
+struct out_buf {
+	char data[32];
+	size_t len;
+};
+
+static int out(int c, void *ctx)
+{
+	struct out_buf *buf = ctx;
+
+	if (buf->len < sizeof(buf->data) - 1) {
+		buf->data[buf->len++] = c;
+	}
+
+	return c;
+}
+
+/* Check that the messages logged by test_wrap are intact and in order. */
+static void check_seq(struct backend_ctx *ctx, union log_msg_generic *msg)
+{
+	struct out_buf buf = { .len = 0 };
+	size_t len;
+	char *end;
+	long seq;
+
+	(void)cbpprintf(out, &buf, log_msg_get_package(&msg->log, &len));
+	buf.data[buf.len] = '\0';
+
+	if (strncmp(buf.data, "wrap ", 5) != 0) {
+		return;
+	}
+
+	seq = strtol(&buf.data[5], &end, 10);
+	if ((*end != '\0') || (seq < ctx->next_seq)) {
+		ctx->corrupted++;
+		return;
+	}
+
+	if (seq != ctx->next_seq) {
+		ctx->gaps++;
+	}
+
+	ctx->next_seq = seq + 1;
+}
+
+static struct backend_ctx fast_ctx = {
+	.delay = K_NO_WAIT,
+};
+
+static struct backend_ctx slow_ctx = {
+	.delay = K_MSEC(5),
+};
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	struct backend_ctx *ctx = backend->cb->ctx;
+
+	ctx->tid = k_current_get();
+	if (atomic_get(&ctx->hold)) {
+		(void)k_sem_take(&gate, K_FOREVER);
+	}
+
+	ctx->bytes += log_msg_generic_get_wlen(&msg->buf) * sizeof(uint32_t);
+	check_seq(ctx, msg);
+	k_sleep(ctx->delay);
+	atomic_inc(&ctx->processed);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	struct backend_ctx *ctx = backend->cb->ctx;
+
+	atomic_add(&ctx->dropped, cnt);
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.dropped = dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(fast_backend, backend_api, true, &fast_ctx);
+LOG_BACKEND_DEFINE(slow_backend, backend_api, true, &slow_ctx);
+
+static void wait_processed(struct backend_ctx *ctx, atomic_val_t cnt)
+{
+	while (atomic_get(&ctx->processed) < cnt) {
+		k_msleep(1);
+	}
+}
+
+/* Wait until a backend stops making progress. */
+static void wait_idle(struct backend_ctx *ctx)
+{
+	atomic_val_t prev;
+
+	do {
+		prev = atomic_get(&ctx->processed);
+		k_msleep(50);
+	} while (atomic_get(&ctx->processed) != prev);
+}
+
+ZTEST(log_parallel, test_slow_backend)
+{
+	uint32_t fast_done;
+	int64_t start;
+
+	for (int i = 0; i < MSG_CNT; i++) {
+		LOG_INF("message %d", i);
+	}
+
+	start = k_uptime_get();
+
+	/* Fast backend is not throttled by the slow one. */
+	wait_processed(&fast_ctx, MSG_CNT);
+	fast_done = k_uptime_get() - start;
+	zassert_true(fast_done < (MSG_CNT * 5) / 2, "Fast backend throttled (%u ms)",
+		     fast_done);
+
+	wait_idle(&slow_ctx);
+	zassert_true(atomic_get(&slow_ctx.processed) < MSG_CNT);
+
+	/* Dropped messages are reported to the slow backend only. Messages
+	 * held by the backends were freed so new ones fit.
+	 */
+	LOG_INF("last");
+	wait_processed(&fast_ctx, MSG_CNT + 1);
+	wait_idle(&slow_ctx);
+
+	zassert_equal(atomic_get(&fast_ctx.processed), MSG_CNT + 1);
+	zassert_equal(atomic_get(&fast_ctx.dropped), 0);
+	zassert_equal(atomic_get(&slow_ctx.processed) + atomic_get(&slow_ctx.dropped),
+		      MSG_CNT + 1);
+
+	zassert_not_null(fast_ctx.tid);
+	zassert_not_equal(fast_ctx.tid, k_current_get());
+	zassert_not_equal(fast_ctx.tid, slow_ctx.tid);
+	zassert_false(log_data_pending());
+}
+
+/* A backend holds messages while the log buffer wraps several times. The
+ * other backend gets all of them intact, in both overflow modes.
+ */
+ZTEST(log_parallel, test_wrap)
+{
+	uint32_t size, now;
+
+	atomic_set(&slow_ctx.hold, 1);
+
+	for (int i = 0; i < WRAP_CNT; i++) {
+		LOG_INF("wrap %d", i);
+
+		/* Let the messages be processed so that none is dropped. */
+		if ((i % WRAP_BATCH) == (WRAP_BATCH - 1)) {
+			wait_processed(&fast_ctx, i + 1);
+		}
+	}
+
+	zassert_true(atomic_get(&slow_ctx.processed) == 0);
+
+	log_mem_get_usage(&size, &now);
+	zassert_true(fast_ctx.bytes > 2 * size, "Buffer did not wrap");
+
+	atomic_set(&slow_ctx.hold, 0);
+	k_sem_give(&gate);
+
+	LOG_INF("done");
+	wait_processed(&fast_ctx, WRAP_CNT + 1);
+	wait_idle(&slow_ctx);
+
+	zassert_equal(atomic_get(&fast_ctx.dropped), 0);
+	zassert_equal(fast_ctx.next_seq, WRAP_CNT);
+	zassert_equal(fast_ctx.gaps, 0);
+	zassert_equal(fast_ctx.corrupted, 0);
+
+	zassert_true(slow_ctx.next_seq > 0);
+	zassert_equal(slow_ctx.corrupted, 0, "Held messages were overwritten");
+	zassert_equal(atomic_get(&slow_ctx.processed) + atomic_get(&slow_ctx.dropped),
+		      WRAP_CNT + 1);
+	zassert_false(log_data_pending());
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&gate);
+
+	for (int i = 0; i < 2; i++) {
+		struct backend_ctx *ctx = (i == 0) ? &fast_ctx : &slow_ctx;
+
+		atomic_clear(&ctx->processed);
+		atomic_clear(&ctx->dropped);
+		ctx->bytes = 0;
+		ctx->next_seq = 0;
+		ctx->gaps = 0;
+		ctx->corrupted = 0;
+	}
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_set(&slow_ctx.hold, 0);
+	k_sem_give(&gate);
+}
+
+ZTEST_SUITE(log_parallel, NULL, NULL, before, after, NULL);
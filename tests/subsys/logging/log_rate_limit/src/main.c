@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/cbprintf.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define MAX_MSGS 128
+#define MSG_LEN 48
+
+static char msgs[MAX_MSGS][MSG_LEN];
+static int msg_cnt;
+static int msg_len;
+
+static int out(int c, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (msg_len < (MSG_LEN - 1)) {
+		msgs[msg_cnt][msg_len++] = c;
+	}
+
+	return c;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+
+	ARG_UNUSED(backend);
+
+	if (msg_cnt == MAX_MSGS) {
+		return;
+	}
+
+	msg_len = 0;
+	(void)cbpprintf(out, NULL, package);
+	msgs[msg_cnt][msg_len] = '\0';
+	msg_cnt++;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(test_backend, backend_api, true);
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+static void check(const char *const exp[], int cnt)
+{
+	flush();
+	zassert_equal(msg_cnt, cnt, "Got %d messages", msg_cnt);
+	for (int i = 0; i < cnt; i++) {
+		zassert_equal(strcmp(msgs[i], exp[i]), 0, "Got \"%s\"", msgs[i]);
+	}
+}
+
+static void rate_set(uint16_t rate, uint8_t burst)
+{
+	zassert_ok(log_rate_limit_set(Z_LOG_LOCAL_DOMAIN_ID, log_source_id_get("test"), rate,
+				      burst));
+}
+
+ZTEST(log_rate_limit, test_source_rate)
+{
+	static const char *const exp[] = {"a", "b", "a", "3 messages suppressed", "a"};
+
+	rate_set(10, 3);
+
+	/* Alternate call sites so that repeat suppression does not apply. */
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("a");
+		LOG_INF("b");
+	}
+
+	/* Allow 1 token to be refilled. */
+	k_msleep(150);
+	LOG_INF("a");
+
+	check(exp, ARRAY_SIZE(exp));
+}
+
+ZTEST(log_rate_limit, test_repeat)
+{
+	static const char *const exp[] = {"a", "last message repeated 4 times", "b", "a"};
+
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("a");
+	}
+	LOG_INF("b");
+
+	/* Same call site passes again after the window. */
+	k_msleep(150);
+	LOG_INF("a");
+
+	check(exp, ARRAY_SIZE(exp));
+}
+
+ZTEST(log_rate_limit, test_invalid)
+{
+	zassert_equal(log_rate_limit_set(Z_LOG_LOCAL_DOMAIN_ID, -1, 1, 1), -EINVAL);
+	zassert_equal(log_rate_limit_set(Z_LOG_LOCAL_DOMAIN_ID, log_source_id_get("test"), 1, 0),
+		      -EINVAL);
+}
+
+ZTEST(log_rate_limit, test_call_site)
+{
+#if CONFIG_LOG_RATE_LIMIT_SITES > 0
+	int a_cnt = 0;
+	int b_cnt = 0;
+
+	for (int i = 0; i < 10; i++) {
+		LOG_INF("a");
+		LOG_INF("b");
+	}
+
+	flush();
+	for (int i = 0; i < msg_cnt; i++) {
+		a_cnt += (strcmp(msgs[i], "a") == 0);
+		b_cnt += (strcmp(msgs[i], "b") == 0);
+	}
+
+	zassert_equal(a_cnt, CONFIG_LOG_RATE_LIMIT_SITE_BURST);
+	zassert_equal(b_cnt, CONFIG_LOG_RATE_LIMIT_SITE_BURST);
+
+	/* Messages dropped by call site limits are reported by the source. */
+	char exp[32];
+
+	snprintf(exp, sizeof(exp), "%d messages suppressed",
+		 20 - 2 * CONFIG_LOG_RATE_LIMIT_SITE_BURST);
+	msg_cnt = 0;
+	k_msleep(1000);
+	LOG_INF("c");
+	flush();
+
+	zassert_equal(msg_cnt, 2);
+	zassert_equal(strcmp(msgs[0], exp), 0, "Got \"%s\"", msgs[0]);
+	zassert_equal(strcmp(msgs[1], "c"), 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
+#define SITE_LOG(i, _) LOG_INF("s" STRINGIFY(i))
+
+/* Call sites which share slots of the table must not reset each other's
+ * bucket, so all of them together cannot pass more than the table holds.
+ */
+ZTEST(log_rate_limit, test_call_site_collision)
+{
+#if CONFIG_LOG_RATE_LIMIT_SITES > 0
+	int site_cnt = 0;
+
+	for (int i = 0; i < 4; i++) {
+		LISTIFY(16, SITE_LOG, (;));
+	}
+
+	flush();
+	for (int i = 0; i < msg_cnt; i++) {
+		site_cnt += (msgs[i][0] == 's');
+	}
+
+	zassert_true(site_cnt >= CONFIG_LOG_RATE_LIMIT_SITES, "Got %d messages", site_cnt);
+	zassert_true(site_cnt <= CONFIG_LOG_RATE_LIMIT_SITES * CONFIG_LOG_RATE_LIMIT_SITE_BURST,
+		     "Got %d messages", site_cnt);
+
+	/* Report the messages suppressed since the last one which passed. */
+	msg_cnt = 0;
+	k_msleep(1000);
+	LOG_INF("c");
+	flush();
+
+	zassert_equal(msg_cnt, 2);
+	zassert_equal(strcmp(msgs[1], "c"), 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Let repeat windows and site buckets of previous tests expire. */
+	k_msleep(1000);
+	rate_set(0, 1);
+	flush();
+	msg_cnt = 0;
+}
+
+ZTEST_SUITE(log_rate_limit, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing_format.h>
+#include <zephyr/tracing/flight_recorder.h>
+#include <tracing_buffer.h>
+
+#define MARKER_SIZE 8
+#define MARKER_CNT 100
+/* Records are read with the CPU ID first. */
+#define REC_SIZE (1 + MARKER_SIZE)
+
+extern uint8_t ram_tracing[];
+
+static void marker_put(uint16_t seq)
+{
+	uint8_t buf[MARKER_SIZE] = {
+		0xfe, 0xca, seq & 0xff, seq >> 8, ~seq & 0xff, ~seq >> 8, 0xad, 0xde
+	};
+
+	tracing_format_raw_data(buf, sizeof(buf));
+}
+
+static int marker_seq(const uint8_t *buf)
+{
+	if ((buf[0] != 0xfe) || (buf[1] != 0xca) || (buf[6] != 0xad) || (buf[7] != 0xde) ||
+	    ((buf[2] ^ buf[4]) != 0xff) || ((buf[3] ^ buf[5]) != 0xff)) {
+		return -1;
+	}
+
+	return buf[2] | (buf[3] << 8);
+}
+
+static void drain(void)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	while ((len = tracing_buffer_get_claim(&data, UINT32_MAX)) > 0) {
+		tracing_buffer_get_finish(len);
+	}
+}
+
+/* Read back markers, check that they are consecutive and return the
+ * number of them. @p first and @p last are set to the sequence numbers
+ * of the first and last one.
+ */
+static int markers_read(int *first, int *last)
+{
+	uint8_t buf[REC_SIZE];
+	int cnt = 0;
+
+	while (tracing_buffer_get(buf, sizeof(buf)) == sizeof(buf)) {
+		int seq = marker_seq(&buf[1]);
+
+		zassert_equal(buf[0], 0, "Wrong CPU");
+		zassert_true(seq >= 0, "Not a marker");
+		if (cnt == 0) {
+			*first = seq;
+		} else {
+			zassert_equal(seq, *last + 1);
+		}
+		*last = seq;
+		cnt++;
+	}
+
+	return cnt;
+}
+
+ZTEST(tracing_flight_recorder, test_records)
+{
+	uint8_t buf[REC_SIZE];
+	unsigned int key = irq_lock();
+
+	drain();
+
+	for (int i = 0; i < 3; i++) {
+		marker_put(i);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(tracing_buffer_get(buf, sizeof(buf)), sizeof(buf));
+		zassert_equal(buf[0], 0);
+		zassert_equal(marker_seq(&buf[1]), i);
+	}
+
+	zassert_true(tracing_buffer_is_empty());
+
+	irq_unlock(key);
+}
+
+ZTEST(tracing_flight_recorder, test_full)
+{
+	uint32_t used, overwritten_before, overwritten;
+	unsigned int key = irq_lock();
+	int first = 0, last = 0, cnt;
+
+	drain();
+	tracing_buffer_cpu_stats_get(0, &used, &overwritten_before);
+
+	for (int i = 0; i < MARKER_CNT; i++) {
+		marker_put(i);
+	}
+
+	tracing_buffer_cpu_stats_get(0, &used, &overwritten);
+	cnt = markers_read(&first, &last);
+	irq_unlock(key);
+
+	zassert_true(cnt < MARKER_CNT);
+	zassert_true(used >= cnt * MARKER_SIZE);
+
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		/* Oldest events are overwritten. */
+		zassert_equal(last, MARKER_CNT - 1);
+		zassert_equal(overwritten - overwritten_before, MARKER_CNT - cnt);
+	} else {
+		/* Newest events are dropped. */
+		zassert_equal(first, 0);
+		zassert_equal(overwritten, overwritten_before);
+	}
+}
+
+/* Return the sequence numbers of the first and last marker sent to the
+ * RAM backend starting at @p base.
+ */
+static int ram_markers_find(int base, int *first, int *last)
+{
+	int cnt = 0;
+
+	for (int i = 1; i <= (CONFIG_RAM_TRACING_BUFFER_SIZE - MARKER_SIZE); i++) {
+		int seq = marker_seq(&ram_tracing[i]);
+
+		if (seq < base) {
+			continue;
+		}
+
+		zassert_equal(ram_tracing[i - 1], 0, "Wrong CPU");
+
+		if (cnt == 0) {
+			*first = seq;
+		} else {
+			zassert_equal(seq, *last + 1);
+		}
+		*last = seq;
+		cnt++;
+	}
+
+	return cnt;
+}
+
+ZTEST(tracing_flight_recorder, test_output)
+{
+	int base = 1000;
+	int first = 0, last = 0, cnt;
+	unsigned int key = irq_lock();
+
+	drain();
+	irq_unlock(key);
+
+	for (int i = 0; i < 10; i++) {
+		marker_put(base + i);
+	}
+
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		zassert_equal(ram_markers_find(base, &first, &last), 0,
+			      "Flight recorder sent events before a dump");
+		zassert_true(tracing_flight_recorder_dump() >= 10 * MARKER_SIZE);
+	} else {
+		k_msleep(2 * CONFIG_TRACING_THREAD_WAIT_THRESHOLD);
+	}
+
+	cnt = ram_markers_find(base, &first, &last);
+	zassert_equal(cnt, 10);
+	zassert_equal(first, base);
+}
+
+ZTEST(tracing_flight_recorder, test_freeze)
+{
+	unsigned int key;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_TRACING_FLIGHT_RECORDER);
+
+	key = irq_lock();
+	drain();
+
+	tracing_flight_recorder_freeze();
+	zassert_true(tracing_flight_recorder_is_frozen());
+	marker_put(0);
+	zassert_true(tracing_buffer_is_empty());
+
+	tracing_flight_recorder_resume();
+	zassert_false(tracing_flight_recorder_is_frozen());
+	marker_put(0);
+	zassert_false(tracing_buffer_is_empty());
+
+	irq_unlock(key);
+}
+
+ZTEST_SUITE(tracing_flight_recorder, NULL, NULL, NULL, NULL, NULL);
@@ -722,6 +722,24 @@ ZTEST(prf, test_fp_value)
 	TEST_PRF(&rc, "%.20e", dv);
 	PRF_CHECK("1.00000000000000000000e+20", rc);
 
+	/* Closest double is below 1E23 and must not be rounded up to it. */
+	dv = 1E23;
+	TEST_PRF(&rc, "%.15e", dv);
+	PRF_CHECK("9.999999999999999e+22", rc);
+
+	/* Rounding that carries into a new leading digit. */
+	dv = 9.5;
+	TEST_PRF(&rc, "%.0f", dv);
+	PRF_CHECK("10", rc);
+
+	dv = 99.5;
+	TEST_PRF(&rc, "%.0f", dv);
+	PRF_CHECK("100", rc);
+
+	dv = 9.5;
+	TEST_PRF(&rc, "%.0e", dv);
+	PRF_CHECK("1e+01", rc);
+
 	dv = 1E-3;
 	TEST_PRF(&rc, "%.3e", dv);
 	PRF_CHECK("1.000e-03", rc);